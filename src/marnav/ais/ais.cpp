@@ -1,6 +1,8 @@
 #include "ais.hpp"
+#include "any_message.hpp"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 
 #include <marnav/ais/message_01.hpp>
@@ -60,45 +62,96 @@ char encode_armoring(uint8_t value)
 
 namespace
 {
+/// Returns the table to decode six bit armoring characters, indexed by the character.
+/// The values are identical to `decode_armoring`, for all characters.
+static const std::array<uint8_t, 256> & armoring_table()
+{
+	static const std::array<uint8_t, 256> table = [] {
+		std::array<uint8_t, 256> t;
+		for (std::size_t i = 0; i < t.size(); ++i)
+			t[i] = decode_armoring(static_cast<char>(i));
+		return t;
+	}();
+	return table;
+}
+
+/// Decodes the six bit armored payloads into a bitset.
+///
+/// All characters are decoded through a lookup table and accumulated in a 64 bit
+/// word. Whenever the word holds at least six complete bytes, they are written to the
+/// block container at once. The container holds its data inline, no memory is allocated.
+///
+/// @exception std::invalid_argument Invalid padding, or the payloads exceed the
+///   capacity of the raw data.
 static raw collect(const std::vector<std::pair<std::string, uint32_t>> & v)
 {
-	raw result;
-	result.reserve(64); // 64 bytes (512) are enough for AIS messages
+	const auto & table = armoring_table();
 
+	raw::size_type total = 0;
 	for (auto const & item : v) {
-		const std::string & payload = item.first;
-		const uint32_t pad = item.second;
+		if (item.second > 6)
+			throw std::invalid_argument{"invalid padding in ais/collect"};
+		if (!item.first.empty())
+			total += item.first.size() * 6 - item.second;
+	}
+
+	if (total > max_raw_size * raw::bits_per_block)
+		throw std::invalid_argument{"payload too large in ais/collect"};
+
+	raw::container data;
+	data.reserve((total + raw::bits_per_block - 1) / raw::bits_per_block);
 
-		auto end = payload.cend();
-		auto last = end - 1;
-		for (auto i = payload.cbegin(); i != end; ++i) {
+	uint64_t acc = 0; // accumulated bits, right aligned
+	uint32_t n = 0; // number of valid bits within the accumulator
 
-			uint8_t value = decode_armoring(*i);
+	for (auto const & item : v) {
+		const std::string & payload = item.first;
+		if (payload.empty())
+			continue;
 
-			if (i == last) {
-				result.append(value >> pad, 6 - pad);
-			} else {
-				result.append(value, 6);
+		const char * p = payload.data();
+		const char * const last = p + payload.size() - 1;
+		for (; p != last; ++p) {
+			acc = (acc << 6) | table[static_cast<uint8_t>(*p)];
+			n += 6;
+			if (n >= 48) {
+				for (; n >= 8; n -= 8)
+					data.push_back(static_cast<uint8_t>(acc >> (n - 8)));
 			}
 		}
+
+		// last character contains padding
+		const uint32_t bits = 6 - item.second;
+		acc = (acc << bits) | (table[static_cast<uint8_t>(*last)] >> item.second);
+		n += bits;
+		for (; n >= 8; n -= 8)
+			data.push_back(static_cast<uint8_t>(acc >> (n - 8)));
 	}
 
-	return result;
+	if (n > 0)
+		data.push_back(static_cast<uint8_t>(acc << (8 - n)));
+
+	return raw{std::move(data), total};
 }
 
-static std::function<std::unique_ptr<message>(const raw &)> instantiate_message(
-	message_id type, size_t size)
+using parse_function = std::function<std::unique_ptr<message>(const raw &)>;
+using emplace_variant_function = void (*)(any_message &, const raw &);
+
+struct entry {
+	const message_id id;
+	const parse_function parse;
+	const emplace_variant_function emplace_variant;
+};
+
+/// Returns the registry entry of the specified message type, or `nullptr` if the
+/// message type is not supported.
+static const entry * find_entry(message_id type)
 {
-#define REGISTER_MESSAGE(m)              \
-	{                                    \
-		m::ID, detail::factory::parse<m> \
+#define REGISTER_MESSAGE(m)                                                                \
+	{                                                                                      \
+		m::ID, detail::factory::parse<m>, detail::factory::emplace_variant<m, any_message> \
 	}
 
-	struct entry {
-		const message_id id;
-		const std::function<std::unique_ptr<message>(const raw &)> parse;
-	};
-
 	static const std::vector<entry> known_messages = {
 		REGISTER_MESSAGE(message_01), REGISTER_MESSAGE(message_02),
 		REGISTER_MESSAGE(message_03), REGISTER_MESSAGE(message_04),
@@ -120,11 +173,52 @@ static std::function<std::unique_ptr<message>(const raw &)> instantiate_message(
 		[type](const entry & e) { return e.id == type; });
 
 	if (i == end(known_messages))
+		return nullptr;
+
+	return &*i;
+}
+
+/// Returns the parse function of the specified message type, or `nullptr` if the
+/// message type is not supported.
+static const parse_function * find_parse_function(message_id type)
+{
+	const auto e = find_entry(type);
+	return e ? &e->parse : nullptr;
+}
+
+static const parse_function & instantiate_message(message_id type, size_t size)
+{
+	const auto f = find_parse_function(type);
+	if (f == nullptr)
 		throw unknown_message{"unknown message in ais/instantiate_message: "
 			+ std::to_string(static_cast<uint8_t>(type)) + " (" + std::to_string(size)
 			+ " bits)"};
+	return *f;
+}
 
-	return i->parse;
+/// Returns true if the specified character is a valid six bit armoring character.
+static bool is_armoring(char c) noexcept
+{
+	return ((c >= '0') && (c <= 'W')) || ((c >= '`') && (c <= 'w'));
+}
+
+/// Checks the payload for characters and padding which cannot be decoded.
+static decode_error check_payload(const std::vector<std::pair<std::string, uint32_t>> & v)
+{
+	if (v.empty())
+		return decode_error::empty;
+	std::size_t total = 0;
+	for (auto const & item : v) {
+		if (item.second > 5)
+			return decode_error::invalid_payload;
+		if (!std::all_of(item.first.begin(), item.first.end(), is_armoring))
+			return decode_error::invalid_payload;
+		if (!item.first.empty())
+			total += item.first.size() * 6 - item.second;
+	}
+	if (total > max_raw_size * raw::bits_per_block)
+		return decode_error::invalid_payload;
+	return decode_error::none;
 }
 }
 
@@ -145,6 +239,162 @@ std::unique_ptr<message> make_message(const std::vector<std::pair<std::string, u
 	return instantiate_message(type, bits.size())(bits);
 }
 
+/// Parses the specified data and creates the corresponding AIS message, or returns
+/// an error if the data is invalid or the message is not supported.
+///
+/// In contrast to `make_message`, this function does not throw exceptions on invalid
+/// data. Invalid characters, padding and unsupported message types are detected
+/// without exceptions. Errors detected by the messages themselves, e.g. a wrong
+/// number of bits, are reported as `decode_error::invalid_data`.
+///
+/// @param[in] v All NMEA payloads, necessary to build the AIS message.
+///  This may be obtained using nmea::collect_payload.
+/// @return The constructed AIS message or the error.
+utils::expected<std::unique_ptr<message>, decode_error> try_make_message(
+	const std::vector<std::pair<std::string, uint32_t>> & v)
+{
+	const auto e = check_payload(v);
+	if (e != decode_error::none)
+		return utils::make_unexpected(e);
+
+	auto bits = collect(v);
+	if (bits.size() < 6)
+		return utils::make_unexpected(decode_error::empty);
+
+	const auto f = find_parse_function(static_cast<message_id>(bits.get<uint8_t>(0, 6)));
+	if (f == nullptr)
+		return utils::make_unexpected(decode_error::unknown_message);
+
+	try {
+		return (*f)(bits);
+	} catch (const std::logic_error &) {
+		return utils::make_unexpected(decode_error::invalid_data);
+	} catch (const std::runtime_error &) {
+		return utils::make_unexpected(decode_error::invalid_data);
+	}
+}
+
+/// Parses the specified data and returns the corresponding AIS message by value.
+/// Apart from the type of the result, this is the same as `make_message`.
+///
+/// @param[in] v All NMEA payloads, necessary to build the AIS message.
+/// @return The variant holding the message of the corresponding type.
+/// @exception unknown_message Will be thrown if the AIS message is not supported.
+/// @exception std::invalid_argument Error has been occurred during parsing of
+///   the message.
+any_message make_any_message(const std::vector<std::pair<std::string, uint32_t>> & v)
+{
+	const auto bits = collect(v);
+	const auto type = static_cast<message_id>(bits.get<uint8_t>(0, 6));
+	const auto e = find_entry(type);
+	if (e == nullptr)
+		throw unknown_message{"unknown message in ais/make_any_message: "
+			+ std::to_string(static_cast<uint8_t>(type)) + " (" + std::to_string(bits.size())
+			+ " bits)"};
+
+	any_message result;
+	e->emplace_variant(result, bits);
+	return result;
+}
+
+/// Parses the specified data and stores the corresponding AIS message in the
+/// specified variant, which may be reused from message to message. No memory
+/// is allocated for the message.
+///
+/// Errors are reported the same way as by `try_make_message`, without exceptions
+/// for invalid payloads and unsupported messages.
+///
+/// @param[in] v All NMEA payloads, necessary to build the AIS message.
+/// @param[out] result The decoded message. In case of an error, the content is
+///   unspecified, but valid.
+/// @return The error, `decode_error::none` on success.
+decode_error decode_message(
+	const std::vector<std::pair<std::string, uint32_t>> & v, any_message & result)
+{
+	const auto e = check_payload(v);
+	if (e != decode_error::none)
+		return e;
+
+	const auto bits = collect(v);
+	if (bits.size() < 6)
+		return decode_error::empty;
+
+	const auto i = find_entry(static_cast<message_id>(bits.get<uint8_t>(0, 6)));
+	if (i == nullptr)
+		return decode_error::unknown_message;
+
+	try {
+		i->emplace_variant(result, bits);
+	} catch (const std::logic_error &) {
+		return decode_error::invalid_data;
+	} catch (const std::runtime_error &) {
+		return decode_error::invalid_data;
+	}
+	return decode_error::none;
+}
+
+/// Decodes the header (message type, repeat indicator and MMSI) directly from the
+/// armored payload, without decoding the entire message.
+///
+/// Only the first seven characters (42 bits) are decoded, nothing is allocated.
+/// This makes it possible to filter messages cheaply, before they are decoded
+/// by `make_message`.
+///
+/// @param[in] payload The payload of the first (or only) NMEA sentence of the message.
+/// @param[in] n Number of characters of the payload.
+/// @return The header or the error. An error `decode_error::empty` is returned if
+///   the payload is too short to contain a header.
+///
+/// @note The message type is not checked to be supported.
+utils::expected<message_header, decode_error> peek_header(const char * payload, std::size_t n)
+{
+	static constexpr std::size_t header_chars = 7; // 38 bits needed
+
+	if ((payload == nullptr) || (n < header_chars))
+		return utils::make_unexpected(decode_error::empty);
+
+	const auto & table = armoring_table();
+	uint64_t word = 0;
+	for (std::size_t i = 0; i < header_chars; ++i) {
+		if (!is_armoring(payload[i]))
+			return utils::make_unexpected(decode_error::invalid_payload);
+		word = (word << 6) | table[static_cast<uint8_t>(payload[i])];
+	}
+
+	// the first 38 of 42 bits: type (6), repeat indicator (2), mmsi (30)
+	message_header header;
+	header.type = static_cast<message_id>((word >> 36) & 0x3f);
+	header.repeat_indicator = static_cast<uint32_t>((word >> 34) & 0x03);
+	header.mmsi = utils::mmsi{static_cast<uint32_t>((word >> 4) & 0x3fffffff)};
+	return header;
+}
+
+/// Decodes the header from the specified payload.
+///
+/// @see peek_header(const char *, std::size_t)
+utils::expected<message_header, decode_error> peek_header(const std::string & payload)
+{
+	return peek_header(payload.data(), payload.size());
+}
+
+/// Returns a textual description of the specified error.
+std::string to_string(decode_error e)
+{
+	switch (e) {
+		case decode_error::none:
+			return "none";
+		case decode_error::empty:
+			return "empty payload";
+		case decode_error::invalid_payload:
+			return "invalid payload";
+		case decode_error::unknown_message:
+			return "unknown message";
+		case decode_error::invalid_data:
+			return "invalid data";
+	}
+	return "unknown error";
+}
+
 /// Encodes the specified message and returns a container with payload and padding
 /// information. This payload container can be used directly with NMEA funcitons.
 ///
@@ -4,6 +4,8 @@
 #include <vector>
 #include <stdexcept>
 #include <marnav/ais/message.hpp>
+#include <marnav/utils/expected.hpp>
+#include <marnav/utils/mmsi.hpp>
 
 namespace marnav
 {
@@ -16,7 +18,32 @@ public:
 	using logic_error::logic_error;
 };
 
+/// Errors reported by the exception-free decoding functions.
+enum class decode_error {
+	none, ///< No error.
+	empty, ///< No payload or not enough data to determine the message type.
+	invalid_payload, ///< Invalid characters or padding in the payload.
+	unknown_message, ///< The message type is not supported.
+	invalid_data, ///< The data is invalid for the message type.
+};
+
+/// The header common to all AIS messages.
+struct message_header {
+	message_id type = message_id::NONE;
+	uint32_t repeat_indicator = 0;
+	utils::mmsi mmsi;
+};
+
 std::unique_ptr<message> make_message(const std::vector<std::pair<std::string, uint32_t>> & v);
+
+utils::expected<std::unique_ptr<message>, decode_error> try_make_message(
+	const std::vector<std::pair<std::string, uint32_t>> & v);
+
+utils::expected<message_header, decode_error> peek_header(const char * payload, std::size_t n);
+utils::expected<message_header, decode_error> peek_header(const std::string & payload);
+
+std::string to_string(decode_error e);
+
 std::vector<std::pair<std::string, uint32_t>> encode_message(const message & msg);
 
 uint8_t decode_armoring(char c);
@@ -0,0 +1,93 @@
+#ifndef MARNAV__AIS__ANY_MESSAGE__HPP
+#define MARNAV__AIS__ANY_MESSAGE__HPP
+
+#include <marnav/ais/ais.hpp>
+#include <marnav/ais/message_01.hpp>
+#include <marnav/ais/message_02.hpp>
+#include <marnav/ais/message_03.hpp>
+#include <marnav/ais/message_04.hpp>
+#include <marnav/ais/message_05.hpp>
+#include <marnav/ais/message_06.hpp>
+#include <marnav/ais/message_07.hpp>
+#include <marnav/ais/message_08.hpp>
+#include <marnav/ais/message_09.hpp>
+#include <marnav/ais/message_10.hpp>
+#include <marnav/ais/message_11.hpp>
+#include <marnav/ais/message_12.hpp>
+#include <marnav/ais/message_13.hpp>
+#include <marnav/ais/message_14.hpp>
+#include <marnav/ais/message_17.hpp>
+#include <marnav/ais/message_18.hpp>
+#include <marnav/ais/message_19.hpp>
+#include <marnav/ais/message_20.hpp>
+#include <marnav/ais/message_21.hpp>
+#include <marnav/ais/message_22.hpp>
+#include <marnav/ais/message_23.hpp>
+#include <marnav/ais/message_24.hpp>
+#include <marnav/utils/variant.hpp>
+
+namespace marnav
+{
+namespace ais
+{
+/// @brief Holds any of the supported AIS messages by value.
+///
+/// This is an alternative to `std::unique_ptr<message>` as returned by `make_message`.
+/// The message is stored within the object, no memory is allocated for it.
+/// Together with `decode_message`, which decodes into an existing object, messages
+/// can be decoded repeatedly without any heap operation for the message.
+///
+/// Access to the specific message is provided by `utils::visit`, `utils::get_if`
+/// and `utils::get`, the common interface by `as_message`.
+///
+/// @note Binary payloads of message 08 (e.g. `binary_001_11`, `binary_200_10`) are not
+///   messages themselves, they are read from the message by `message_08::read_binary`.
+///
+/// Example:
+/// @code
+///   struct tracker {
+///       void operator()(const ais::message_01 & m) { ... }
+///       void operator()(const ais::message_05 & m) { ... }
+///       template <class T> void operator()(const T &) {}
+///   };
+///
+///   ais::any_message msg;
+///   if (ais::decode_message(payload, msg) == ais::decode_error::none)
+///       utils::visit(tracker{}, msg);
+/// @endcode
+using any_message = utils::variant<
+	message_01, message_02, message_03, message_04, message_05, message_06, message_07,
+	message_08, message_09, message_10, message_11, message_12, message_13, message_14,
+	message_17, message_18, message_19, message_20, message_21, message_22, message_23,
+	message_24>;
+
+any_message make_any_message(const std::vector<std::pair<std::string, uint32_t>> & v);
+
+decode_error decode_message(
+	const std::vector<std::pair<std::string, uint32_t>> & v, any_message & result);
+
+/// @cond DEV
+namespace detail
+{
+struct as_message_visitor {
+	template <class T> message & operator()(T & m) const noexcept { return m; }
+	template <class T> const message & operator()(const T & m) const noexcept { return m; }
+};
+}
+/// @endcond
+
+/// Returns the contained message through the interface of the base class.
+inline message & as_message(any_message & m) noexcept
+{
+	return m.visit(detail::as_message_visitor{});
+}
+
+/// Const variant.
+inline const message & as_message(const any_message & m) noexcept
+{
+	return m.visit(detail::as_message_visitor{});
+}
+}
+}
+
+#endif
@@ -8,65 +8,50 @@ namespace ais
 /// @cond DEV
 namespace
 {
-struct sixbit_entry {
-	uint8_t value;
-	char c;
-};
+/// Characters of the six bit ASCII table, indexed by their value.
+static constexpr char SIXBIT_ASCII_DECODE[64 + 1]
+	= "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_ !\"#$%&'()*+,-./0123456789:;<=>?";
 
-class sixbit_span
+/// Returns the six bit value of the specified character, `0xff` if the character
+/// is not part of the six bit ASCII table.
+static constexpr uint8_t sixbit_value(unsigned int c)
 {
-public:
-	constexpr sixbit_span(const sixbit_entry * first, const sixbit_entry * last)
-		: first_(first)
-		, last_(last)
-	{
-	}
+	return ((c >= 64u) && (c <= 95u))
+		? static_cast<uint8_t>(c - 64u)
+		: (((c >= 32u) && (c <= 63u)) ? static_cast<uint8_t>(c) : uint8_t{0xff});
+}
 
-	constexpr const sixbit_entry * begin() const { return first_; }
-	constexpr const sixbit_entry * end() const { return last_; }
+#define SIXBIT_E4(i) \
+	sixbit_value(i), sixbit_value(i + 1), sixbit_value(i + 2), sixbit_value(i + 3)
+#define SIXBIT_E16(i) SIXBIT_E4(i), SIXBIT_E4(i + 4), SIXBIT_E4(i + 8), SIXBIT_E4(i + 12)
+#define SIXBIT_E64(i) \
+	SIXBIT_E16(i), SIXBIT_E16(i + 16), SIXBIT_E16(i + 32), SIXBIT_E16(i + 48)
 
-private:
-	const sixbit_entry * first_ = nullptr;
-	const sixbit_entry * last_ = nullptr;
+/// Six bit values of all characters, indexed by the character.
+static constexpr uint8_t SIXBIT_ASCII_ENCODE[256] = {
+	SIXBIT_E64(0u), SIXBIT_E64(64u), SIXBIT_E64(128u), SIXBIT_E64(192u),
 };
 
-static sixbit_span sixbit_table()
-{
-	// construct-on-first-use with static, in this case not a problem on destruction,
-	// because // the table contains only primitive types, no complex destruction involved,
-	// and access functions (see below) return values not references or pointers.
+#undef SIXBIT_E64
+#undef SIXBIT_E16
+#undef SIXBIT_E4
 
-	static constexpr sixbit_entry SIXBIT_ASCII_TABLE[] = {
-		{0, '@'}, {1, 'A'}, {2, 'B'}, {3, 'C'}, {4, 'D'}, {5, 'E'}, {6, 'F'}, {7, 'G'},
-		{8, 'H'}, {9, 'I'}, {10, 'J'}, {11, 'K'}, {12, 'L'}, {13, 'M'}, {14, 'N'}, {15, 'O'},
-		{16, 'P'}, {17, 'Q'}, {18, 'R'}, {19, 'S'}, {20, 'T'}, {21, 'U'}, {22, 'V'}, {23, 'W'},
-		{24, 'X'}, {25, 'Y'}, {26, 'Z'}, {27, '['}, {28, '\\'}, {29, ']'}, {30, '^'}, {31, '_'},
-		{32, ' '}, {33, '!'}, {34, '\"'}, {35, '#'}, {36, '$'}, {37, '%'}, {38, '&'},
-		{39, '\''}, {40, '('}, {41, ')'}, {42, '*'}, {43, '+'}, {44, ','}, {45, '-'}, {46, '.'},
-		{47, '/'}, {48, '0'}, {49, '1'}, {50, '2'}, {51, '3'}, {52, '4'}, {53, '5'}, {54, '6'},
-		{55, '7'}, {56, '8'}, {57, '9'}, {58, ':'}, {59, ';'}, {60, '<'}, {61, '='}, {62, '>'},
-		{63, '?'},
-	};
-	return {SIXBIT_ASCII_TABLE,
-		SIXBIT_ASCII_TABLE + (sizeof(SIXBIT_ASCII_TABLE) / sizeof(sixbit_entry))};
-}
+/// Maximum number of sixbits to be read or written at once, limited by
+/// the number of bits `raw::get` is able to read within a single word.
+constexpr raw::size_type max_sixbits_per_word = 9;
 }
 /// @endcond
 
 char decode_sixbit_ascii(uint8_t value)
 {
-	for (const auto p : sixbit_table())
-		if (p.value == value)
-			return p.c;
-	return static_cast<char>(0xff);
+	if (value >= 64u)
+		return static_cast<char>(0xff);
+	return SIXBIT_ASCII_DECODE[value];
 }
 
 uint8_t encode_sixbit_ascii(char c)
 {
-	for (const auto p : sixbit_table())
-		if (p.c == c)
-			return p.value;
-	return 0xffu;
+	return SIXBIT_ASCII_ENCODE[static_cast<uint8_t>(c)];
 }
 
 std::string trim_ais_string(const std::string & s)
@@ -86,13 +71,14 @@ std::string trim_ais_string(const std::string & s)
 std::string binary_data::read_string(
 	const raw & bits, raw::size_type ofs, raw::size_type count_sixbits)
 {
-	std::string s;
-	s.reserve(count_sixbits);
+	std::string s(count_sixbits, '\0');
 
-	for (raw::size_type i = 0; i < count_sixbits; ++i) {
-		uint8_t sixbit = 0;
-		bits.get(sixbit, ofs + i * 6, 6);
-		s += decode_sixbit_ascii(sixbit);
+	// reads up to nine characters at once, decodes them from the word
+	for (raw::size_type i = 0; i < count_sixbits;) {
+		const raw::size_type n = std::min(count_sixbits - i, max_sixbits_per_word);
+		const uint64_t word = bits.get<uint64_t>(ofs + i * 6, n * 6);
+		for (raw::size_type k = n; k > 0; --k, ++i)
+			s[i] = SIXBIT_ASCII_DECODE[(word >> ((k - 1) * 6)) & 0x3f];
 	}
 
 	return s;
@@ -110,14 +96,17 @@ std::string binary_data::read_string(
 void binary_data::write_string(
 	raw & bits, raw::size_type ofs, raw::size_type count_sixbits, const std::string & s)
 {
-	for (raw::size_type i = 0; i < count_sixbits; ++i) {
-		uint8_t value;
-		if (i < s.size()) {
-			value = encode_sixbit_ascii(s[i]);
-		} else {
-			value = encode_sixbit_ascii('@');
+	// collects up to nine characters and writes them at once
+	for (raw::size_type i = 0; i < count_sixbits;) {
+		const raw::size_type n = std::min(count_sixbits - i, max_sixbits_per_word);
+		const raw::size_type word_ofs = ofs + i * 6;
+		uint64_t word = 0;
+		for (raw::size_type k = 0; k < n; ++k, ++i) {
+			// fill character '@' is encoded as zero
+			const uint8_t value = (i < s.size()) ? encode_sixbit_ascii(s[i]) : 0u;
+			word = (word << 6) | (value & 0x3f);
 		}
-		bits.set(value, ofs + i * 6, 6);
+		bits.set(word, word_ofs, n * 6);
 	}
 }
 }
@@ -3,13 +3,21 @@
 
 #include <string>
 #include <marnav/utils/bitset.hpp>
+#include <marnav/utils/fixed_vector.hpp>
 
 namespace marnav
 {
 namespace ais
 {
+/// Maximum number of bytes of raw AIS data. AIS messages occupy at most
+/// five slots (1008 bits), this leaves some room for invalid data.
+constexpr std::size_t max_raw_size = 128u;
+
 /// Type for raw AIS data.
-using raw = utils::bitset<uint8_t>;
+///
+/// The bits are stored inline, with a fixed capacity of `max_raw_size` bytes.
+/// Decoding and encoding of messages does not allocate memory for the raw data.
+using raw = utils::bitset<uint8_t, utils::fixed_vector<uint8_t, max_raw_size>>;
 
 /// @{
 
@@ -347,6 +347,13 @@ public:
 	{
 		return std::unique_ptr<T>(new T{bits});
 	}
+
+	template <class T, class Variant,
+		typename std::enable_if<std::is_base_of<message, T>::value, int>::type = 0>
+	static void emplace_variant(Variant & v, const raw & bits)
+	{
+		v.template emplace<T>(T{bits});
+	}
 };
 }
 /// @endcond
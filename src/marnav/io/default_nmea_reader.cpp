@@ -20,8 +20,8 @@ namespace marnav
 namespace io
 {
 
-default_nmea_reader::default_nmea_reader(std::unique_ptr<device> && dv)
-	: nmea_reader(std::move(dv))
+default_nmea_reader::default_nmea_reader(std::unique_ptr<device> && dv, std::size_t buffer_size)
+	: nmea_reader(std::move(dv), buffer_size)
 	, received_(false)
 {
 }
@@ -13,8 +13,9 @@ namespace marnav
 {
 namespace io
 {
-default_seatalk_reader::default_seatalk_reader(std::unique_ptr<device> && dv)
-	: seatalk_reader(std::move(dv))
+default_seatalk_reader::default_seatalk_reader(
+	std::unique_ptr<device> && dv, std::size_t buffer_size)
+	: seatalk_reader(std::move(dv), buffer_size)
 	, message_received_(false)
 {
 }
@@ -0,0 +1,161 @@
+#include "detail.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+namespace detail
+{
+namespace
+{
+/// Owns the result of `getaddrinfo`.
+class address_info
+{
+public:
+	address_info(const char * host, uint16_t port, int type, int flags)
+	{
+		struct addrinfo hints = {};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = type;
+		hints.ai_flags = flags | AI_NUMERICSERV;
+		const auto service = std::to_string(port);
+		const int rc = ::getaddrinfo(host, service.c_str(), &hints, &info_);
+		if (rc != 0)
+			throw std::runtime_error{
+				"unable to resolve address: " + std::string{host ? host : ""}};
+	}
+
+	~address_info() { ::freeaddrinfo(info_); }
+
+	address_info(const address_info &) = delete;
+	address_info & operator=(const address_info &) = delete;
+
+	const struct addrinfo * get() const noexcept { return info_; }
+
+private:
+	struct addrinfo * info_ = nullptr;
+};
+}
+
+/// Sets the file descriptor to non-blocking mode.
+///
+/// @exception std::runtime_error Unable to set the mode.
+void set_non_blocking(int fd)
+{
+	const int flags = ::fcntl(fd, F_GETFL);
+	if ((flags < 0) || (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0))
+		throw std::runtime_error{"unable to set non-blocking mode"};
+}
+
+/// Waits until the file descriptor is writable, also for non-blocking descriptors.
+///
+/// @retval true  The file descriptor is writable.
+/// @retval false Error or hang up.
+bool wait_writable(int fd)
+{
+	struct pollfd p = {};
+	p.fd = fd;
+	p.events = POLLOUT;
+	for (;;) {
+		const int rc = ::poll(&p, 1, -1);
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		return (p.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0;
+	}
+}
+
+/// Resolves the host and connects a new socket to the first address possible.
+///
+/// @return The connected socket.
+/// @exception std::runtime_error Unable to resolve the host or to connect.
+int connect_socket(const std::string & host, uint16_t port, int type)
+{
+	const address_info info{host.c_str(), port, type, 0};
+	for (auto ai = info.get(); ai; ai = ai->ai_next) {
+		const int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+		if (fd < 0)
+			continue;
+		if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+			return fd;
+		::close(fd);
+	}
+	throw std::runtime_error{"unable to connect to: " + host + ":" + std::to_string(port)};
+}
+
+/// Creates a new socket, bound to the address and port. Local addresses may be reused.
+///
+/// @param[in] address The local address, empty for any.
+/// @param[in] port The local port, \c 0 for any.
+/// @param[in] type Socket type.
+/// @return The bound socket.
+/// @exception std::runtime_error Unable to resolve the address or to bind.
+int bind_socket(const std::string & address, uint16_t port, int type)
+{
+	const address_info info{address.empty() ? nullptr : address.c_str(), port, type,
+		AI_PASSIVE};
+	for (auto ai = info.get(); ai; ai = ai->ai_next) {
+		const int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+		if (fd < 0)
+			continue;
+		const int on = 1;
+		::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+		if (::bind(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+			return fd;
+		::close(fd);
+	}
+	throw std::runtime_error{"unable to bind to: " + address + ":" + std::to_string(port)};
+}
+
+/// Returns the local port of the bound socket.
+///
+/// @exception std::runtime_error Unable to determine the port.
+uint16_t get_local_port(int fd)
+{
+	struct sockaddr_storage addr = {};
+	socklen_t len = sizeof(addr);
+	if (::getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) < 0)
+		throw std::runtime_error{"unable to determine local port"};
+	if (addr.ss_family == AF_INET)
+		return ntohs(reinterpret_cast<const struct sockaddr_in &>(addr).sin_port);
+	if (addr.ss_family == AF_INET6)
+		return ntohs(reinterpret_cast<const struct sockaddr_in6 &>(addr).sin6_port);
+	throw std::runtime_error{"unable to determine local port"};
+}
+
+/// Sends all data, waits if the socket is not writable (backpressure).
+///
+/// @retval true  All data was sent.
+/// @retval false Error, e.g. the connection was closed by the peer.
+bool send_all(int fd, const char * data, std::size_t size)
+{
+	while (size > 0u) {
+		const auto rc = ::send(fd, data, size, MSG_NOSIGNAL);
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+				if (!wait_writable(fd))
+					return false;
+				continue;
+			}
+			return false;
+		}
+		data += rc;
+		size -= static_cast<std::size_t>(rc);
+	}
+	return true;
+}
+}
+}
+}
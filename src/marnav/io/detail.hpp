@@ -0,0 +1,31 @@
+#ifndef MARNAV__IO__DETAIL__HPP
+#define MARNAV__IO__DETAIL__HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace marnav
+{
+namespace io
+{
+/// @cond DEV
+namespace detail
+{
+void set_non_blocking(int fd);
+
+bool wait_writable(int fd);
+
+int connect_socket(const std::string & host, uint16_t port, int type);
+
+int bind_socket(const std::string & address, uint16_t port, int type);
+
+uint16_t get_local_port(int fd);
+
+bool send_all(int fd, const char * data, std::size_t size);
+}
+/// @endcond
+}
+}
+
+#endif
@@ -24,9 +24,16 @@ public:
 
 	/// Reads data from the opened device into the buffer of the specified size.
 	///
+	/// Partial reads are explicitly allowed: a device must return as soon as
+	/// at least one byte is available and must not wait until the entire buffer
+	/// is filled. Readers may therefore pass large buffers to minimize the number
+	/// of calls without affecting latency. The return value must never exceed
+	/// the specified size.
+	///
 	/// @param[out] buffer The buffer to contain all read data.
 	/// @param[in] size The size of the buffer.
-	/// @return The number of bytes read into the buffer.
+	/// @return The number of bytes read into the buffer, between \c 1 and \c size.
+	///   A value of \c 0 signals the end of data, negative values denote errors.
 	/// @exception std::invalid_argument Parameter errors (buffer is nullptr, size is zero, ...)
 	/// @exception std::runtime_error Probably a read error. This does not include EOF.
 	virtual int read(char * buffer, uint32_t size) = 0;
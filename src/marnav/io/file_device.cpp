@@ -0,0 +1,76 @@
+#include "file_device.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+file_device::~file_device()
+{
+	close();
+}
+
+/// Initializes the device, the file is not opened yet.
+///
+/// @param[in] filename The file to read from.
+file_device::file_device(const std::string & filename)
+	: filename_(filename)
+{
+}
+
+/// Opens the file for reading.
+///
+/// @exception std::runtime_error Unable to open the file.
+void file_device::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	fd_ = ::open(filename_.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd_ < 0)
+		throw std::runtime_error{"unable to open file: " + filename_};
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+	::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+/// Closes the file.
+void file_device::close()
+{
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+}
+
+/// Reads data from the file.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of read bytes, \c 0 at the end of the file.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The file is not open.
+int file_device::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	size = std::min(size, static_cast<uint32_t>(std::numeric_limits<int>::max()));
+	return static_cast<int>(::read(fd_, buffer, size));
+}
+
+/// Not supported, the device is read only.
+///
+/// @exception std::runtime_error Always.
+int file_device::write(const char *, uint32_t)
+{
+	throw std::runtime_error{"operation not supported"};
+}
+}
+}
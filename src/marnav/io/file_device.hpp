@@ -0,0 +1,46 @@
+#ifndef MARNAV__IO__FILE_DEVICE__HPP
+#define MARNAV__IO__FILE_DEVICE__HPP
+
+#include <string>
+#include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Read only device for files, e.g. recorded logs.
+///
+/// The file is read sequentially, a read returns as many bytes as requested
+/// until the end of the file is reached. This makes it possible to pass logs
+/// to `nmea_reader` or `seatalk_reader` instead of a serial device.
+///
+/// @note Regular files cannot be registered with a `reactor`, because `epoll`
+///   does not support them. Named pipes (FIFO) can. To replay large logs at disk
+///   speed, see `mapped_log`.
+class file_device : public device, public selectable
+{
+public:
+	virtual ~file_device();
+
+	file_device() = delete;
+	explicit file_device(const std::string & filename);
+	file_device(const file_device &) = delete;
+	file_device(file_device &&) = delete;
+	file_device & operator=(const file_device &) = delete;
+	file_device & operator=(file_device &&) = delete;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+	virtual int get_fd() const override { return fd_; }
+
+private:
+	std::string filename_;
+	int fd_ = -1;
+};
+}
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef MARNAV__IO__GATHER_WRITABLE__HPP
+#define MARNAV__IO__GATHER_WRITABLE__HPP
+
+#include <sys/uio.h>
+
+namespace marnav
+{
+namespace io
+{
+/// Provides an interface for devices which are able to write data from
+/// multiple buffers with one operation (see `writev`). This makes it possible
+/// to write batches of data without copying them into one buffer first.
+class gather_writable
+{
+public:
+	virtual ~gather_writable() {}
+
+	/// Writes the data of the buffers, in order. Devices sending datagrams may send
+	/// every buffer as a datagram of its own.
+	///
+	/// Partial writes are allowed: if the device is in non-blocking mode, the
+	/// function writes as much as possible without waiting.
+	///
+	/// @param[in] iov The buffers to write.
+	/// @param[in] count Number of buffers.
+	/// @return Number of bytes written, negative values denote errors (see `errno`,
+	///   e.g. `EAGAIN` if nothing could be written without waiting).
+	/// @exception std::invalid_argument Parameter errors.
+	/// @exception std::runtime_error The device is not open.
+	virtual int write_gather(const struct iovec * iov, int count) = 0;
+};
+}
+}
+
+#endif
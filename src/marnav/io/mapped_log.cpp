@@ -0,0 +1,252 @@
+#include "mapped_log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t mapped_log::default_chunk_size;
+
+namespace
+{
+/// Values of `c:` above this limit are considered milliseconds, below seconds.
+constexpr int64_t max_unix_time_seconds = 100000000000LL;
+
+/// Extracts the unix time (`c:`) of the tag block preceding the sentence, without
+/// allocating memory. The checksum of the tag block is not verified.
+///
+/// @return The time in milliseconds, or \c -1 if there is no time.
+int64_t extract_unix_time(const char * s, std::size_t n) noexcept
+{
+	if ((n < 2u) || (s[0] != '\\'))
+		return -1;
+
+	const char * const last = s + n;
+	const char * p = s + 1;
+	while ((p < last) && (*p != '\\') && (*p != '*')) {
+		if ((last - p > 2) && (p[0] == 'c') && (p[1] == ':')) {
+			int64_t t = 0;
+			bool valid = false;
+			for (p += 2; (p < last) && (*p >= '0') && (*p <= '9'); ++p) {
+				t = t * 10 + (*p - '0');
+				valid = true;
+			}
+			if (!valid)
+				return -1;
+			return (t < max_unix_time_seconds) ? t * 1000 : t;
+		}
+		while ((p < last) && (*p != ',') && (*p != '\\') && (*p != '*'))
+			++p;
+		if ((p < last) && (*p == ','))
+			++p;
+	}
+	return -1;
+}
+}
+
+mapped_log::~mapped_log()
+{
+	close();
+}
+
+/// Initializes the log, the file is not opened yet.
+///
+/// @param[in] filename The file to replay.
+mapped_log::mapped_log(const std::string & filename)
+	: filename_(filename)
+{
+}
+
+/// Opens the file and maps it into memory. The position is set to the
+/// beginning of the log.
+///
+/// @exception std::runtime_error Unable to open or to map the file, or the file
+///   is too large to be mapped at once (32 bit systems).
+void mapped_log::open()
+{
+	if (open_)
+		return;
+
+	const int fd = ::open(filename_.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw std::runtime_error{"unable to open file: " + filename_};
+
+	struct stat st;
+	if ((::fstat(fd, &st) < 0) || (st.st_size < 0)) {
+		::close(fd);
+		throw std::runtime_error{"unable to determine file size: " + filename_};
+	}
+
+	// off_t may be larger than size_t, e.g. with large file support on 32 bit systems
+	const auto file_size = static_cast<uintmax_t>(st.st_size);
+	if (file_size > std::numeric_limits<std::size_t>::max()) {
+		::close(fd);
+		throw std::runtime_error{"file too large to map: " + filename_};
+	}
+
+	const auto size = static_cast<std::size_t>(file_size);
+	if (size > 0u) {
+		void * p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) {
+			::close(fd);
+			throw std::runtime_error{"unable to map file: " + filename_};
+		}
+		data_ = static_cast<const char *>(p);
+	}
+	::close(fd); // the mapping remains valid
+
+	size_ = size;
+	open_ = true;
+	rewind();
+}
+
+/// Unmaps the file. All data, passed on by `replay`, becomes invalid.
+void mapped_log::close()
+{
+	if (!open_)
+		return;
+	if (data_)
+		::munmap(const_cast<char *>(data_), size_);
+	data_ = nullptr;
+	size_ = 0u;
+	pos_ = 0u;
+	open_ = false;
+}
+
+/// Sets the position to the beginning of the log and resets the pacing.
+void mapped_log::rewind() noexcept
+{
+	pos_ = 0u;
+	line_end_ = 0u;
+	paced_ = false;
+}
+
+/// Enables or disables real time replay.
+///
+/// @param[in] speed Speed factor relative to real time, e.g. \c 1.0 for real time,
+///   \c 10.0 for ten times faster. \c 0 disables pacing, the log is replayed as fast
+///   as possible (default).
+/// @exception std::invalid_argument The speed is negative or not finite.
+void mapped_log::set_pacing(double speed)
+{
+	if (!std::isfinite(speed) || (speed < 0.0))
+		throw std::invalid_argument{"invalid pacing speed"};
+	speed_ = speed;
+	paced_ = false;
+}
+
+/// Waits until the line is due, according to the unix time of its tag block.
+/// The first line with time sets the reference, as well as lines whose time
+/// lies before the reference (the log is not continuous).
+void mapped_log::pace(const char * line, std::size_t size)
+{
+	const int64_t t = extract_unix_time(line, size);
+	if (t < 0)
+		return;
+
+	if (!paced_ || (t < ref_time_)) {
+		ref_time_ = t;
+		ref_clock_ = clock::now();
+		paced_ = true;
+		return;
+	}
+
+	const auto delay = std::chrono::duration<double, std::milli>((t - ref_time_) / speed_);
+	std::this_thread::sleep_until(
+		ref_clock_ + std::chrono::duration_cast<clock::duration>(delay));
+}
+
+/// Returns the number of bytes to pass on from the current position, at most
+/// the specified number. In paced mode, this is limited to the current line,
+/// and the beginning of a line is delayed until the line is due.
+std::size_t mapped_log::next(std::size_t max)
+{
+	const std::size_t remaining = size_ - pos_;
+	if (speed_ <= 0.0)
+		return std::min(max, remaining);
+
+	if (pos_ >= line_end_) {
+		const char * const line = data_ + pos_;
+		const void * eol = std::memchr(line, '\n', remaining);
+		const std::size_t n = eol
+			? static_cast<std::size_t>(static_cast<const char *>(eol) - line) + 1u
+			: remaining;
+		line_end_ = pos_ + n;
+		pace(line, n);
+	}
+	return std::min(max, line_end_ - pos_);
+}
+
+/// Passes the data from the current position to the end of the log to the
+/// handler, directly from the mapping. Lines may span chunks, except in paced
+/// mode, where the data is passed on line by line.
+///
+/// If the handler throws an exception, it is passed on to the caller. The position
+/// is behind the chunk being processed in this case, the replay may be continued
+/// by calling this function again.
+///
+/// @param[in] handler Handler for the data.
+/// @param[in] chunk_size Maximum number of bytes to pass on at once.
+/// @return Number of bytes passed on.
+/// @exception std::invalid_argument The handler is not set or the chunk size is zero.
+/// @exception std::runtime_error The log is not open.
+std::size_t mapped_log::replay(const data_handler & handler, std::size_t chunk_size)
+{
+	if (!handler || (chunk_size == 0u))
+		throw std::invalid_argument{"invalid handler or chunk size"};
+	if (!open_)
+		throw std::runtime_error{"device not open"};
+
+	std::size_t total = 0u;
+	while (pos_ < size_) {
+		const std::size_t n = next(chunk_size);
+		const char * const p = data_ + pos_;
+		pos_ += n;
+		total += n;
+		handler(p, n);
+	}
+	return total;
+}
+
+/// Copies data from the current position into the buffer.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of bytes read, \c 0 at the end of the log.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The log is not open.
+int mapped_log::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (!open_)
+		throw std::runtime_error{"device not open"};
+	if (pos_ >= size_)
+		return 0;
+
+	const std::size_t n = next(std::min(static_cast<std::size_t>(size),
+		static_cast<std::size_t>(std::numeric_limits<int>::max())));
+	std::memcpy(buffer, data_ + pos_, n);
+	pos_ += n;
+	return static_cast<int>(n);
+}
+
+/// Not supported, the log is read only.
+///
+/// @exception std::runtime_error Always.
+int mapped_log::write(const char *, uint32_t)
+{
+	throw std::runtime_error{"operation not supported"};
+}
+}
+}
@@ -0,0 +1,105 @@
+#ifndef MARNAV__IO__MAPPED_LOG__HPP
+#define MARNAV__IO__MAPPED_LOG__HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <marnav/io/device.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Replay of recorded logs, mapped into memory.
+///
+/// The file is mapped into memory as a whole when the device is opened. There are
+/// two ways to access the data:
+///
+/// - `replay`: the data is passed to a handler directly from the mapping, without
+///   copies. Combined with `nmea::stream_decoder`, this replays a log at disk speed.
+/// - `read`: the device interface, copies the data into the buffer of the caller.
+///   This makes it possible to use the log with `nmea_reader` and `seatalk_reader`.
+///
+/// Both advance the same position within the log, see `tell` and `rewind`.
+///
+/// Optionally, the log is replayed in real time (or faster / slower), see
+/// `set_pacing`. The pace is driven by the unix time (`c:`) of the tag blocks
+/// preceding the sentences, lines without time are passed on immediately. In this
+/// mode, the data is passed on line by line. Lines are terminated by LF or CRLF.
+///
+/// Example:
+/// @code
+///   nmea::stream_decoder decoder{[](const nmea::any_sentence & s) { ... }};
+///   io::mapped_log log{"archive.nmea"};
+///   log.open();
+///   log.replay([&decoder](const char * data, std::size_t size) {
+///       decoder.feed(data, size);
+///   });
+/// @endcode
+class mapped_log : public device
+{
+public:
+	/// Called for every chunk of data of the log. The data is valid while the
+	/// log is open.
+	using data_handler = std::function<void(const char *, std::size_t)>;
+
+	/// Default maximum size of the chunks passed on by `replay`.
+	static constexpr std::size_t default_chunk_size = 1024u * 1024u;
+
+	virtual ~mapped_log();
+
+	mapped_log() = delete;
+	explicit mapped_log(const std::string & filename);
+	mapped_log(const mapped_log &) = delete;
+	mapped_log(mapped_log &&) = delete;
+	mapped_log & operator=(const mapped_log &) = delete;
+	mapped_log & operator=(mapped_log &&) = delete;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+
+	std::size_t replay(const data_handler & handler,
+		std::size_t chunk_size = default_chunk_size);
+
+	/// Returns the mapped data, \c nullptr if the log is not open or empty.
+	const char * data() const noexcept { return data_; }
+
+	/// Returns the size of the log in bytes, valid while the log is open.
+	std::size_t size() const noexcept { return size_; }
+
+	/// Returns the current position within the log.
+	std::size_t tell() const noexcept { return pos_; }
+
+	void rewind() noexcept;
+
+	void set_pacing(double speed);
+
+	/// Returns the pacing speed, \c 0 if pacing is disabled.
+	double get_pacing() const noexcept { return speed_; }
+
+private:
+	using clock = std::chrono::steady_clock;
+
+	std::size_t next(std::size_t max);
+	void pace(const char * line, std::size_t size);
+
+	std::string filename_;
+	const char * data_ = nullptr;
+	std::size_t size_ = 0u;
+	std::size_t pos_ = 0u;
+	bool open_ = false;
+
+	double speed_ = 0.0; ///< Pacing speed, 0: disabled
+	std::size_t line_end_ = 0u; ///< End of the current line, paced mode only.
+	bool paced_ = false; ///< Reference for pacing is valid.
+	int64_t ref_time_ = 0; ///< Log time of the reference, milliseconds.
+	clock::time_point ref_clock_; ///< Wall clock time of the reference.
+};
+}
+}
+
+#endif
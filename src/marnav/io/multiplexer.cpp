@@ -0,0 +1,471 @@
+#include "multiplexer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <marnav/io/detail.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/detail.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/utils/unique.hpp>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t multiplexer::default_queue_limit;
+constexpr std::size_t multiplexer::max_line_length;
+constexpr std::size_t multiplexer::max_batch;
+
+namespace
+{
+/// Maximum time to wait for inputs, while data is queued for outputs.
+constexpr int retry_timeout_ms = 10;
+
+constexpr std::size_t num_ids = static_cast<std::size_t>(nmea::sentence_id::STALK) + 1u;
+
+/// Initial capacity of blocks.
+constexpr std::size_t block_capacity = 4096u;
+
+/// Maximum number of blocks kept for reuse.
+constexpr std::size_t max_pooled_blocks = 64u;
+
+/// Returns the first end of line character (CR or LF) within the range,
+/// or `last` if there is none.
+const char * find_eol(const char * first, const char * last) noexcept
+{
+	for (; first != last; ++first)
+		if ((*first == '\n') || (*first == '\r'))
+			return first;
+	return last;
+}
+
+/// Returns \c true if the line is a sentence, optionally preceded by a tag
+/// block, with a correct checksum.
+bool is_valid(const char * s, std::size_t n) noexcept
+{
+	std::size_t start = 0u;
+	if (s[0] == nmea::sentence::tag_block_token) {
+		const void * p = std::memchr(s + 1, nmea::sentence::tag_block_token, n - 1u);
+		if (!p)
+			return false;
+		start = static_cast<std::size_t>(static_cast<const char *>(p) - s) + 1u;
+	}
+	if ((start >= n)
+		|| ((s[start] != nmea::sentence::start_token)
+			&& (s[start] != nmea::sentence::start_token_ais)))
+		return false;
+	return nmea::scan_checksum(s + start + 1u, s + n).result == nmea::checksum_scan::status::ok;
+}
+}
+
+multiplexer::multiplexer()
+{
+	iov_.reserve(max_batch);
+}
+
+multiplexer::~multiplexer()
+{
+	for (auto & out : outputs_)
+		out.dev->close();
+}
+
+/// Registers an input device, which is opened and read by the multiplexer.
+///
+/// @param[in] dev The device to read data from, must implement `selectable`.
+/// @return The ID of the input.
+/// @exception std::invalid_argument The device is not set or does not implement
+///   `selectable`.
+/// @exception std::runtime_error Unable to open the device.
+std::size_t multiplexer::add_input(std::unique_ptr<device> && dev)
+{
+	const std::size_t id = inputs_.size();
+	reactor_.add(std::move(dev),
+		[this, id](const char * data, std::size_t size) { process(id, data, size); });
+	inputs_.emplace_back();
+	return id;
+}
+
+/// Registers an input without device, its data is passed directly to `process`.
+///
+/// @return The ID of the input.
+std::size_t multiplexer::add_input()
+{
+	inputs_.emplace_back();
+	return inputs_.size() - 1u;
+}
+
+/// Registers and opens an output device.
+///
+/// @param[in] dev The device to write data to.
+/// @param[in] queue_limit Maximum number of queued sentences.
+/// @return The ID of the output.
+/// @exception std::invalid_argument The device is not set or the queue limit is zero.
+/// @exception std::runtime_error Unable to open the device.
+std::size_t multiplexer::add_output(std::unique_ptr<device> && dev, std::size_t queue_limit)
+{
+	if (!dev)
+		throw std::invalid_argument{"no device in io::multiplexer"};
+	if (queue_limit == 0u)
+		throw std::invalid_argument{"invalid queue limit in io::multiplexer"};
+
+	dev->open();
+	if (const auto sel = dynamic_cast<const selectable *>(dev.get())) {
+		if (sel->get_fd() >= 0)
+			detail::set_non_blocking(sel->get_fd());
+	}
+
+	output out;
+	out.gather = dynamic_cast<gather_writable *>(dev.get());
+	out.dev = std::move(dev);
+	out.queue_limit = queue_limit;
+	outputs_.push_back(std::move(out));
+	return outputs_.size() - 1u;
+}
+
+/// Forwards all valid sentences of the input to the output.
+///
+/// @exception std::out_of_range Invalid input or output.
+void multiplexer::add_route(std::size_t input, std::size_t output)
+{
+	get_output(output);
+	get_input(input).routes.push_back(route{output, nullptr});
+}
+
+/// Forwards the sentences of the input which are accepted by the filter
+/// to the output.
+///
+/// @exception std::out_of_range Invalid input or output.
+void multiplexer::add_route(
+	std::size_t input, std::size_t output, const nmea::sentence_filter & filter)
+{
+	get_output(output);
+	get_input(input).routes.push_back(
+		route{output, utils::make_unique<nmea::sentence_filter>(filter)});
+}
+
+/// Limits the rate of sentences with the specified ID for the output.
+///
+/// @param[in] output The output.
+/// @param[in] id The sentence ID.
+/// @param[in] interval Minimum interval between two sentences, zero disables the limit.
+/// @exception std::out_of_range Invalid output.
+/// @exception std::invalid_argument Negative interval.
+void multiplexer::set_rate_limit(
+	std::size_t output, nmea::sentence_id id, std::chrono::milliseconds interval)
+{
+	if (interval.count() < 0)
+		throw std::invalid_argument{"invalid interval in io::multiplexer"};
+	auto & out = get_output(output);
+	if (out.rate_limits.empty())
+		out.rate_limits.resize(num_ids);
+	out.rate_limits[static_cast<std::size_t>(id)].interval
+		= std::chrono::duration_cast<clock::duration>(interval);
+}
+
+multiplexer::input & multiplexer::get_input(std::size_t id)
+{
+	if (id >= inputs_.size())
+		throw std::out_of_range{"invalid input in io::multiplexer"};
+	return inputs_[id];
+}
+
+multiplexer::output & multiplexer::get_output(std::size_t id)
+{
+	if (id >= outputs_.size())
+		throw std::out_of_range{"invalid output in io::multiplexer"};
+	return outputs_[id];
+}
+
+const multiplexer::output & multiplexer::get_output(std::size_t id) const
+{
+	if (id >= outputs_.size())
+		throw std::out_of_range{"invalid output in io::multiplexer"};
+	return outputs_[id];
+}
+
+/// Returns the statistics of the input.
+///
+/// @exception std::out_of_range Invalid input.
+const multiplexer::input_statistics & multiplexer::get_input_statistics(
+	std::size_t input) const
+{
+	if (input >= inputs_.size())
+		throw std::out_of_range{"invalid input in io::multiplexer"};
+	return inputs_[input].stats;
+}
+
+/// Returns the statistics of the output.
+///
+/// @exception std::out_of_range Invalid output.
+const multiplexer::output_statistics & multiplexer::get_output_statistics(
+	std::size_t output) const
+{
+	return get_output(output).stats;
+}
+
+/// Processes a chunk of data of the input: all complete lines are validated and
+/// forwarded, an incomplete line at the end is kept for the next call. The outputs
+/// are flushed afterwards.
+///
+/// @param[in] input The input the data was received from.
+/// @param[in] data The data.
+/// @param[in] size Number of bytes of the data.
+/// @exception std::out_of_range Invalid input.
+void multiplexer::process(std::size_t input, const char * data, std::size_t size)
+{
+	auto & in = get_input(input);
+	if (!data || (size == 0u))
+		return;
+
+	const char * const last = data + size;
+	const char * p = data;
+
+	// complete the line of the previous chunk
+	if (!in.line.empty() || in.overflow) {
+		const char * const eol = find_eol(p, last);
+		const std::size_t n = static_cast<std::size_t>(eol - p);
+		if (in.line.size() + n > max_line_length)
+			in.overflow = true;
+		else
+			in.line.insert(in.line.end(), p, eol);
+		if (eol == last)
+			return;
+		p = eol + 1;
+
+		if (in.overflow) {
+			++in.stats.received;
+			++in.stats.invalid;
+		} else {
+			process_line(in, in.line.data(), in.line.size());
+		}
+		in.line.clear();
+		in.overflow = false;
+	}
+
+	// all complete lines within the chunk, directly from the chunk
+	for (;;) {
+		const char * const eol = find_eol(p, last);
+		if (eol == last)
+			break;
+		process_line(in, p, static_cast<std::size_t>(eol - p));
+		p = eol + 1;
+	}
+
+	// incomplete line
+	const std::size_t n = static_cast<std::size_t>(last - p);
+	if (n > max_line_length)
+		in.overflow = true;
+	else
+		in.line.assign(p, last);
+
+	flush();
+	block_.reset();
+}
+
+/// Validates the line and queues it for the outputs of all routes of the input.
+void multiplexer::process_line(input & in, const char * s, std::size_t n)
+{
+	if (n == 0u)
+		return;
+
+	++in.stats.received;
+	if (!is_valid(s, n)) {
+		++in.stats.invalid;
+		return;
+	}
+
+	nmea::talker talk = nmea::talker::none;
+	nmea::sentence_id id = nmea::sentence_id::NONE;
+	bool known = false;
+	const char * address = nullptr;
+	std::size_t address_size = 0u;
+	if (nmea::detail::find_address(s, n, address, address_size))
+		known = nmea::detail::parse_address(address, address_size, talk, id);
+
+	std::size_t offset = std::numeric_limits<std::size_t>::max();
+	clock::time_point now;
+	bool now_valid = false;
+
+	for (const auto & r : in.routes) {
+		if (r.filter && (!known || !r.filter->accepts(id, talk)))
+			continue;
+
+		auto & out = outputs_[r.output];
+		if (out.queue.size() >= out.queue_limit) {
+			++out.stats.dropped;
+			continue;
+		}
+
+		if (known && !out.rate_limits.empty()) {
+			auto & limit = out.rate_limits[static_cast<std::size_t>(id)];
+			if (limit.interval > clock::duration::zero()) {
+				if (!now_valid) {
+					now = clock::now();
+					now_valid = true;
+				}
+				const bool first = (limit.last == clock::time_point{});
+				if (!first && (now - limit.last < limit.interval)) {
+					++out.stats.rate_limited;
+					continue;
+				}
+				limit.last = now;
+			}
+		}
+
+		// copy the sentence once, shared by all outputs
+		if (offset == std::numeric_limits<std::size_t>::max()) {
+			if (!block_)
+				block_ = acquire_block();
+			offset = block_->size();
+			block_->insert(block_->end(), s, s + n);
+			block_->push_back('\r');
+			block_->push_back('\n');
+		}
+		out.queue.push_back(entry{block_, offset, n + 2u});
+	}
+}
+
+/// Returns an empty block for the sentences of a chunk. Blocks no longer referred to
+/// by any queue are reused, new blocks are allocated only if all of them are in use.
+multiplexer::block multiplexer::acquire_block()
+{
+	for (const auto & b : blocks_) {
+		if (b.use_count() == 1) {
+			b->clear();
+			return b;
+		}
+	}
+	auto b = std::make_shared<std::vector<char>>();
+	b->reserve(block_capacity);
+	if (blocks_.size() < max_pooled_blocks)
+		blocks_.push_back(b);
+	return b;
+}
+
+/// Writes the queued sentences to all outputs, as much as possible without waiting
+/// (non-blocking outputs).
+///
+/// @retval true  All queues are empty.
+/// @retval false There are still sentences queued.
+bool multiplexer::flush()
+{
+	bool empty = true;
+	for (auto & out : outputs_)
+		empty = flush(out) && empty;
+	return empty;
+}
+
+bool multiplexer::flush(output & out)
+{
+	while (!out.queue.empty()) {
+		if (!write_batch(out))
+			break;
+	}
+	return out.queue.empty();
+}
+
+/// Writes the next batch of queued sentences to the output.
+///
+/// @retval true  Data was written.
+/// @retval false Nothing was written, the output would block or failed.
+bool multiplexer::write_batch(output & out)
+{
+	int rc = -1;
+	try {
+		const auto & first = out.queue.front();
+		if (out.gather) {
+			iov_.clear();
+			const std::size_t n = std::min(max_batch, out.queue.size());
+			for (std::size_t i = 0u; i < n; ++i) {
+				const auto & e = out.queue[i];
+				struct iovec v;
+				v.iov_base = e.data->data() + e.offset;
+				v.iov_len = e.size;
+				iov_.push_back(v);
+			}
+			iov_[0].iov_base = static_cast<char *>(iov_[0].iov_base) + out.written;
+			iov_[0].iov_len -= out.written;
+			rc = out.gather->write_gather(iov_.data(), static_cast<int>(iov_.size()));
+		} else {
+			rc = out.dev->write(first.data->data() + first.offset + out.written,
+				static_cast<uint32_t>(first.size - out.written));
+		}
+	} catch (std::runtime_error &) {
+		rc = -1;
+		errno = EIO;
+	}
+
+	if (rc <= 0) {
+		if ((rc == 0) || (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+			return false;
+
+		// write error, drop all queued data
+		++out.stats.errors;
+		out.stats.dropped += out.queue.size();
+		out.queue.clear();
+		out.written = 0u;
+		return false;
+	}
+
+	// remove the written sentences from the queue
+	auto n = static_cast<std::size_t>(rc);
+	while ((n > 0u) && !out.queue.empty()) {
+		const std::size_t remaining = out.queue.front().size - out.written;
+		if (n < remaining) {
+			out.written += n;
+			break;
+		}
+		n -= remaining;
+		out.written = 0u;
+		out.queue.pop_front();
+		++out.stats.sent;
+	}
+	return true;
+}
+
+/// Waits for data on the inputs and forwards it. While sentences are queued,
+/// the wait is limited to retry writing them.
+///
+/// @param[in] timeout_ms Maximum time to wait in milliseconds, \c -1 waits
+///   indefinitely, \c 0 returns immediately.
+/// @return The number of processed inputs.
+/// @exception std::runtime_error Error while waiting for the inputs.
+std::size_t multiplexer::run_once(int timeout_ms)
+{
+	const bool pending = std::any_of(outputs_.begin(), outputs_.end(),
+		[](const output & out) { return !out.queue.empty(); });
+	if (pending && ((timeout_ms < 0) || (timeout_ms > retry_timeout_ms)))
+		timeout_ms = retry_timeout_ms;
+
+	const std::size_t n = reactor_.run_once(timeout_ms);
+	flush();
+	return n;
+}
+
+/// Forwards data until `stop` is called, or all inputs are closed and all
+/// queued sentences are written.
+///
+/// @exception std::runtime_error Error while waiting for the inputs.
+void multiplexer::run()
+{
+	while (!stop_) {
+		if ((reactor_.size() == 0u) && flush())
+			break;
+		run_once();
+	}
+	stop_ = false;
+}
+
+/// Stops `run`. This function may be called from any thread or from within a handler.
+/// If called before `run`, the next call to `run` returns immediately.
+void multiplexer::stop()
+{
+	stop_ = true;
+	reactor_.stop();
+}
+}
+}
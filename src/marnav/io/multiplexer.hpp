@@ -0,0 +1,173 @@
+#ifndef MARNAV__IO__MULTIPLEXER__HPP
+#define MARNAV__IO__MULTIPLEXER__HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/reactor.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
+#include <marnav/nmea/sentence_id.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Forwards NMEA sentences from any number of inputs to any number of outputs.
+///
+/// Inputs are read with a `reactor` and must therefore implement `selectable`.
+/// Data may also be passed to an input directly, see `process`. The data of every
+/// input is framed into lines, and lines are validated by their checksum only,
+/// sentences are not parsed. Valid sentences are forwarded, terminated by CRLF,
+/// along the routes of the input. A route connects an input with an output, it
+/// optionally filters sentences by sentence ID and talker.
+///
+/// Every output has a bounded queue. Sentences which do not fit into the queue
+/// are dropped. A sentence is copied once from the input into a shared block of
+/// memory, the queues of all outputs refer to it. Blocks are reused once all
+/// their sentences are written. Queued sentences are written in batches, with
+/// one gather write (see `gather_writable`) per batch, or one write per sentence
+/// for other devices. UDP outputs send one sentence per datagram. Outputs which
+/// implement `selectable` are switched to non-blocking mode, to not stall the
+/// multiplexer. Data which could not be written is kept queued and is written
+/// with the next batch.
+///
+/// Optionally, the rate of sentences per sentence ID is limited per output:
+/// a sentence is forwarded only if the last one with the same ID was forwarded
+/// at least the specified interval ago.
+///
+/// Example:
+/// @code
+///   io::multiplexer mux;
+///   const auto gps = mux.add_input(utils::make_unique<io::serial>(...));
+///   const auto ais = mux.add_input(utils::make_unique<io::udp_device>(10110));
+///   const auto out = mux.add_output(utils::make_unique<io::tcp_server>(10110));
+///   mux.add_route(gps, out);
+///   mux.add_route(ais, out, {nmea::sentence_id::VDM});
+///   mux.set_rate_limit(out, nmea::sentence_id::GSV, std::chrono::seconds{5});
+///   mux.run();
+/// @endcode
+class multiplexer
+{
+public:
+	/// Default maximum number of sentences queued per output.
+	static constexpr std::size_t default_queue_limit = 1024u;
+
+	/// Maximum length of a line, including an optional tag block. Longer lines
+	/// are discarded.
+	static constexpr std::size_t max_line_length = 1024u;
+
+	/// Maximum number of sentences written with one gather write.
+	static constexpr std::size_t max_batch = 64u;
+
+	struct input_statistics {
+		uint64_t received = 0u; ///< Number of lines received.
+		uint64_t invalid = 0u; ///< Number of lines discarded, e.g. wrong checksum.
+	};
+
+	struct output_statistics {
+		uint64_t sent = 0u; ///< Number of sentences written.
+		uint64_t dropped = 0u; ///< Number of sentences dropped, queue full or write error.
+		uint64_t rate_limited = 0u; ///< Number of sentences dropped by rate limits.
+		uint64_t errors = 0u; ///< Number of write errors.
+	};
+
+	multiplexer();
+	~multiplexer();
+
+	multiplexer(const multiplexer &) = delete;
+	multiplexer(multiplexer &&) = delete;
+
+	multiplexer & operator=(const multiplexer &) = delete;
+	multiplexer & operator=(multiplexer &&) = delete;
+
+	std::size_t add_input(std::unique_ptr<device> && dev);
+	std::size_t add_input();
+	std::size_t add_output(
+		std::unique_ptr<device> && dev, std::size_t queue_limit = default_queue_limit);
+
+	void add_route(std::size_t input, std::size_t output);
+	void add_route(std::size_t input, std::size_t output, const nmea::sentence_filter & filter);
+
+	void set_rate_limit(
+		std::size_t output, nmea::sentence_id id, std::chrono::milliseconds interval);
+
+	void process(std::size_t input, const char * data, std::size_t size);
+	bool flush();
+
+	std::size_t run_once(int timeout_ms = -1);
+	void run();
+	void stop();
+
+	const input_statistics & get_input_statistics(std::size_t input) const;
+	const output_statistics & get_output_statistics(std::size_t output) const;
+
+	/// Returns the number of sentences queued for the output.
+	std::size_t get_queue_size(std::size_t output) const
+	{
+		return get_output(output).queue.size();
+	}
+
+private:
+	using clock = std::chrono::steady_clock;
+	using block = std::shared_ptr<std::vector<char>>;
+
+	struct route {
+		std::size_t output;
+		std::unique_ptr<nmea::sentence_filter> filter; ///< Optional, accepts all if not set.
+	};
+
+	struct input {
+		std::vector<char> line; ///< Incomplete line of the previous chunks.
+		bool overflow = false; ///< The current line is too long, skip until end of line.
+		std::vector<route> routes;
+		input_statistics stats;
+	};
+
+	struct entry {
+		block data;
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	struct rate_limit {
+		clock::duration interval = clock::duration::zero();
+		clock::time_point last;
+	};
+
+	struct output {
+		std::unique_ptr<device> dev;
+		gather_writable * gather = nullptr;
+		std::size_t queue_limit = default_queue_limit;
+		std::deque<entry> queue;
+		std::size_t written = 0u; ///< Bytes of the first queued sentence already written.
+		std::vector<rate_limit> rate_limits; ///< Per sentence ID, empty if there are none.
+		output_statistics stats;
+	};
+
+	input & get_input(std::size_t id);
+	output & get_output(std::size_t id);
+	const output & get_output(std::size_t id) const;
+
+	void process_line(input & in, const char * s, std::size_t n);
+	block acquire_block();
+	bool flush(output & out);
+	bool write_batch(output & out);
+
+	reactor reactor_;
+	std::vector<input> inputs_;
+	std::vector<output> outputs_;
+	block block_; ///< Block of the sentences of the current chunk.
+	std::vector<block> blocks_; ///< Blocks for reuse, see `acquire_block`.
+	std::vector<struct iovec> iov_; ///< Buffers of the current batch.
+	std::atomic<bool> stop_{false};
+};
+}
+}
+
+#endif
@@ -1,11 +1,16 @@
 #include "nmea_reader.hpp"
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <marnav/utils/unique.hpp>
 
 namespace marnav
 {
 namespace io
 {
+constexpr std::size_t nmea_reader::unbuffered;
+constexpr std::size_t nmea_reader::default_buffer_size;
+
 nmea_reader::~nmea_reader()
 {
 }
@@ -13,23 +18,35 @@ nmea_reader::~nmea_reader()
 /// Initializes the reader, opens the device (if valid).
 ///
 /// @param[in] d The device to read data from, will be opened.
-nmea_reader::nmea_reader(std::unique_ptr<device> && d)
-	: raw_(0)
+/// @param[in] buffer_size Maximum number of bytes to read from the device at once.
+///   Values greater than nmea_reader::unbuffered enable the buffered mode.
+/// @exception std::invalid_argument The buffer size is zero or exceeds the capabilities
+///   of the device interface.
+nmea_reader::nmea_reader(std::unique_ptr<device> && d, std::size_t buffer_size)
+	: pos_(0)
+	, end_(0)
 	, dev_(std::move(d))
 {
+	if ((buffer_size == 0) || (buffer_size > std::numeric_limits<uint32_t>::max()))
+		throw std::invalid_argument{"invalid buffer size"};
+	buffer_.resize(buffer_size);
 	sentence_.reserve(nmea::sentence::max_length + 1);
 	if (dev_)
 		dev_->open();
 }
 
+/// Closes the device. Buffered data, not yet processed, is discarded.
 void nmea_reader::close()
 {
 	if (dev_)
 		dev_->close();
 	dev_.reset();
+	pos_ = 0;
+	end_ = 0;
 }
 
-/// Reads data from the device.
+/// Reads data from the device into the internal buffer. Partial reads
+/// are accepted.
 ///
 /// @retval true  Success.
 /// @retval false End of file.
@@ -38,56 +55,72 @@ bool nmea_reader::read_data()
 {
 	if (!dev_)
 		throw std::runtime_error{"device invalid"};
-	int rc = dev_->read(&raw_, sizeof(raw_));
+	int rc = dev_->read(buffer_.data(), static_cast<uint32_t>(buffer_.size()));
 	if (rc == 0)
 		return false;
 	if (rc < 0)
 		throw std::runtime_error{"read error"};
-	if (rc != sizeof(raw_))
+	if (static_cast<std::size_t>(rc) > buffer_.size())
 		throw std::runtime_error{"read error"};
+	pos_ = 0;
+	end_ = static_cast<std::size_t>(rc);
 	return true;
 }
 
-/// Processes the data read from the device.
+/// Processes one character of the data read from the device.
 ///
+/// @param[in] raw The character to process.
+/// @retval true  The character completed a sentence, which was processed.
+/// @retval false The sentence is not complete yet.
 /// @exception std::length_error Too many characters read for the sentence.
 ///   Maybe the end of line was missed or left out.
-void nmea_reader::process_nmea()
+bool nmea_reader::process_nmea(char raw)
 {
-	switch (raw_) {
+	switch (raw) {
 		case '\r':
 			break;
 		case '\n': // end of sentence
 			process_sentence(sentence_);
 			sentence_.clear();
-			break;
+			return true;
 		default:
 			// ignore invalid characters. if this makes the sentence incomplete,
 			// the sentence would have been invalid anyway. the result will be
 			// an invalid sentence or a std::length_error.
-			if ((raw_ <= 32) || (raw_ >= 127))
-				return;
+			if ((raw <= 32) || (raw >= 127))
+				break;
 
 			if (sentence_.size() > nmea::sentence::max_length)
 				throw std::length_error{"sentence size to large. receiving NMEA data?"};
-			sentence_ += raw_;
+			sentence_ += raw;
 			break;
 	}
+	return false;
 }
 
 /// Reads data from the device and processes it. If a complete NMEA
 /// sentence was received the method process_message will be executed.
 /// This method automatcially synchronizes with NMEA data.
 ///
+/// In buffered mode, the buffered data is processed up to and including the
+/// end of the next complete sentence. The device is read only if there is
+/// no more buffered data, subsequent calls process the remaining data first.
+/// This guarantees at most one call to process_sentence per call.
+///
 /// @retval true  Success.
 /// @retval false End of file.
 /// @exception std::runtime_error Device or processing error.
 /// @exception std::length_error Synchronization issue.
 bool nmea_reader::read()
 {
-	if (!read_data())
-		return false;
-	process_nmea();
+	if (pos_ >= end_) {
+		if (!read_data())
+			return false;
+	}
+	while (pos_ < end_) {
+		if (process_nmea(buffer_[pos_++]))
+			break;
+	}
 	return true;
 }
 }
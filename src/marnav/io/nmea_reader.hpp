@@ -1,6 +1,7 @@
 #ifndef MARNAV__IO__NMEA_READER__HPP
 #define MARNAV__IO__NMEA_READER__HPP
 
+#include <vector>
 #include <marnav/io/device.hpp>
 #include <marnav/nmea/sentence.hpp>
 
@@ -15,12 +16,26 @@ namespace io
 ///
 /// This reader opens the device upon construction.
 ///
+/// By default, data is read from the device one character at a time. If a
+/// buffer size greater than one is specified, the reader operates in buffered
+/// mode: data is read from the device in chunks of up to the buffer size
+/// and all sentences contained in a chunk are framed from the internal buffer,
+/// without further access to the device. This reduces the number of device
+/// reads (and system calls) significantly, but requires the device to support
+/// partial reads, see device::read.
+///
 class nmea_reader
 {
 public:
+	/// Buffer size which reads one character at a time from the device.
+	static constexpr std::size_t unbuffered = 1u;
+
+	/// Reasonable buffer size for buffered reads.
+	static constexpr std::size_t default_buffer_size = 4096u;
+
 	virtual ~nmea_reader();
 
-	nmea_reader(std::unique_ptr<device> && d);
+	nmea_reader(std::unique_ptr<device> && d, std::size_t buffer_size = unbuffered);
 	nmea_reader(const nmea_reader &) = delete;
 	nmea_reader(nmea_reader &&) = default;
 
@@ -34,10 +49,12 @@ protected:
 	virtual void process_sentence(const std::string &) = 0;
 
 private:
-	void process_nmea();
+	bool process_nmea(char raw);
 	bool read_data();
 
-	char raw_;
+	std::vector<char> buffer_; ///< Data read from the device, not yet processed.
+	std::size_t pos_; ///< Position of the next character to process within the buffer.
+	std::size_t end_; ///< End of valid data within the buffer.
 	std::string sentence_;
 	std::unique_ptr<device> dev_; ///< Device to read data from.
 };
@@ -0,0 +1,260 @@
+#include "reactor.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <marnav/io/detail.hpp>
+#include <marnav/io/selectable.hpp>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t reactor::default_buffer_size;
+
+namespace
+{
+/// ID of the wake up event, never used for devices.
+constexpr std::size_t wakeup_id = 0u;
+
+/// Maximum number of events processed per wait.
+constexpr int max_events = 64;
+}
+
+/// Initializes the reactor.
+///
+/// @param[in] buffer_size Maximum number of bytes to read from a device at once.
+/// @exception std::invalid_argument The buffer size is zero or exceeds the capabilities
+///   of the device interface.
+/// @exception std::runtime_error Unable to create the epoll instance.
+reactor::reactor(std::size_t buffer_size)
+{
+	if ((buffer_size == 0) || (buffer_size > std::numeric_limits<uint32_t>::max()))
+		throw std::invalid_argument{"invalid buffer size"};
+	buffer_.resize(buffer_size);
+
+	epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+	if (epfd_ < 0)
+		throw std::runtime_error{"unable to create epoll instance"};
+
+	evfd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (evfd_ < 0) {
+		::close(epfd_);
+		throw std::runtime_error{"unable to create event"};
+	}
+
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.u64 = wakeup_id;
+	if (::epoll_ctl(epfd_, EPOLL_CTL_ADD, evfd_, &ev) < 0) {
+		::close(evfd_);
+		::close(epfd_);
+		throw std::runtime_error{"unable to register event"};
+	}
+}
+
+/// Closes all registered devices.
+reactor::~reactor()
+{
+	for (auto & c : channels_)
+		c.second.dev->close();
+	::close(evfd_);
+	::close(epfd_);
+}
+
+/// Opens the device and registers it.
+///
+/// @param[in] dev The device to read data from, must implement `selectable`.
+/// @param[in] handler Handler for the data read from the device.
+/// @return The ID of the device, used to remove it.
+/// @exception std::invalid_argument The device or the handler is not set, or the
+///   device does not implement `selectable`.
+/// @exception std::runtime_error Unable to open or to register the device.
+std::size_t reactor::add(std::unique_ptr<device> && dev, data_handler handler)
+{
+	if (!dev)
+		throw std::invalid_argument{"no device in io::reactor"};
+	if (!handler)
+		throw std::invalid_argument{"no data handler in io::reactor"};
+	const auto sel = dynamic_cast<const selectable *>(dev.get());
+	if (!sel)
+		throw std::invalid_argument{"device is not selectable in io::reactor"};
+
+	dev->open();
+	const int fd = sel->get_fd();
+	if (fd < 0) {
+		dev->close();
+		throw std::runtime_error{"invalid file descriptor in io::reactor"};
+	}
+
+	try {
+		detail::set_non_blocking(fd);
+	} catch (...) {
+		dev->close();
+		throw;
+	}
+
+	const std::size_t id = next_id_++;
+
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.u64 = id;
+	if (::epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		dev->close();
+		throw std::runtime_error{"unable to register device in io::reactor"};
+	}
+
+	channels_.emplace(id, channel{std::move(dev), std::move(handler), fd});
+	return id;
+}
+
+/// Removes and closes the device with the specified ID. The close handler
+/// is not called. It is safe to call this from within a handler.
+///
+/// @param[in] id The ID of the device to remove.
+/// @retval true  The device was removed.
+/// @retval false There is no device with the specified ID.
+bool reactor::remove(std::size_t id)
+{
+	if (!is_registered(id))
+		return false;
+	close_channel(id, false);
+	return true;
+}
+
+bool reactor::is_registered(std::size_t id) const
+{
+	if ((id == dispatching_) && dispatch_removed_)
+		return false;
+	return channels_.find(id) != channels_.end();
+}
+
+/// Closes the device and removes it. If the handler of the device is running,
+/// the channel is erased after the handler returned (see `finish_dispatch`).
+void reactor::close_channel(std::size_t id, bool notify)
+{
+	if (!is_registered(id))
+		return;
+	auto i = channels_.find(id);
+
+	::epoll_ctl(epfd_, EPOLL_CTL_DEL, i->second.fd, nullptr);
+	if (id == dispatching_) {
+		dispatch_removed_ = true;
+		i->second.dev->close();
+	} else {
+		auto dev = std::move(i->second.dev);
+		channels_.erase(i);
+		dev->close();
+	}
+
+	if (notify && on_close_)
+		on_close_(id);
+}
+
+/// Reads the available data from the device and passes it to its handler.
+/// The device is closed on end of data or on errors.
+void reactor::process(std::size_t id)
+{
+	auto i = channels_.find(id);
+	if (i == channels_.end())
+		return; // removed by a handler, while processing the same set of events
+
+	int rc = -1;
+	try {
+		rc = i->second.dev->read(buffer_.data(), static_cast<uint32_t>(buffer_.size()));
+	} catch (std::runtime_error &) {
+		close_channel(id, true);
+		return;
+	}
+
+	if (rc < 0) {
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+			return;
+		close_channel(id, true);
+		return;
+	}
+	if (rc == 0) {
+		close_channel(id, true);
+		return;
+	}
+
+	// the channel may be removed by the handler itself, it is kept until the
+	// handler returned, see `close_channel`.
+	dispatching_ = id;
+	try {
+		i->second.handler(buffer_.data(), static_cast<std::size_t>(rc));
+	} catch (...) {
+		finish_dispatch();
+		throw;
+	}
+	finish_dispatch();
+}
+
+/// Erases the channel of the device whose handler just returned, if it was
+/// removed by the handler.
+void reactor::finish_dispatch()
+{
+	if (dispatch_removed_)
+		channels_.erase(dispatching_);
+	dispatching_ = 0u;
+	dispatch_removed_ = false;
+}
+
+/// Waits for data on the registered devices and processes it. Every device
+/// with available data is read once.
+///
+/// @param[in] timeout_ms Maximum time to wait in milliseconds, \c -1 waits
+///   indefinitely, \c 0 returns immediately.
+/// @return The number of processed devices, \c 0 on timeout or if the reactor
+///   was woken up by `stop`.
+/// @exception std::runtime_error Error while waiting for the devices.
+std::size_t reactor::run_once(int timeout_ms)
+{
+	struct epoll_event events[max_events];
+	const int n = ::epoll_wait(epfd_, events, max_events, timeout_ms);
+	if (n < 0) {
+		if (errno == EINTR)
+			return 0u;
+		throw std::runtime_error{"error while waiting in io::reactor"};
+	}
+
+	std::size_t count = 0u;
+	for (int k = 0; k < n; ++k) {
+		const auto id = static_cast<std::size_t>(events[k].data.u64);
+		if (id == wakeup_id) {
+			uint64_t value;
+			while (::read(evfd_, &value, sizeof(value)) > 0)
+				;
+			stop_ = true;
+			continue;
+		}
+		process(id);
+		++count;
+	}
+	return count;
+}
+
+/// Processes data until `stop` is called or no more devices are registered.
+///
+/// @exception std::runtime_error Error while waiting for the devices.
+void reactor::run()
+{
+	while (!stop_ && !channels_.empty())
+		run_once();
+	stop_ = false;
+}
+
+/// Stops `run`, the call returns after processing the current events.
+/// This function may be called from any thread or from within a handler.
+/// If called before `run`, the next call to `run` returns immediately.
+void reactor::stop()
+{
+	const uint64_t value = 1u;
+	while ((::write(evfd_, &value, sizeof(value)) < 0) && (errno == EINTR))
+		;
+}
+}
+}
@@ -0,0 +1,127 @@
+#ifndef MARNAV__IO__REACTOR__HPP
+#define MARNAV__IO__REACTOR__HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <marnav/io/device.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Event loop for any number of devices, based on `epoll` (Linux only).
+///
+/// All registered devices are waited for at once, without a thread per device.
+/// Devices must implement `selectable`, their file descriptors are switched to
+/// non-blocking mode. Whenever data is available, it is read into a buffer shared
+/// by all devices and passed to the data handler of the device.
+///
+/// The framing of the data is up to the handler. Decoders with a method
+/// `feed(const char *, std::size_t)` and their own framing buffer, like
+/// `nmea::stream_decoder` or `seatalk_decoder`, can be registered directly,
+/// one per device.
+///
+/// A device which signals the end of data or an error is closed and removed
+/// from the reactor, the close handler (if any) is called for it.
+///
+/// Exceptions thrown by the handlers are passed on to the caller of `run`
+/// or `run_once`. The reactor remains usable.
+///
+/// Example:
+/// @code
+///   io::reactor r;
+///   r.add_decoder(utils::make_unique<my_device>("/dev/ttyUSB0"),
+///       nmea::stream_decoder{[](const nmea::any_sentence & s) { ... }});
+///   r.add_decoder(utils::make_unique<my_device>("/dev/ttyUSB1"),
+///       io::seatalk_decoder{[](const seatalk::raw & data) { ... }});
+///   r.run();
+/// @endcode
+class reactor
+{
+public:
+	/// Called for every chunk of data read from a device. The data is valid
+	/// only during the call.
+	using data_handler = std::function<void(const char *, std::size_t)>;
+
+	/// Called for every device closed by the reactor, because of end of data
+	/// or an error. The parameter is the ID of the device.
+	using close_handler = std::function<void(std::size_t)>;
+
+	/// Default size of the read buffer.
+	static constexpr std::size_t default_buffer_size = 4096u;
+
+	explicit reactor(std::size_t buffer_size = default_buffer_size);
+	~reactor();
+
+	reactor(const reactor &) = delete;
+	reactor(reactor &&) = delete;
+
+	reactor & operator=(const reactor &) = delete;
+	reactor & operator=(reactor &&) = delete;
+
+	std::size_t add(std::unique_ptr<device> && dev, data_handler handler);
+
+	/// Registers a device whose data is passed to the specified decoder.
+	/// The decoder is owned by the reactor from now on.
+	///
+	/// @param[in] dev The device to read data from.
+	/// @param[in] decoder Decoder providing `feed(const char *, std::size_t)`.
+	/// @return The ID of the device.
+	/// @exception std::invalid_argument See `add`.
+	/// @exception std::runtime_error See `add`.
+	template <class Decoder>
+	std::size_t add_decoder(std::unique_ptr<device> && dev, Decoder && decoder)
+	{
+		// shared, because std::function requires copyable targets
+		auto d = std::make_shared<typename std::decay<Decoder>::type>(
+			std::forward<Decoder>(decoder));
+		return add(std::move(dev), [d](const char * data, std::size_t size) {
+			d->feed(data, size);
+		});
+	}
+
+	bool remove(std::size_t id);
+
+	/// Returns the number of registered devices.
+	std::size_t size() const noexcept
+	{
+		return channels_.size() - (dispatch_removed_ ? 1u : 0u);
+	}
+
+	/// Sets the handler for devices closed by the reactor.
+	void set_close_handler(close_handler handler) { on_close_ = std::move(handler); }
+
+	std::size_t run_once(int timeout_ms = -1);
+	void run();
+	void stop();
+
+private:
+	struct channel {
+		std::unique_ptr<device> dev;
+		data_handler handler;
+		int fd;
+	};
+
+	bool is_registered(std::size_t id) const;
+	void process(std::size_t id);
+	void finish_dispatch();
+	void close_channel(std::size_t id, bool notify);
+
+	int epfd_ = -1; ///< The epoll instance.
+	int evfd_ = -1; ///< Event to wake up the reactor, see `stop`.
+	bool stop_ = false;
+	std::size_t next_id_ = 1u;
+	std::size_t dispatching_ = 0u; ///< Device whose handler is running, 0 if none.
+	bool dispatch_removed_ = false; ///< Device was removed by its own handler.
+	std::map<std::size_t, channel> channels_;
+	close_handler on_close_;
+	std::vector<char> buffer_; ///< Read buffer, shared by all devices.
+};
+}
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "seatalk_decoder.hpp"
+#include <stdexcept>
+
+namespace marnav
+{
+namespace io
+{
+/// Initializes the decoder without message handler, messages are available
+/// through `get_message` only.
+seatalk_decoder::seatalk_decoder()
+{
+}
+
+/// Initializes the decoder.
+///
+/// @param[in] handler Handler for all complete messages.
+seatalk_decoder::seatalk_decoder(message_handler handler)
+	: handler_(std::move(handler))
+{
+}
+
+/// Returns \c true if the number of set bits is even.
+///
+/// The byte is folded to a nibble, the constant \c 0x6996 holds the parity
+/// of all 16 possible nibble values as bit mask (set bit: odd parity).
+bool seatalk_decoder::parity(uint8_t a) noexcept
+{
+	return ((0x6996u >> ((a ^ (a >> 4)) & 0x0f)) & 0x01u) == 0;
+}
+
+void seatalk_decoder::write_cmd(uint8_t c)
+{
+	if (remaining_ > 0 && remaining_ < 254) {
+		++collisions_;
+	}
+
+	data_[0] = c;
+	index_ = 1;
+	remaining_ = 254;
+}
+
+/// Writes data into the message buffer.
+void seatalk_decoder::write_data(uint8_t c)
+{
+	if (index_ >= sizeof(data_))
+		return;
+
+	if (remaining_ == 0)
+		return;
+
+	if (remaining_ == 255) // not yet in sync
+		return;
+
+	if (remaining_ == 254) {
+		// attribute byte, -1 because cmd is already consumed
+		remaining_ = 3 + (c & 0x0f) - 1;
+	}
+
+	data_[index_] = c;
+	++index_;
+	--remaining_;
+}
+
+/// Processes one byte of SeaTalk data.
+///
+/// This function contains a state machine, which does the handling
+/// of the SeaTalk specific feature: misusing the parity bit as
+/// indicator for command bytes.
+/// Since termios is in use, which provides parity error information
+/// as quoting bytes, a non-trivial implementation is needed to
+/// distinguish between normal and command bytes. Also, collision
+/// detection on this pseudo-bus (SeaTalk) is handled.
+///
+/// Read more about parity error marking here:
+///   http://www.gnu.org/software/libc/manual/html_node/Input-Modes.html
+///
+/// @param[in] raw The byte to process.
+/// @retval true  The byte completed a message, see `get_message`.
+/// @retval false The message is not complete yet.
+/// @exception std::runtime_error Bus read error.
+bool seatalk_decoder::process(uint8_t raw)
+{
+	switch (state_) {
+		case State::READ:
+			if (raw == 0xff) {
+				state_ = State::ESCAPE;
+			} else {
+				if (parity(raw)) {
+					write_cmd(raw);
+				} else {
+					write_data(raw);
+					return is_complete();
+				}
+			}
+			break;
+
+		case State::ESCAPE:
+			if (raw == 0x00) {
+				state_ = State::PARITY;
+			} else if (raw == 0xff) {
+				state_ = State::READ;
+				write_data(raw);
+				return is_complete();
+			} else {
+				throw std::runtime_error{"SeaTalk bus read error."};
+			}
+			break;
+
+		case State::PARITY:
+			state_ = State::READ;
+			if (parity(raw)) {
+				write_data(raw);
+				return is_complete();
+			} else {
+				write_cmd(raw);
+			}
+			break;
+	}
+	return false;
+}
+
+/// Processes the specified chunk of data, the message handler is called
+/// for every complete message.
+///
+/// @param[in] data The data to process.
+/// @param[in] size Number of bytes of the data.
+/// @exception std::runtime_error Bus read error.
+void seatalk_decoder::feed(const char * data, std::size_t size)
+{
+	if (!data)
+		return;
+	for (std::size_t i = 0; i < size; ++i) {
+		if (process(static_cast<uint8_t>(data[i])) && handler_)
+			handler_(get_message());
+	}
+}
+}
+}
@@ -0,0 +1,57 @@
+#ifndef MARNAV__IO__SEATALK_DECODER__HPP
+#define MARNAV__IO__SEATALK_DECODER__HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <marnav/seatalk/message.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Incremental decoder for SeaTalk data, read from a serial device.
+///
+/// The data is expected as delivered by a termios based serial device which marks
+/// parity errors (`PARMRK`), see `seatalk_reader` for details. This is the state
+/// machine of the `seatalk_reader`, without the device, which makes it possible
+/// to push data of any origin into it (e.g. from an event loop, see `reactor`).
+///
+/// The decoder synchronizes automatically with the SeaTalk bus and counts collisions.
+class seatalk_decoder
+{
+public:
+	/// Called for every complete message.
+	using message_handler = std::function<void(const seatalk::raw &)>;
+
+	seatalk_decoder();
+	explicit seatalk_decoder(message_handler handler);
+
+	void feed(const char * data, std::size_t size);
+	bool process(uint8_t raw);
+
+	/// Returns the last complete message. Valid after `process` returned true,
+	/// until the next call to `process` or `feed`.
+	seatalk::raw get_message() const { return seatalk::raw(data_, data_ + index_); }
+
+	uint32_t get_collisions() const noexcept { return collisions_; }
+
+private:
+	enum class State { READ, ESCAPE, PARITY };
+
+	static bool parity(uint8_t a) noexcept;
+	void write_cmd(uint8_t c);
+	void write_data(uint8_t c);
+	bool is_complete() const noexcept { return remaining_ == 0; }
+
+	message_handler handler_;
+	State state_ = State::READ;
+	uint8_t index_ = 0;
+	uint8_t remaining_ = 255; ///< Number of bytes remaining, 255: not in sync
+	uint8_t data_[seatalk::MAX_MESSAGE_SIZE] = {};
+	uint32_t collisions_ = 0;
+};
+}
+}
+
+#endif
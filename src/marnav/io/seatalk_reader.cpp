@@ -1,134 +1,48 @@
 #include "seatalk_reader.hpp"
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 namespace marnav
 {
 namespace io
 {
+constexpr std::size_t seatalk_reader::unbuffered;
+constexpr std::size_t seatalk_reader::default_buffer_size;
+
 seatalk_reader::~seatalk_reader()
 {
 }
 
-seatalk_reader::seatalk_reader(std::unique_ptr<device> && dv)
-	: dev_(std::move(dv))
+/// Initializes the reader.
+///
+/// @param[in] dv The device to read data from.
+/// @param[in] buffer_size Maximum number of bytes to read from the device at once.
+///   Values greater than seatalk_reader::unbuffered enable the buffered mode.
+/// @exception std::invalid_argument The buffer size is zero or exceeds the capabilities
+///   of the device interface.
+seatalk_reader::seatalk_reader(std::unique_ptr<device> && dv, std::size_t buffer_size)
+	: pos_(0)
+	, end_(0)
+	, dev_(std::move(dv))
 {
-	std::fill_n(reinterpret_cast<uint8_t *>(&ctx_), sizeof(ctx_), 0);
-
-	ctx_.state = State::READ;
-	ctx_.remaining = 255;
-	ctx_.index = 0;
+	if ((buffer_size == 0) || (buffer_size > std::numeric_limits<uint32_t>::max()))
+		throw std::invalid_argument{"invalid buffer size"};
+	buffer_.resize(buffer_size);
 }
 
+/// Closes the device. Buffered data, not yet processed, is discarded.
 void seatalk_reader::close()
 {
 	if (dev_)
 		dev_->close();
 	dev_.reset();
+	pos_ = 0;
+	end_ = 0;
 }
 
-uint8_t seatalk_reader::parity(uint8_t a) const
-{
-	int c = 0;
-
-	for (int i = 0; i < 8; ++i) {
-		if (a & 0x01)
-			++c;
-		a >>= 1;
-	}
-	return (c % 2) == 0;
-}
-
-void seatalk_reader::write_cmd(uint8_t c)
-{
-	if (ctx_.remaining > 0 && ctx_.remaining < 254) {
-		++ctx_.collisions;
-	}
-
-	ctx_.data[0] = c;
-	ctx_.index = 1;
-	ctx_.remaining = 254;
-}
-
-/// Writes data into the read context buffer.
-void seatalk_reader::write_data(uint8_t c)
-{
-	if (ctx_.index >= sizeof(ctx_.data))
-		return;
-
-	if (ctx_.remaining == 0)
-		return;
-
-	if (ctx_.remaining == 255) // not yet in sync
-		return;
-
-	if (ctx_.remaining == 254) {
-		// attribute byte, -1 because cmd is already consumed
-		ctx_.remaining = 3 + (c & 0x0f) - 1;
-	}
-
-	ctx_.data[ctx_.index] = c;
-	++ctx_.index;
-	--ctx_.remaining;
-}
-
-/// Processes SeaTalk data read from the device.
-///
-/// This function contains a state machine, which does the handling
-/// of the SeaTalk specific feature: misusing the parity bit as
-/// indicator for command bytes.
-/// Since termios is in use, which provides parity error information
-/// as quoting bytes, a non-trivial implementation is needed to
-/// distinguish between normal and command bytes. Also, collision
-/// detection on this pseudo-bus (SeaTalk) is handled.
-///
-/// Read more about parity error marking here:
-///   http://www.gnu.org/software/libc/manual/html_node/Input-Modes.html
-///
-/// @exception std::runtime_error Bus read error.
-void seatalk_reader::process_seatalk()
-{
-	switch (ctx_.state) {
-		case State::READ:
-			if (ctx_.raw == 0xff) {
-				ctx_.state = State::ESCAPE;
-			} else {
-				if (parity(ctx_.raw)) {
-					write_cmd(ctx_.raw);
-				} else {
-					write_data(ctx_.raw);
-					if (ctx_.remaining == 0)
-						emit_message();
-				}
-			}
-			break;
-
-		case State::ESCAPE:
-			if (ctx_.raw == 0x00) {
-				ctx_.state = State::PARITY;
-			} else if (ctx_.raw == 0xff) {
-				write_data(ctx_.raw);
-				if (ctx_.remaining == 0)
-					emit_message();
-				ctx_.state = State::READ;
-			} else {
-				throw std::runtime_error{"SeaTalk bus read error."};
-			}
-			break;
-
-		case State::PARITY:
-			if (parity(ctx_.raw)) {
-				write_data(ctx_.raw);
-				if (ctx_.remaining == 0)
-					emit_message();
-			} else {
-				write_cmd(ctx_.raw);
-			}
-			ctx_.state = State::READ;
-			break;
-	}
-}
-
-/// Reads data from the device.
+/// Reads data from the device into the internal buffer. Partial reads
+/// are accepted.
 ///
 /// @retval true  Success.
 /// @retval false End of file.
@@ -137,13 +51,16 @@ bool seatalk_reader::read_data()
 {
 	if (!dev_)
 		throw std::runtime_error{"device invalid"};
-	int rc = dev_->read(reinterpret_cast<char *>(&ctx_.raw), sizeof(ctx_.raw));
+	int rc = dev_->read(
+		reinterpret_cast<char *>(buffer_.data()), static_cast<uint32_t>(buffer_.size()));
 	if (rc == 0)
 		return false;
 	if (rc < 0)
 		throw std::runtime_error{"read error"};
-	if (rc != sizeof(ctx_.raw))
+	if (static_cast<std::size_t>(rc) > buffer_.size())
 		throw std::runtime_error{"read error"};
+	pos_ = 0;
+	end_ = static_cast<std::size_t>(rc);
 	return true;
 }
 
@@ -151,20 +68,26 @@ bool seatalk_reader::read_data()
 /// message was received the method process_message will be executed.
 /// This method automatcially synchronizes with the SeaTalk bus.
 ///
+/// In buffered mode, the buffered data is processed up to and including the
+/// end of the next complete message. The device is read only if there is
+/// no more buffered data.
+///
 /// @retval true  Success.
 /// @retval false End of file.
 /// @exception std::runtime_error Device or processing error.
 bool seatalk_reader::read()
 {
-	if (!read_data())
-		return false;
-	process_seatalk();
+	if (pos_ >= end_) {
+		if (!read_data())
+			return false;
+	}
+	while (pos_ < end_) {
+		if (decoder_.process(buffer_[pos_++])) {
+			process_message(decoder_.get_message());
+			break;
+		}
+	}
 	return true;
 }
-
-void seatalk_reader::emit_message()
-{
-	process_message(std::vector<uint8_t>{ctx_.data, ctx_.data + ctx_.index});
-}
 }
 }
@@ -1,7 +1,9 @@
 #ifndef MARNAV__IO__SEATALK_READER__HPP
 #define MARNAV__IO__SEATALK_READER__HPP
 
+#include <vector>
 #include <marnav/io/device.hpp>
+#include <marnav/io/seatalk_decoder.hpp>
 #include <marnav/seatalk/message.hpp>
 
 namespace marnav
@@ -13,14 +15,27 @@ namespace io
 ///
 /// In order to use this SeaTalk reader, it must be subclassed.
 ///
+/// By default, data is read from the device one byte at a time. If a buffer
+/// size greater than one is specified, data is read in chunks of up to the
+/// buffer size and processed from the internal buffer, see nmea_reader for
+/// the same concept. The device must support partial reads, see device::read.
+///
+/// The SeaTalk data is decoded by a seatalk_decoder.
+///
 /// @example read_seatalk.cpp
 class seatalk_reader
 {
 public:
+	/// Buffer size which reads one byte at a time from the device.
+	static constexpr std::size_t unbuffered = 1u;
+
+	/// Reasonable buffer size for buffered reads.
+	static constexpr std::size_t default_buffer_size = 256u;
+
 	virtual ~seatalk_reader();
 
 	seatalk_reader() = delete;
-	seatalk_reader(std::unique_ptr<device> &&);
+	seatalk_reader(std::unique_ptr<device> &&, std::size_t buffer_size = unbuffered);
 	seatalk_reader(const seatalk_reader &) = delete;
 	seatalk_reader(seatalk_reader &&) = default;
 
@@ -29,33 +44,18 @@ public:
 
 	void close();
 	bool read();
-	uint32_t get_collisions() const { return ctx_.collisions; }
+	uint32_t get_collisions() const { return decoder_.get_collisions(); }
 
 protected:
 	virtual void process_message(const seatalk::raw &) = 0;
 
 private:
-	enum class State { READ, ESCAPE, PARITY };
-
-	struct context {
-		State state;
-		uint8_t index;
-		uint8_t remaining;
-		uint8_t data[seatalk::MAX_MESSAGE_SIZE];
-
-		uint8_t raw;
-		uint32_t collisions;
-	};
-
-	void emit_message();
-
-	uint8_t parity(uint8_t a) const;
-	void write_cmd(uint8_t c);
-	void write_data(uint8_t c);
-	void process_seatalk();
 	bool read_data();
 
-	context ctx_;
+	seatalk_decoder decoder_;
+	std::vector<uint8_t> buffer_; ///< Data read from the device, not yet processed.
+	std::size_t pos_; ///< Position of the next byte to process within the buffer.
+	std::size_t end_; ///< End of valid data within the buffer.
 	std::unique_ptr<device> dev_; ///< Device to read data from.
 };
 }
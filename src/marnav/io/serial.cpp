@@ -5,6 +5,11 @@
 #include <fcntl.h>
 #include <termios.h>
 #include <unistd.h>
+#include <marnav/utils/unused.hpp>
+#if defined(__linux__)
+	#include <linux/serial.h>
+	#include <sys/ioctl.h>
+#endif
 
 namespace marnav
 {
@@ -104,6 +109,21 @@ static tcflag_t get_parity_iflag(serial::parity par)
 	}
 	return 0;
 }
+
+/// Sets the low latency flag of the driver. Not all drivers support this
+/// (e.g. pseudo terminals), errors are therefore ignored.
+static void set_low_latency(int fd)
+{
+#if defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+	struct serial_struct ser;
+	if (::ioctl(fd, TIOCGSERIAL, &ser) < 0)
+		return;
+	ser.flags |= ASYNC_LOW_LATENCY;
+	::ioctl(fd, TIOCSSERIAL, &ser);
+#else
+	utils::unused(fd);
+#endif
+}
 }
 /// @endcond
 
@@ -122,7 +142,29 @@ serial::serial(const std::string & dv, baud b, databits d, stopbits s, parity p)
 {
 }
 
-/// Opens a serial device.
+/// Sets the number of bytes and the inter-byte timeout for reads in blocking mode
+/// (termios `VMIN` and `VTIME`). Has no effect in non-blocking mode.
+///
+/// - `min_bytes > 0`, `timeout_ds == 0`: a read returns when at least `min_bytes`
+///   bytes are available.
+/// - `min_bytes > 0`, `timeout_ds > 0`: a read returns when at least `min_bytes`
+///   bytes are available or the timeout expired after the first received byte.
+/// - `min_bytes == 0`, `timeout_ds > 0`: a read returns when at least one byte
+///   is available or the timeout expired, \c 0 in the latter case.
+/// - `min_bytes == 0`, `timeout_ds == 0`: a read returns immediately.
+///
+/// A read never returns more bytes than the buffer size. The default is one byte,
+/// without timeout.
+///
+/// @param[in] min_bytes Minimum number of bytes to read.
+/// @param[in] timeout_ds Timeout in tenths of a second.
+void serial::set_batching(uint8_t min_bytes, uint8_t timeout_ds) noexcept
+{
+	min_bytes_ = min_bytes;
+	timeout_ds_ = timeout_ds;
+}
+
+/// Opens a serial device, with the mode, batching and latency settings.
 void serial::open()
 {
 	termios old_tio;
@@ -131,7 +173,8 @@ void serial::open()
 	if (fd >= 0)
 		return;
 
-	fd = ::open(dev_.c_str(), O_RDWR | O_NOCTTY);
+	const int flags = (mode_ == mode::non_blocking) ? O_NONBLOCK : 0;
+	fd = ::open(dev_.c_str(), O_RDWR | O_NOCTTY | flags);
 	if (fd < 0)
 		throw std::runtime_error{"unable to open device: " + dev_};
 
@@ -146,11 +189,14 @@ void serial::open()
 	new_tio.c_oflag = 0;
 	new_tio.c_lflag = 0;
 
-	new_tio.c_cc[VMIN] = 1;
-	new_tio.c_cc[VTIME] = 0;
+	new_tio.c_cc[VMIN] = min_bytes_;
+	new_tio.c_cc[VTIME] = timeout_ds_;
 
 	tcflush(fd, TCIFLUSH);
 	tcsetattr(fd, TCSANOW, &new_tio);
+
+	if (low_latency_)
+		detail::set_low_latency(fd);
 }
 
 /// Closes the device, specified by the device handling structure.
@@ -167,7 +213,8 @@ void serial::close()
 ///
 /// @param[out] buffer The buffer to hold the data.
 /// @param[in] size The size of the buffer in bytes.
-/// @return Number of read bytes (might be 0).
+/// @return Number of read bytes (might be 0). In non-blocking mode \c -1 with
+///   `errno` set to `EAGAIN`, if there is no data available.
 /// @exception std::invalid_argument
 /// @exception std::runtime_error
 int serial::read(char * buffer, uint32_t size)
@@ -194,5 +241,21 @@ int serial::write(const char * buffer, uint32_t size)
 		throw std::runtime_error{"device not open"};
 	return ::write(fd, buffer, size);
 }
+
+/// Writes the data of the buffers to the serial line, see `gather_writable`.
+///
+/// @param[in] iov The buffers to write.
+/// @param[in] count Number of buffers.
+/// @return Number of written bytes.
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int serial::write_gather(const struct iovec * iov, int count)
+{
+	if ((iov == nullptr) || (count <= 0))
+		throw std::invalid_argument{"invalid buffers"};
+	if (fd < 0)
+		throw std::runtime_error{"device not open"};
+	return static_cast<int>(::writev(fd, iov, count));
+}
 }
 }
@@ -1,8 +1,11 @@
 #ifndef MARNAV__IO__SERIAL__HPP
 #define MARNAV__IO__SERIAL__HPP
 
+#include <cstdint>
 #include <string>
 #include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
 
 namespace marnav
 {
@@ -12,7 +15,21 @@ namespace io
 /// communication.
 ///
 /// Since this is termios based, it is platform dependent.
-class serial : public device
+///
+/// By default, the device is opened in blocking mode and a read returns as soon
+/// as one byte is available. The following settings make it possible to trade
+/// the number of system calls against latency, per device. They must be set
+/// before the device is opened.
+///
+/// - `set_mode`: non-blocking mode, to use the device with readiness polling
+///   (`select`, `poll`, `epoll`, see `reactor`). A read returns immediately,
+///   \c -1 with `errno` set to `EAGAIN` if there is no data available.
+/// - `set_batching`: in blocking mode, a read returns when the specified number
+///   of bytes is available or the line was idle for the specified time
+///   (termios `VMIN` and `VTIME`).
+/// - `set_low_latency`: requests the driver to pass received data on without
+///   delay (Linux only, if supported by the driver).
+class serial : public device, public selectable, public gather_writable
 {
 public:
 	enum class baud {
@@ -35,6 +52,8 @@ public:
 
 	enum class parity { none, even, odd, mark };
 
+	enum class mode { blocking, non_blocking };
+
 	virtual ~serial();
 
 	serial() = delete;
@@ -48,6 +67,17 @@ public:
 	virtual void close() override;
 	virtual int read(char * buffer, uint32_t size) override;
 	virtual int write(const char * buffer, uint32_t size) override;
+	virtual int get_fd() const override { return fd; }
+	virtual int write_gather(const struct iovec * iov, int count) override;
+
+	void set_mode(mode m) noexcept { mode_ = m; }
+	void set_batching(uint8_t min_bytes, uint8_t timeout_ds) noexcept;
+	void set_low_latency(bool enable) noexcept { low_latency_ = enable; }
+
+	mode get_mode() const noexcept { return mode_; }
+	uint8_t get_min_bytes() const noexcept { return min_bytes_; }
+	uint8_t get_timeout_ds() const noexcept { return timeout_ds_; }
+	bool get_low_latency() const noexcept { return low_latency_; }
 
 protected:
 	int fd; ///< File descriptor for serial device communication.
@@ -58,6 +88,10 @@ private:
 	databits data_bits_;
 	stopbits stop_bits_;
 	parity par_;
+	mode mode_ = mode::blocking;
+	uint8_t min_bytes_ = 1; ///< termios VMIN
+	uint8_t timeout_ds_ = 0; ///< termios VTIME, in tenths of a second
+	bool low_latency_ = false;
 };
 }
 }
@@ -0,0 +1,119 @@
+#include "tcp_client.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <marnav/io/detail.hpp>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+tcp_client::~tcp_client()
+{
+	close();
+}
+
+/// Initializes the device, the connection is not established yet.
+///
+/// @param[in] host Name or address of the server.
+/// @param[in] port Port of the server.
+tcp_client::tcp_client(const std::string & host, uint16_t port)
+	: host_(host)
+	, port_(port)
+{
+}
+
+/// Connects to the server.
+///
+/// @exception std::runtime_error Unable to connect.
+void tcp_client::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	fd_ = detail::connect_socket(host_, port_, SOCK_STREAM);
+
+	if (no_delay_) {
+		const int on = 1;
+		::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	}
+}
+
+/// Closes the connection.
+void tcp_client::close()
+{
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+}
+
+/// Reads the available data, up to the size of the buffer.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of read bytes, \c 0 if the connection was closed by the server.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The device is not open.
+int tcp_client::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	size = std::min(size, static_cast<uint32_t>(std::numeric_limits<int>::max()));
+	return static_cast<int>(::recv(fd_, buffer, size, 0));
+}
+
+/// Sends all data to the server.
+///
+/// @param[in] buffer The data to send.
+/// @param[in] size Number of bytes to send.
+/// @return Number of bytes sent.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The device is not open or the connection is broken.
+int tcp_client::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	size = std::min(size, static_cast<uint32_t>(std::numeric_limits<int>::max()));
+	if (!detail::send_all(fd_, buffer, size))
+		throw std::runtime_error{"unable to send data"};
+	return static_cast<int>(size);
+}
+
+/// Sends the data of the buffers to the server, see `gather_writable`.
+///
+/// Unlike `write`, this function does not wait if the connection is congested
+/// and the socket is in non-blocking mode: the data may be sent partially, or
+/// not at all (`EAGAIN`). Interrupted system calls are repeated.
+///
+/// @param[in] iov The buffers to send.
+/// @param[in] count Number of buffers.
+/// @return Number of bytes sent, negative on errors (see `errno`).
+/// @exception std::invalid_argument Invalid buffers.
+/// @exception std::runtime_error The device is not open.
+int tcp_client::write_gather(const struct iovec * iov, int count)
+{
+	if ((iov == nullptr) || (count <= 0))
+		throw std::invalid_argument{"invalid buffers"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+
+	struct msghdr msg = {};
+	msg.msg_iov = const_cast<struct iovec *>(iov);
+	msg.msg_iovlen = static_cast<std::size_t>(count);
+	for (;;) {
+		const auto rc = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+		if ((rc >= 0) || (errno != EINTR))
+			return static_cast<int>(rc);
+	}
+}
+}
+}
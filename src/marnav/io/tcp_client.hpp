@@ -0,0 +1,59 @@
+#ifndef MARNAV__IO__TCP_CLIENT__HPP
+#define MARNAV__IO__TCP_CLIENT__HPP
+
+#include <cstdint>
+#include <string>
+#include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief TCP connection to a server, e.g. a NMEA server on the network.
+///
+/// A read returns as soon as data is available, up to the size of the buffer.
+/// Readers with large buffers therefore receive as much data as possible per
+/// system call. A write sends all data, it waits if the connection is congested
+/// (also if the socket was set to non-blocking mode, e.g. by a `reactor`).
+/// A gather write (see `gather_writable`) does not wait in non-blocking mode.
+///
+/// Example:
+/// @code
+///   io::default_nmea_reader reader{utils::make_unique<io::tcp_client>("10.0.0.1", 10110),
+///       io::nmea_reader::default_buffer_size};
+/// @endcode
+class tcp_client : public device, public selectable, public gather_writable
+{
+public:
+	virtual ~tcp_client();
+
+	tcp_client() = delete;
+	tcp_client(const std::string & host, uint16_t port);
+	tcp_client(const tcp_client &) = delete;
+	tcp_client(tcp_client &&) = delete;
+	tcp_client & operator=(const tcp_client &) = delete;
+	tcp_client & operator=(tcp_client &&) = delete;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+	virtual int get_fd() const override { return fd_; }
+	virtual int write_gather(const struct iovec * iov, int count) override;
+
+	/// Disables the Nagle algorithm, every write is sent immediately.
+	/// Must be set before the device is opened.
+	void set_no_delay(bool enable) noexcept { no_delay_ = enable; }
+
+private:
+	std::string host_;
+	uint16_t port_;
+	bool no_delay_ = false;
+	int fd_ = -1;
+};
+}
+}
+
+#endif
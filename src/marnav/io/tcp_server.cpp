@@ -0,0 +1,299 @@
+#include "tcp_server.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <limits>
+#include <stdexcept>
+#include <marnav/io/detail.hpp>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t tcp_server::default_queue_limit;
+
+namespace
+{
+/// Maximum number of pending connections.
+constexpr int backlog = 16;
+}
+
+tcp_server::~tcp_server()
+{
+	close();
+}
+
+/// Initializes the server, it does not listen yet.
+///
+/// @param[in] port The port to listen on, \c 0 for any free port (see `get_port`).
+/// @param[in] address The local address to listen on, empty for all.
+tcp_server::tcp_server(uint16_t port, const std::string & address)
+	: address_(address)
+	, port_(port)
+{
+}
+
+/// Starts listening for connections.
+///
+/// @exception std::runtime_error Unable to bind or listen.
+void tcp_server::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	const int fd = detail::bind_socket(address_, port_, SOCK_STREAM);
+	if (::listen(fd, backlog) < 0) {
+		::close(fd);
+		throw std::runtime_error{"unable to listen on port: " + std::to_string(port_)};
+	}
+	try {
+		detail::set_non_blocking(fd);
+	} catch (...) {
+		::close(fd);
+		throw;
+	}
+	fd_ = fd;
+}
+
+/// Disconnects all clients and stops listening. Queued data is discarded.
+void tcp_server::close()
+{
+	for (const auto & c : clients_)
+		::close(c.fd);
+	clients_.clear();
+
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+}
+
+/// Returns the port the server listens on.
+///
+/// @exception std::runtime_error The device is not open.
+uint16_t tcp_server::get_port() const
+{
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	return detail::get_local_port(fd_);
+}
+
+/// Accepts all pending connections, does not wait for new ones.
+///
+/// @return Number of accepted connections.
+/// @exception std::runtime_error The device is not open.
+std::size_t tcp_server::accept()
+{
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+
+	std::size_t n = 0u;
+	for (;;) {
+		const int fd = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+		if (fd < 0) {
+			if (errno == EINTR)
+				continue;
+			break; // EAGAIN or an aborted connection
+		}
+		::shutdown(fd, SHUT_RD); // data of clients is ignored
+		clients_.push_back(client{fd, {}, 0u, false});
+		++n;
+	}
+	return n;
+}
+
+/// Not supported, the server is write only.
+///
+/// @exception std::runtime_error Always.
+int tcp_server::read(char *, uint32_t)
+{
+	throw std::runtime_error{"operation not supported"};
+}
+
+/// Sends the data to all connected clients, see class description.
+///
+/// @param[in] buffer The data to send.
+/// @param[in] size Number of bytes to send.
+/// @return Number of bytes written, also if there are no clients.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The device is not open.
+int tcp_server::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+
+	struct iovec iov;
+	iov.iov_base = const_cast<char *>(buffer);
+	iov.iov_len = std::min(size, static_cast<uint32_t>(std::numeric_limits<int>::max()));
+	return write_gather(&iov, 1);
+}
+
+/// Sends the data of the buffers to all connected clients, see class description.
+/// The buffers are treated as one write.
+///
+/// @param[in] iov The buffers to send.
+/// @param[in] count Number of buffers.
+/// @return Number of bytes written, also if there are no clients.
+/// @exception std::invalid_argument Invalid buffers or total size.
+/// @exception std::runtime_error The device is not open.
+int tcp_server::write_gather(const struct iovec * iov, int count)
+{
+	if ((iov == nullptr) || (count <= 0))
+		throw std::invalid_argument{"invalid buffers"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+
+	std::size_t size = 0u;
+	for (int i = 0; i < count; ++i)
+		size += iov[i].iov_len;
+	if (size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		throw std::invalid_argument{"invalid size"};
+
+	accept();
+	for (auto & c : clients_)
+		send_to(c, iov, count, size);
+	remove_failed_clients();
+	return static_cast<int>(size);
+}
+
+/// Sends queued data to the clients, does not wait.
+///
+/// @retval true  All queues are empty.
+/// @retval false There is still data queued.
+bool tcp_server::flush()
+{
+	bool empty = true;
+	for (auto & c : clients_) {
+		if (!send_queue(c))
+			continue;
+		empty = empty && c.queue.empty();
+	}
+	remove_failed_clients();
+	return empty;
+}
+
+/// Sends the queued data of the client, as much as possible without waiting.
+///
+/// @retval true  Success.
+/// @retval false Error, the client is marked as failed.
+bool tcp_server::send_queue(client & c)
+{
+	while (c.offset < c.queue.size()) {
+		const auto rc = ::send(c.fd, c.queue.data() + c.offset, c.queue.size() - c.offset,
+			MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+				return true;
+			c.failed = true;
+			return false;
+		}
+		c.offset += static_cast<std::size_t>(rc);
+	}
+	c.queue.clear();
+	c.offset = 0u;
+	return true;
+}
+
+/// Sends the queued data of the client, followed by the new data, with one
+/// system call. The rest is queued or subject to the overflow policy.
+void tcp_server::send_to(client & c, const struct iovec * iov, int count, std::size_t size)
+{
+	if (c.failed)
+		return;
+
+	const std::size_t pending = c.queue.size() - c.offset;
+
+	iov_.clear();
+	if (pending > 0u) {
+		struct iovec q;
+		q.iov_base = c.queue.data() + c.offset;
+		q.iov_len = pending;
+		iov_.push_back(q);
+	}
+	iov_.insert(iov_.end(), iov, iov + count);
+
+	struct msghdr msg = {};
+	msg.msg_iov = iov_.data();
+	msg.msg_iovlen = std::min(iov_.size(), static_cast<std::size_t>(IOV_MAX)); // rest is queued
+
+	ssize_t rc;
+	do {
+		rc = ::sendmsg(c.fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+	} while ((rc < 0) && (errno == EINTR));
+
+	if (rc < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			c.failed = true;
+			return;
+		}
+		rc = 0;
+	}
+
+	// consume the sent data, queued data first
+	std::size_t n = static_cast<std::size_t>(rc);
+	const std::size_t from_queue = std::min(n, pending);
+	c.offset += from_queue;
+	n -= from_queue;
+	if (c.offset == c.queue.size()) {
+		c.queue.clear();
+		c.offset = 0u;
+	}
+	if (n == size)
+		return;
+
+	// the write was not even started, apply the overflow policy
+	if ((n == 0u) && ((c.queue.size() - c.offset) + size > queue_limit_)) {
+		switch (policy_) {
+			case overflow_policy::drop:
+				++dropped_;
+				return;
+			case overflow_policy::disconnect:
+				c.failed = true;
+				return;
+			case overflow_policy::block: {
+				bool ok = detail::send_all(
+					c.fd, c.queue.data() + c.offset, c.queue.size() - c.offset);
+				for (int i = 0; ok && (i < count); ++i)
+					ok = detail::send_all(
+						c.fd, static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+				c.failed = !ok;
+				c.queue.clear();
+				c.offset = 0u;
+				return;
+			}
+		}
+	}
+
+	// queue the rest
+	if (c.offset > 0u) {
+		c.queue.erase(c.queue.begin(), c.queue.begin() + static_cast<std::ptrdiff_t>(c.offset));
+		c.offset = 0u;
+	}
+	for (int i = 0; i < count; ++i) {
+		const char * p = static_cast<const char *>(iov[i].iov_base);
+		std::size_t len = iov[i].iov_len;
+		if (n >= len) {
+			n -= len;
+			continue;
+		}
+		c.queue.insert(c.queue.end(), p + n, p + len);
+		n = 0u;
+	}
+}
+
+void tcp_server::remove_failed_clients()
+{
+	for (const auto & c : clients_)
+		if (c.failed)
+			::close(c.fd);
+	clients_.erase(std::remove_if(clients_.begin(), clients_.end(),
+					   [](const client & c) { return c.failed; }),
+		clients_.end());
+}
+}
+}
@@ -0,0 +1,102 @@
+#ifndef MARNAV__IO__TCP_SERVER__HPP
+#define MARNAV__IO__TCP_SERVER__HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief TCP server, sending data to all connected clients (fan-out).
+///
+/// Data written to the server is sent to every connected client. Data sent
+/// by the clients is ignored, the server is a write only device.
+///
+/// New connections are accepted by `accept`, which is called by every write.
+/// To accept clients between writes, call it whenever the file descriptor of
+/// the server (see `get_fd`) becomes readable, or periodically.
+///
+/// Writes never wait for slow clients. Data which cannot be sent immediately is
+/// queued per client and sent together with the next write (or by `flush`),
+/// which batches small writes to slow clients into few system calls. If the
+/// queue of a client would exceed its limit, the overflow policy applies:
+///
+/// - `overflow_policy::drop`: the data of the write is dropped for this client.
+///   Writes are dropped as a whole, a client never receives partial data of a write.
+/// - `overflow_policy::disconnect`: the client is disconnected.
+/// - `overflow_policy::block`: the write waits until the client received the
+///   queued data (backpressure). This blocks all other clients as well.
+///
+/// Clients which closed their connection are removed on the next write.
+class tcp_server : public device, public selectable, public gather_writable
+{
+public:
+	enum class overflow_policy { drop, disconnect, block };
+
+	/// Default limit of data queued per client.
+	static constexpr std::size_t default_queue_limit = 64u * 1024u;
+
+	virtual ~tcp_server();
+
+	tcp_server() = delete;
+	explicit tcp_server(uint16_t port, const std::string & address = std::string{});
+	tcp_server(const tcp_server &) = delete;
+	tcp_server(tcp_server &&) = delete;
+	tcp_server & operator=(const tcp_server &) = delete;
+	tcp_server & operator=(tcp_server &&) = delete;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+	virtual int get_fd() const override { return fd_; }
+	virtual int write_gather(const struct iovec * iov, int count) override;
+
+	std::size_t accept();
+	bool flush();
+
+	/// Returns the number of connected clients.
+	std::size_t get_num_clients() const noexcept { return clients_.size(); }
+
+	/// Returns the number of writes dropped for clients, see `overflow_policy::drop`.
+	uint64_t get_num_dropped() const noexcept { return dropped_; }
+
+	uint16_t get_port() const;
+
+	void set_overflow_policy(overflow_policy policy) noexcept { policy_ = policy; }
+	void set_queue_limit(std::size_t limit) noexcept { queue_limit_ = limit; }
+
+	overflow_policy get_overflow_policy() const noexcept { return policy_; }
+	std::size_t get_queue_limit() const noexcept { return queue_limit_; }
+
+private:
+	struct client {
+		int fd;
+		std::vector<char> queue; ///< Data not yet sent.
+		std::size_t offset; ///< Number of bytes of the queue already sent.
+		bool failed;
+	};
+
+	void send_to(client & c, const struct iovec * iov, int count, std::size_t size);
+	bool send_queue(client & c);
+	void remove_failed_clients();
+
+	std::string address_;
+	uint16_t port_;
+	overflow_policy policy_ = overflow_policy::drop;
+	std::size_t queue_limit_ = default_queue_limit;
+	int fd_ = -1;
+	std::vector<client> clients_;
+	uint64_t dropped_ = 0u;
+	std::vector<struct iovec> iov_; ///< Buffers to send, reused for all writes.
+};
+}
+}
+
+#endif
@@ -0,0 +1,317 @@
+#include "udp_device.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <marnav/io/detail.hpp>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr uint16_t udp_device::default_port;
+constexpr std::size_t udp_device::default_max_datagram_size;
+
+namespace
+{
+/// Maximum number of datagrams received or sent with one system call.
+constexpr std::size_t max_batch = 64u;
+
+struct in_addr make_address(const std::string & address)
+{
+	struct in_addr addr = {};
+	if (::inet_pton(AF_INET, address.c_str(), &addr) != 1)
+		throw std::invalid_argument{"invalid IPv4 address: " + address};
+	return addr;
+}
+
+/// Resolves the host name or address to an IPv4 address.
+struct in_addr resolve(const std::string & host)
+{
+	struct addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	struct addrinfo * info = nullptr;
+	if ((::getaddrinfo(host.c_str(), nullptr, &hints, &info) != 0) || !info)
+		throw std::runtime_error{"unable to resolve address: " + host};
+	const auto addr = reinterpret_cast<const struct sockaddr_in *>(info->ai_addr)->sin_addr;
+	::freeaddrinfo(info);
+	return addr;
+}
+}
+
+udp_device::~udp_device()
+{
+	close();
+}
+
+/// Initializes the device, the socket is not created yet.
+///
+/// @param[in] port The local port to receive datagrams on, \c 0 for any free port
+///   (see `get_port`), e.g. if the device is used for sending only.
+udp_device::udp_device(uint16_t port)
+	: port_(port)
+{
+}
+
+/// Sets the destination of written datagrams.
+///
+/// @param[in] host Name or address of the destination, may be a broadcast address
+///   (see `set_broadcast`) or a multicast group.
+/// @param[in] port Port of the destination.
+/// @exception std::invalid_argument The host is empty or the port is zero.
+void udp_device::set_destination(const std::string & host, uint16_t port)
+{
+	if (host.empty() || (port == 0u))
+		throw std::invalid_argument{"invalid destination"};
+	dest_host_ = host;
+	dest_port_ = port;
+}
+
+/// Joins the multicast group on the multicast interface, see `set_multicast_interface`.
+/// May be called multiple times, for multiple groups.
+///
+/// @param[in] group Address of the multicast group.
+/// @exception std::invalid_argument The address is not a multicast address.
+void udp_device::join_multicast(const std::string & group)
+{
+	if ((ntohl(make_address(group).s_addr) & 0xf0000000u) != 0xe0000000u)
+		throw std::invalid_argument{"not a multicast address: " + group};
+	groups_.push_back(group);
+}
+
+/// Sets the local interface to receive and send multicast datagrams, by its address.
+/// The system chooses the interface by default.
+///
+/// @param[in] address Address of the interface, empty for the default.
+/// @exception std::invalid_argument Invalid address.
+void udp_device::set_multicast_interface(const std::string & address)
+{
+	if (!address.empty())
+		make_address(address);
+	interface_ = address;
+}
+
+/// Sets the maximum size of datagrams to receive.
+///
+/// @param[in] size The maximum size in bytes.
+/// @exception std::invalid_argument The size is zero.
+void udp_device::set_max_datagram_size(std::size_t size)
+{
+	if (size == 0u)
+		throw std::invalid_argument{"invalid datagram size"};
+	max_datagram_size_ = size;
+}
+
+/// Creates the socket, binds it to the local port and joins the multicast groups.
+///
+/// @exception std::runtime_error Unable to create or to set up the socket.
+void udp_device::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	fd_ = detail::bind_socket("0.0.0.0", port_, SOCK_DGRAM);
+	try {
+		setup();
+	} catch (...) {
+		close();
+		throw;
+	}
+}
+
+void udp_device::setup()
+{
+	if (broadcast_) {
+		const int on = 1;
+		if (::setsockopt(fd_, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on)) < 0)
+			throw std::runtime_error{"unable to enable broadcast"};
+	}
+
+	struct in_addr iface = {}; // any
+	if (!interface_.empty()) {
+		iface = make_address(interface_);
+		if (::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) < 0)
+			throw std::runtime_error{"unable to set multicast interface: " + interface_};
+	}
+
+	for (const auto & group : groups_) {
+		struct ip_mreq mreq = {};
+		mreq.imr_multiaddr = make_address(group);
+		mreq.imr_interface = iface;
+		if (::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+			throw std::runtime_error{"unable to join multicast group: " + group};
+	}
+
+	if (!dest_host_.empty())
+		dest_addr_ = resolve(dest_host_).s_addr;
+}
+
+/// Closes the socket, leaves all multicast groups.
+void udp_device::close()
+{
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+}
+
+/// Returns the local port.
+///
+/// @exception std::runtime_error The device is not open.
+uint16_t udp_device::get_port() const
+{
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	return detail::get_local_port(fd_);
+}
+
+/// Receives the available datagrams, as many as fit into the buffer, see class
+/// description. Waits for the first datagram if the socket is blocking.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of bytes received. In non-blocking mode \c -1 with `errno` set
+///   to `EAGAIN`, if there is no data available.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The device is not open.
+int udp_device::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	size = std::min(size, static_cast<uint32_t>(std::numeric_limits<int>::max()));
+
+	// the buffer is split into slots of the maximum datagram size, at least one
+	const std::size_t slot = std::min(max_datagram_size_, static_cast<std::size_t>(size));
+	const std::size_t n = std::min(max_batch, size / slot);
+
+	struct iovec iov[max_batch];
+	struct mmsghdr msgs[max_batch];
+	std::memset(msgs, 0, sizeof(msgs[0]) * n);
+	for (std::size_t i = 0; i < n; ++i) {
+		iov[i].iov_base = buffer + i * slot;
+		iov[i].iov_len = slot;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	for (;;) {
+		const int rc = ::recvmmsg(fd_, msgs, static_cast<unsigned int>(n), MSG_WAITFORONE,
+			nullptr);
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+
+		// concatenate the datagrams, drop truncated ones
+		std::size_t total = 0u;
+		for (int i = 0; i < rc; ++i) {
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+				continue;
+			const std::size_t len = msgs[i].msg_len;
+			if (total != static_cast<std::size_t>(i) * slot)
+				std::memmove(buffer + total, buffer + i * slot, len);
+			total += len;
+		}
+		if (total > 0u)
+			return static_cast<int>(total);
+	}
+}
+
+/// Sends the data as one datagram to the destination.
+///
+/// @param[in] buffer The data to send.
+/// @param[in] size Number of bytes to send.
+/// @return Number of bytes sent.
+/// @exception std::invalid_argument Invalid buffer or size.
+/// @exception std::runtime_error The device is not open, there is no destination
+///   or the datagram could not be sent.
+int udp_device::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	if (dest_host_.empty())
+		throw std::runtime_error{"no destination"};
+
+	struct sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(dest_port_);
+	addr.sin_addr.s_addr = dest_addr_;
+
+	for (;;) {
+		const auto rc = ::sendto(fd_, buffer, size, MSG_NOSIGNAL,
+			reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr));
+		if (rc >= 0)
+			return static_cast<int>(rc);
+		if (errno == EINTR)
+			continue;
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+			if (detail::wait_writable(fd_))
+				continue;
+		}
+		throw std::runtime_error{"unable to send datagram"};
+	}
+}
+
+/// Sends the data of every buffer as a datagram of its own to the destination,
+/// up to 64 datagrams with one system call (`sendmmsg`).
+///
+/// Unlike `write`, this function does not wait if the socket is in non-blocking
+/// mode and the datagrams cannot be sent immediately: only some of the buffers
+/// may be sent, or none at all (`EAGAIN`). Buffers are never sent partially.
+/// Interrupted system calls are repeated.
+///
+/// @param[in] iov The buffers to send.
+/// @param[in] count Number of buffers.
+/// @return Number of bytes sent, negative on errors (see `errno`).
+/// @exception std::invalid_argument Invalid buffers.
+/// @exception std::runtime_error The device is not open or there is no destination.
+int udp_device::write_gather(const struct iovec * iov, int count)
+{
+	if ((iov == nullptr) || (count <= 0))
+		throw std::invalid_argument{"invalid buffers"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	if (dest_host_.empty())
+		throw std::runtime_error{"no destination"};
+
+	struct sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(dest_port_);
+	addr.sin_addr.s_addr = dest_addr_;
+
+	const auto n = std::min(static_cast<std::size_t>(count), max_batch);
+	struct mmsghdr msgs[max_batch];
+	std::memset(msgs, 0, n * sizeof(msgs[0]));
+	for (std::size_t i = 0; i < n; ++i) {
+		msgs[i].msg_hdr.msg_name = &addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+		msgs[i].msg_hdr.msg_iov = const_cast<struct iovec *>(iov + i);
+		msgs[i].msg_hdr.msg_iovlen = 1u;
+	}
+
+	int rc;
+	do {
+		rc = ::sendmmsg(fd_, msgs, static_cast<unsigned int>(n), MSG_NOSIGNAL);
+	} while ((rc < 0) && (errno == EINTR));
+	if (rc < 0)
+		return -1;
+
+	std::size_t total = 0u;
+	for (int i = 0; i < rc; ++i)
+		total += iov[i].iov_len;
+	return static_cast<int>(total);
+}
+}
+}
@@ -0,0 +1,88 @@
+#ifndef MARNAV__IO__UDP_DEVICE__HPP
+#define MARNAV__IO__UDP_DEVICE__HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief UDP device, e.g. for NMEA over UDP.
+///
+/// Receives datagrams sent to the local port, including multicast groups joined,
+/// and sends datagrams to the destination, if set. Supports IPv4 only.
+///
+/// A read receives as many datagrams as are available and fit into the buffer with
+/// one system call, the datagrams are concatenated. Datagrams must end at sentence
+/// boundaries for this to work, which is the case for NMEA over UDP. The buffer must
+/// be at least as large as the maximum datagram size (see `set_max_datagram_size`).
+/// Larger datagrams are truncated by the system and are dropped.
+///
+/// A write sends one datagram. A gather write (see `gather_writable`) sends every
+/// buffer as a datagram of its own, which makes it possible to send multiple
+/// sentences, one per datagram as usual for NMEA over UDP, with one system call.
+///
+/// Example: receive NMEA from the network
+/// @code
+///   auto dev = utils::make_unique<io::udp_device>(io::udp_device::default_port);
+///   dev->join_multicast("239.192.0.1");
+///   io::default_nmea_reader reader{std::move(dev), io::nmea_reader::default_buffer_size};
+/// @endcode
+class udp_device : public device, public selectable, public gather_writable
+{
+public:
+	/// Common port for NMEA over UDP.
+	static constexpr uint16_t default_port = 10110u;
+
+	/// Default maximum size of received datagrams.
+	static constexpr std::size_t default_max_datagram_size = 2048u;
+
+	virtual ~udp_device();
+
+	explicit udp_device(uint16_t port = default_port);
+	udp_device(const udp_device &) = delete;
+	udp_device(udp_device &&) = delete;
+	udp_device & operator=(const udp_device &) = delete;
+	udp_device & operator=(udp_device &&) = delete;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+	virtual int get_fd() const override { return fd_; }
+	virtual int write_gather(const struct iovec * iov, int count) override;
+
+	uint16_t get_port() const;
+
+	/// @{
+	/// Settings, to be set before the device is opened.
+	void set_destination(const std::string & host, uint16_t port);
+	void set_broadcast(bool enable) noexcept { broadcast_ = enable; }
+	void join_multicast(const std::string & group);
+	void set_multicast_interface(const std::string & address);
+	void set_max_datagram_size(std::size_t size);
+	/// @}
+
+private:
+	void setup();
+
+	uint16_t port_;
+	std::string dest_host_;
+	uint16_t dest_port_ = 0u;
+	bool broadcast_ = false;
+	std::vector<std::string> groups_;
+	std::string interface_;
+	std::size_t max_datagram_size_ = default_max_datagram_size;
+	int fd_ = -1;
+	uint32_t dest_addr_ = 0u; ///< Resolved destination, network byte order.
+};
+}
+}
+
+#endif
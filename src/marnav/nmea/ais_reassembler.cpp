@@ -0,0 +1,216 @@
+#include "ais_reassembler.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <marnav/nmea/vdo.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr uint32_t ais_reassembler::max_fragments;
+constexpr std::size_t ais_reassembler::default_num_slots;
+
+namespace
+{
+/// Marks the absence of a sequential message ID within the key, valid
+/// values are only in the range of 0..9.
+constexpr uint32_t no_seq_msg_id = 0xffffffffu;
+}
+
+/// Initializes the reassembler, all memory for messages in progress is allocated here.
+///
+/// @param[in] num_slots Maximum number of messages in progress at the same time.
+/// @param[in] timeout Time after which incomplete messages are discarded, measured
+///   from the reception of the first fragment.
+/// @exception std::invalid_argument Number of slots is zero.
+ais_reassembler::ais_reassembler(std::size_t num_slots, clock::duration timeout)
+	: timeout_(timeout)
+{
+	if (num_slots == 0)
+		throw std::invalid_argument{"invalid number of slots in ais_reassembler"};
+	slots_.resize(num_slots);
+}
+
+/// Processes the specified fragment.
+///
+/// Invalid, duplicate and orphaned fragments are ignored and only accounted
+/// for in the counters. Messages in progress which exceeded the timeout are
+/// discarded before the fragment is processed.
+///
+/// Messages consisting of one fragment are handed out directly, they never
+/// occupy a slot and therefore never cause other messages to be evicted.
+///
+/// A first fragment for a message already in progress (same key) is a duplicate
+/// if its payload is the same as the one received before, and ignored like every
+/// other duplicate. If the payload differs, a new message reuses the key: the
+/// incomplete message in progress is discarded (counted as `restarted`) and the
+/// new one takes its slot.
+///
+/// @param[in] s The sentence (VDM or VDO) to process.
+/// @param[out] result Receives the payload, if the message is complete.
+///   The container is only modified if the function returns `true`, existing
+///   elements are reused.
+/// @param[in] now The time of reception of the fragment.
+/// @retval true A message is complete, its payload was written to `result`.
+/// @retval false The message is not complete yet or the fragment was ignored.
+bool ais_reassembler::feed(const vdm & s, payload & result, clock::time_point now)
+{
+	const auto n_fragments = s.get_n_fragments();
+	const auto fragment = s.get_fragment();
+
+	if ((n_fragments < 1) || (n_fragments > max_fragments) || (fragment < 1)
+		|| (fragment > n_fragments)) {
+		++counters_.invalid;
+		return false;
+	}
+
+	expire(now);
+
+	if (n_fragments == 1) {
+		result.resize(1);
+		result[0].first = s.get_payload();
+		result[0].second = s.get_n_fill_bits();
+		++counters_.completed;
+		return true;
+	}
+
+	const auto k = make_key(s);
+	slot * sl = find(k);
+
+	if (fragment == 1) {
+		if (sl) {
+			if (sl->fragments[0].first == s.get_payload()) {
+				++counters_.duplicates;
+				return false;
+			}
+			// a new message reuses the key, the one in progress will never complete
+			++counters_.restarted;
+		} else {
+			sl = &acquire();
+		}
+		sl->used = true;
+		sl->k = k;
+		sl->received = 0;
+		sl->started = now;
+	} else if (!sl) {
+		++counters_.orphans;
+		return false;
+	}
+
+	const uint32_t bit = 1u << (fragment - 1);
+	if (sl->received & bit) {
+		++counters_.duplicates;
+		return false;
+	}
+	sl->received |= bit;
+
+	auto & f = sl->fragments[fragment - 1];
+	f.first = s.get_payload();
+	f.second = s.get_n_fill_bits();
+
+	if (sl->received != ((1u << n_fragments) - 1))
+		return false;
+
+	return complete(*sl, result);
+}
+
+/// Processes the specified sentence. Sentences other than VDM or VDO are
+/// ignored and not accounted for in the counters.
+///
+/// @see feed(const vdm & s, payload & result, clock::time_point now)
+bool ais_reassembler::feed(const sentence & s, payload & result, clock::time_point now)
+{
+	// sentence_cast is not dynamic_cast, VDM and VDO have to be checked individually.
+	switch (s.id()) {
+		case sentence_id::VDM:
+			return feed(*sentence_cast<vdm>(&s), result, now);
+		case sentence_id::VDO:
+			return feed(*sentence_cast<vdo>(&s), result, now);
+		default:
+			break;
+	}
+	return false;
+}
+
+/// Discards all messages in progress which exceeded the timeout.
+///
+/// @param[in] now The current time.
+/// @return Number of discarded messages.
+std::size_t ais_reassembler::expire(clock::time_point now)
+{
+	std::size_t n = 0;
+	for (auto & sl : slots_) {
+		if (sl.used && ((now - sl.started) > timeout_)) {
+			sl.used = false;
+			++n;
+		}
+	}
+	counters_.expired += n;
+	return n;
+}
+
+/// Discards all messages in progress and resets the counters.
+void ais_reassembler::reset() noexcept
+{
+	for (auto & sl : slots_)
+		sl.used = false;
+	counters_ = counters{};
+}
+
+/// Returns the number of incomplete messages.
+std::size_t ais_reassembler::in_progress() const noexcept
+{
+	return std::count_if(
+		slots_.begin(), slots_.end(), [](const slot & sl) { return sl.used; });
+}
+
+ais_reassembler::key ais_reassembler::make_key(const vdm & s)
+{
+	key k;
+	k.talk = s.get_talker();
+	k.id = s.id();
+	const auto channel = s.get_radio_channel();
+	k.channel = channel ? static_cast<char>(*channel) : 0;
+	const auto seq_msg_id = s.get_seq_msg_id();
+	k.seq_msg_id = seq_msg_id ? *seq_msg_id : no_seq_msg_id;
+	k.n_fragments = s.get_n_fragments();
+	return k;
+}
+
+ais_reassembler::slot * ais_reassembler::find(const key & k) noexcept
+{
+	for (auto & sl : slots_)
+		if (sl.used && (sl.k == k))
+			return &sl;
+	return nullptr;
+}
+
+/// Returns a free slot. If there is none, the oldest message in progress
+/// is discarded.
+ais_reassembler::slot & ais_reassembler::acquire() noexcept
+{
+	auto oldest = slots_.begin();
+	for (auto i = slots_.begin(); i != slots_.end(); ++i) {
+		if (!i->used)
+			return *i;
+		if (i->started < oldest->started)
+			oldest = i;
+	}
+	++counters_.evicted;
+	return *oldest;
+}
+
+bool ais_reassembler::complete(slot & sl, payload & result)
+{
+	const auto n = sl.k.n_fragments;
+	result.resize(n);
+	for (uint32_t i = 0; i < n; ++i) {
+		result[i].first.assign(sl.fragments[i].first);
+		result[i].second = sl.fragments[i].second;
+	}
+	sl.used = false;
+	++counters_.completed;
+	return true;
+}
+}
+}
@@ -0,0 +1,119 @@
+#ifndef MARNAV__NMEA__AIS_REASSEMBLER__HPP
+#define MARNAV__NMEA__AIS_REASSEMBLER__HPP
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <marnav/nmea/vdm.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Reassembles AIS payload from fragmented VDM/VDO sentences.
+///
+/// Sentences of multiple AIS messages may arrive interleaved, this class keeps
+/// track of them by their talker, sentence ID, radio channel and sequential
+/// message ID. Once all fragments of a message were received, the payload is
+/// handed out, ready to be passed to `ais::make_message`.
+///
+/// The memory used is bounded: the number of messages in progress is limited
+/// to a fixed number of slots, preallocated at construction. If all slots are
+/// in use, the oldest message is discarded. Messages consisting of one fragment
+/// only do not use a slot. Messages which are not completed within the configured
+/// timeout are discarded as well.
+///
+/// Fragments must start with the first one, all others may arrive in any order.
+///
+/// Example:
+/// @code
+///   nmea::ais_reassembler r;
+///   nmea::ais_reassembler::payload payload;
+///   while (...) {
+///       auto s = nmea::make_sentence(...);
+///       if (r.feed(*s, payload)) {
+///           auto msg = ais::make_message(payload);
+///           ...
+///       }
+///   }
+/// @endcode
+class ais_reassembler
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	/// Payload of a complete message, suitable for `ais::make_message`.
+	using payload = std::vector<std::pair<std::string, uint32_t>>;
+
+	/// Maximum number of fragments a message may consist of.
+	static constexpr uint32_t max_fragments = 9u;
+
+	static constexpr std::size_t default_num_slots = 16u;
+
+	/// Statistics about the processed fragments.
+	struct counters {
+		uint64_t completed = 0; ///< Messages handed out completely.
+		uint64_t orphans = 0; ///< Fragments without a message in progress.
+		uint64_t duplicates = 0; ///< Fragments received more than once.
+		uint64_t invalid = 0; ///< Fragments with invalid fragment information.
+		uint64_t expired = 0; ///< Incomplete messages discarded due to timeout.
+		uint64_t evicted = 0; ///< Incomplete messages discarded to make room.
+		uint64_t restarted = 0; ///< Incomplete messages discarded, key reused by a new one.
+	};
+
+	ais_reassembler(std::size_t num_slots = default_num_slots,
+		clock::duration timeout = std::chrono::seconds{5});
+
+	ais_reassembler(const ais_reassembler &) = default;
+	ais_reassembler(ais_reassembler &&) = default;
+	ais_reassembler & operator=(const ais_reassembler &) = default;
+	ais_reassembler & operator=(ais_reassembler &&) = default;
+
+	bool feed(const vdm & s, payload & result, clock::time_point now = clock::now());
+	bool feed(const sentence & s, payload & result, clock::time_point now = clock::now());
+
+	std::size_t expire(clock::time_point now = clock::now());
+
+	void reset() noexcept;
+
+	std::size_t in_progress() const noexcept;
+
+	const counters & get_counters() const noexcept { return counters_; }
+
+private:
+	struct key {
+		talker talk = talker::none;
+		sentence_id id = sentence_id::NONE;
+		char channel = 0;
+		uint32_t seq_msg_id = 0;
+		uint32_t n_fragments = 0;
+
+		bool operator==(const key & other) const noexcept
+		{
+			return (talk == other.talk) && (id == other.id) && (channel == other.channel)
+				&& (seq_msg_id == other.seq_msg_id) && (n_fragments == other.n_fragments);
+		}
+	};
+
+	struct slot {
+		bool used = false;
+		key k;
+		uint32_t received = 0; // bitmask of received fragments
+		clock::time_point started;
+		std::array<std::pair<std::string, uint32_t>, max_fragments> fragments;
+	};
+
+	clock::duration timeout_;
+	std::vector<slot> slots_;
+	counters counters_;
+
+	static key make_key(const vdm & s);
+	slot * find(const key & k) noexcept;
+	slot & acquire() noexcept;
+	bool complete(slot & sl, payload & result);
+};
+}
+}
+
+#endif
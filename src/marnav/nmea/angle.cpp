@@ -1,4 +1,6 @@
 #include "angle.hpp"
+#include <marnav/nmea/io.hpp>
+#include <marnav/nmea/numeric.hpp>
 #include <stdexcept>
 #include <cmath>
 
@@ -13,19 +15,15 @@ static geo::angle parse_angle(const std::string & s)
 {
 	if (s.empty())
 		return geo::angle{0.0};
-	std::size_t pos = 0;
-	auto tmp = std::stod(s, &pos);
-	if (pos != s.size())
-		throw std::invalid_argument{"invalid string for conversion to geo::angle for NMEA"};
 
 	// adoption of NMEA angle DDDMM.SSS to the one that is used here
-	const double deg = (tmp - fmod(tmp, 100.0)) / 100.0;
-	const double min = (tmp - (deg * 100.0)) / 60.0;
-
-	if (std::abs(min) >= 1.0)
-		throw std::invalid_argument{"invalid format for minutes in geo::angle for NMEA"};
-
-	return geo::angle{deg + min};
+	const auto t = parse_degrees_minutes(s.data(), s.data() + s.size());
+	if (!t) {
+		if (t.error() == numeric_error::out_of_range)
+			throw std::invalid_argument{"invalid format for minutes in geo::angle for NMEA"};
+		throw std::invalid_argument{"invalid string for conversion to geo::angle for NMEA"};
+	}
+	return geo::angle{*t};
 }
 }
 /// @endcond
@@ -54,9 +52,15 @@ geo::latitude parse_latitude(const std::string & s)
 std::string to_string(const geo::latitude & v)
 {
 	char buf[32];
-	snprintf(buf, sizeof(buf), "%02u%02u.%04u", v.degrees(), v.minutes(),
-		static_cast<uint32_t>((v.seconds() / 60) * 10000));
-	return buf;
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), v));
+}
+
+char * to_chars(char * first, char * last, const geo::latitude & v) noexcept
+{
+	first = format_to(first, last, v.degrees(), 2);
+	first = format_to(first, last, v.minutes(), 2);
+	first = to_chars(first, last, '.');
+	return format_to(first, last, static_cast<uint32_t>((v.seconds() / 60) * 10000), 4);
 }
 
 /// Returns the longitude, representing the specified string. The provided string is assumed
@@ -83,9 +87,15 @@ geo::longitude parse_longitude(const std::string & s)
 std::string to_string(const geo::longitude & v)
 {
 	char buf[32];
-	snprintf(buf, sizeof(buf), "%03u%02u.%04u", v.degrees(), v.minutes(),
-		static_cast<uint32_t>(10000 * v.seconds() / 60));
-	return buf;
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), v));
+}
+
+char * to_chars(char * first, char * last, const geo::longitude & v) noexcept
+{
+	first = format_to(first, last, v.degrees(), 3);
+	first = format_to(first, last, v.minutes(), 2);
+	first = to_chars(first, last, '.');
+	return format_to(first, last, static_cast<uint32_t>(10000 * v.seconds() / 60), 4);
 }
 }
 }
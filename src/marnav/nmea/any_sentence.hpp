@@ -0,0 +1,169 @@
+#ifndef MARNAV__NMEA__ANY_SENTENCE__HPP
+#define MARNAV__NMEA__ANY_SENTENCE__HPP
+
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/utils/variant.hpp>
+#include <marnav/nmea/aam.hpp>
+#include <marnav/nmea/alm.hpp>
+#include <marnav/nmea/apa.hpp>
+#include <marnav/nmea/apb.hpp>
+#include <marnav/nmea/bod.hpp>
+#include <marnav/nmea/bwc.hpp>
+#include <marnav/nmea/bwr.hpp>
+#include <marnav/nmea/bww.hpp>
+#include <marnav/nmea/dbk.hpp>
+#include <marnav/nmea/dbt.hpp>
+#include <marnav/nmea/dpt.hpp>
+#include <marnav/nmea/dsc.hpp>
+#include <marnav/nmea/dse.hpp>
+#include <marnav/nmea/dtm.hpp>
+#include <marnav/nmea/fsi.hpp>
+#include <marnav/nmea/gbs.hpp>
+#include <marnav/nmea/gga.hpp>
+#include <marnav/nmea/glc.hpp>
+#include <marnav/nmea/gll.hpp>
+#include <marnav/nmea/grs.hpp>
+#include <marnav/nmea/gns.hpp>
+#include <marnav/nmea/gsa.hpp>
+#include <marnav/nmea/gst.hpp>
+#include <marnav/nmea/gsv.hpp>
+#include <marnav/nmea/gtd.hpp>
+#include <marnav/nmea/hdg.hpp>
+#include <marnav/nmea/hfb.hpp>
+#include <marnav/nmea/hdm.hpp>
+#include <marnav/nmea/hdt.hpp>
+#include <marnav/nmea/hsc.hpp>
+#include <marnav/nmea/its.hpp>
+#include <marnav/nmea/lcd.hpp>
+#include <marnav/nmea/msk.hpp>
+#include <marnav/nmea/mss.hpp>
+#include <marnav/nmea/mtw.hpp>
+#include <marnav/nmea/mwd.hpp>
+#include <marnav/nmea/mwv.hpp>
+#include <marnav/nmea/osd.hpp>
+#include <marnav/nmea/r00.hpp>
+#include <marnav/nmea/rma.hpp>
+#include <marnav/nmea/rmb.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/rot.hpp>
+#include <marnav/nmea/rpm.hpp>
+#include <marnav/nmea/rsa.hpp>
+#include <marnav/nmea/rsd.hpp>
+#include <marnav/nmea/rte.hpp>
+#include <marnav/nmea/sfi.hpp>
+#include <marnav/nmea/stn.hpp>
+#include <marnav/nmea/tds.hpp>
+#include <marnav/nmea/tfi.hpp>
+#include <marnav/nmea/tll.hpp>
+#include <marnav/nmea/tpc.hpp>
+#include <marnav/nmea/tpr.hpp>
+#include <marnav/nmea/tpt.hpp>
+#include <marnav/nmea/ttm.hpp>
+#include <marnav/nmea/vbw.hpp>
+#include <marnav/nmea/vdm.hpp>
+#include <marnav/nmea/vdo.hpp>
+#include <marnav/nmea/vdr.hpp>
+#include <marnav/nmea/vhw.hpp>
+#include <marnav/nmea/vlw.hpp>
+#include <marnav/nmea/vpw.hpp>
+#include <marnav/nmea/vtg.hpp>
+#include <marnav/nmea/vwr.hpp>
+#include <marnav/nmea/wcv.hpp>
+#include <marnav/nmea/wnc.hpp>
+#include <marnav/nmea/wpl.hpp>
+#include <marnav/nmea/xdr.hpp>
+#include <marnav/nmea/xte.hpp>
+#include <marnav/nmea/xtr.hpp>
+#include <marnav/nmea/zda.hpp>
+#include <marnav/nmea/zdl.hpp>
+#include <marnav/nmea/zfo.hpp>
+#include <marnav/nmea/ztg.hpp>
+#include <marnav/nmea/pgrme.hpp>
+#include <marnav/nmea/pgrmm.hpp>
+#include <marnav/nmea/pgrmz.hpp>
+#include <marnav/nmea/stalk.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Holds any of the supported sentences by value.
+///
+/// This is an alternative to `std::unique_ptr<sentence>` as returned by `make_sentence`.
+/// The sentence is stored within the object, which makes it possible to keep sentences
+/// in contiguous containers, without a heap allocation per sentence and without
+/// pointer chasing while processing them.
+///
+/// Access to the specific sentence is provided by `utils::visit`, `utils::get_if`
+/// and `utils::get`, the common interface by `as_sentence`.
+///
+/// @note The size of this type is the size of the largest sentence. Including
+///   this header includes all sentences.
+///
+/// Example:
+/// @code
+///   struct printer {
+///       void operator()(const nmea::mtw & s) { std::cout << *s.get_temperature() << "\n"; }
+///       template <class T> void operator()(const T & s) { std::cout << s.tag() << "\n"; }
+///   };
+///
+///   std::vector<nmea::any_sentence> v;
+///   v.push_back(nmea::make_any_sentence("$IIMTW,9.5,C*2F"));
+///   for (const auto & s : v)
+///       utils::visit(printer{}, s);
+/// @endcode
+using any_sentence = utils::variant<
+	aam, alm, apa, apb, bod, bwc, bwr, bww, dbk, dbt, dpt, dsc, dse, dtm, fsi, gbs, gga, glc,
+	gll, grs, gns, gsa, gst, gsv, gtd, hdg, hfb, hdm, hdt, hsc, its, lcd, msk, mss, mtw, mwd,
+	mwv, osd, r00, rma, rmb, rmc, rot, rpm, rsa, rsd, rte, sfi, stn, tds, tfi, tll, tpc, tpr,
+	tpt, ttm, vbw, vdm, vdo, vdr, vhw, vlw, vpw, vtg, vwr, wcv, wnc, wpl, xdr, xte, xtr, zda,
+	zdl, zfo, ztg, pgrme, pgrmm, pgrmz, stalk>;
+
+any_sentence make_any_sentence(
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+any_sentence make_any_sentence(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+utils::expected<any_sentence, parse_error> try_make_any_sentence(
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+utils::expected<any_sentence, parse_error> try_make_any_sentence(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+parse_error decode_sentence(const char * s, std::size_t n, any_sentence & result,
+	checksum_handling chksum = checksum_handling::check);
+
+/// @cond DEV
+namespace detail
+{
+struct as_sentence_visitor {
+	template <class T> sentence & operator()(T & s) const noexcept { return s; }
+	template <class T> const sentence & operator()(const T & s) const noexcept { return s; }
+};
+}
+/// @endcond
+
+/// Returns the contained sentence through the interface of the base class.
+inline sentence & as_sentence(any_sentence & s) noexcept
+{
+	return s.visit(detail::as_sentence_visitor{});
+}
+
+/// Const variant.
+inline const sentence & as_sentence(const any_sentence & s) noexcept
+{
+	return s.visit(detail::as_sentence_visitor{});
+}
+
+/// Renders the contained sentence into a string.
+///
+/// @see to_string(const sentence & s)
+inline std::string to_string(const any_sentence & s)
+{
+	return to_string(as_sentence(s));
+}
+}
+}
+
+#endif
@@ -1,10 +1,202 @@
 #include "checksum.hpp"
 #include "hex_digit.hpp"
+#include <cstring>
+#include <marnav/nmea/sentence.hpp>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
 
 namespace marnav
 {
 namespace nmea
 {
+/// @cond DEV
+namespace
+{
+// The checksum is computed in blocks of bytes, the XOR of all blocks is reduced
+// to a single byte at the end. The block processing is done using the widest
+// vector instructions enabled at compile time, with a fallback to 64 bit words.
+
+#if defined(__AVX2__)
+using block = __m256i;
+
+static block load(const char * p) noexcept
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+static block zero() noexcept
+{
+	return _mm256_setzero_si256();
+}
+
+static block bit_xor(block a, block b) noexcept
+{
+	return _mm256_xor_si256(a, b);
+}
+
+static block bit_and(block a, block b) noexcept
+{
+	return _mm256_and_si256(a, b);
+}
+
+/// Returns a bit mask with one bit per byte, set for bytes equal to `c`.
+static uint32_t find(block a, char c) noexcept
+{
+	return static_cast<uint32_t>(
+		_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_set1_epi8(c))));
+}
+#elif defined(__SSE2__)
+using block = __m128i;
+
+static block load(const char * p) noexcept
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+static block zero() noexcept
+{
+	return _mm_setzero_si128();
+}
+
+static block bit_xor(block a, block b) noexcept
+{
+	return _mm_xor_si128(a, b);
+}
+
+static block bit_and(block a, block b) noexcept
+{
+	return _mm_and_si128(a, b);
+}
+
+/// Returns a bit mask with one bit per byte, set for bytes equal to `c`.
+static uint32_t find(block a, char c) noexcept
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_set1_epi8(c))));
+}
+#else
+using block = uint64_t;
+
+static block load(const char * p) noexcept
+{
+	block t;
+	std::memcpy(&t, p, sizeof(t));
+	return t;
+}
+
+static block zero() noexcept
+{
+	return 0u;
+}
+
+static block bit_xor(block a, block b) noexcept
+{
+	return a ^ b;
+}
+
+static block bit_and(block a, block b) noexcept
+{
+	return a & b;
+}
+
+/// Returns a bit mask with one bit per byte, set for bytes equal to `c`.
+static uint32_t find(block a, char c) noexcept
+{
+	uint32_t mask = 0u;
+	char t[sizeof(block)];
+	std::memcpy(t, &a, sizeof(t));
+	for (std::size_t i = 0; i < sizeof(t); ++i)
+		if (t[i] == c)
+			mask |= 1u << i;
+	return mask;
+}
+#endif
+
+static constexpr std::size_t block_size = sizeof(block);
+
+/// Reduces the block to the XOR of all its bytes.
+static uint8_t reduce(block a) noexcept
+{
+	uint64_t t;
+#if defined(__AVX2__)
+	__m128i h = _mm_xor_si128(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+	h = _mm_xor_si128(h, _mm_srli_si128(h, 8));
+	t = static_cast<uint64_t>(_mm_cvtsi128_si64(h));
+#elif defined(__SSE2__) && defined(__x86_64__)
+	t = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_xor_si128(a, _mm_srli_si128(a, 8))));
+#elif defined(__SSE2__)
+	const __m128i h = _mm_xor_si128(a, _mm_srli_si128(a, 8));
+	t = static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(h)))
+		^ static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(h, 4))));
+#else
+	t = a;
+#endif
+	t ^= t >> 32;
+	t ^= t >> 16;
+	t ^= t >> 8;
+	return static_cast<uint8_t>(t);
+}
+
+/// Computes the XOR of the remaining bytes, less than one block.
+static uint8_t tail(const char * first, const char * last) noexcept
+{
+	uint64_t acc = 0u;
+	for (; (last - first) >= 8; first += 8) {
+		uint64_t t;
+		std::memcpy(&t, first, sizeof(t));
+		acc ^= t;
+	}
+	acc ^= acc >> 32;
+	acc ^= acc >> 16;
+	acc ^= acc >> 8;
+	uint8_t sum = static_cast<uint8_t>(acc);
+	for (; first != last; ++first)
+		sum ^= static_cast<uint8_t>(*first);
+	return sum;
+}
+
+/// Returns a block with the first `n` bytes set to all ones, the rest to zero.
+static block head_mask(std::size_t n) noexcept
+{
+	static constexpr std::size_t max_block_size = 32u;
+	static_assert(block_size <= max_block_size, "block size not supported");
+	static const uint8_t ones_then_zeros[2 * max_block_size] = {0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	return load(reinterpret_cast<const char *>(ones_then_zeros) + max_block_size - n);
+}
+
+/// Returns the position of the lowest set bit, the value must not be zero.
+static std::size_t lowest_bit(uint32_t mask) noexcept
+{
+#if defined(__GNUC__)
+	return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+	std::size_t i = 0;
+	while (!(mask & 1u)) {
+		mask >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+static int hex_value(char c) noexcept
+{
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	if ((c >= 'A') && (c <= 'F'))
+		return c - 'A' + 10;
+	if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+	return -1;
+}
+}
+/// @endcond
+
 checksum_error::checksum_error(uint8_t exp, uint8_t act)
 	: expected_(exp)
 	, actual_(act)
@@ -13,6 +205,74 @@ checksum_error::checksum_error(uint8_t exp, uint8_t act)
 		expected_);
 }
 
+/// Computes and returns the checksum of the specified range. This is the
+/// same as the generic `checksum` function, but processes multiple bytes
+/// at once.
+///
+/// @param[in] first Start of the range.
+/// @param[in] last End of the range (exclusive).
+/// @return The computed checksum.
+uint8_t checksum(const char * first, const char * last) noexcept
+{
+	block acc = zero();
+	for (; static_cast<std::size_t>(last - first) >= block_size; first += block_size)
+		acc = bit_xor(acc, load(first));
+
+	return reduce(acc) ^ tail(first, last);
+}
+
+/// Searches the end token and computes the checksum of the data up to it in one
+/// pass, then reads the expected checksum, which must consist of exactly two hex
+/// digits at the end of the range.
+///
+/// @param[in] first Start of the data to compute the checksum of, usually the
+///   character after the start token.
+/// @param[in] last End of the sentence (exclusive), i.e. after the checksum.
+/// @return The result of the scan. The checksums are valid only if the status
+///   is either `ok` or `mismatch`.
+checksum_scan scan_checksum(const char * first, const char * last) noexcept
+{
+	checksum_scan result;
+
+	block acc = zero();
+	while (static_cast<std::size_t>(last - first) >= block_size) {
+		const block t = load(first);
+		const uint32_t mask = find(t, sentence::end_token);
+		if (mask) {
+			const std::size_t n = lowest_bit(mask);
+			acc = bit_xor(acc, bit_and(t, head_mask(n)));
+			result.end = first + n;
+			break;
+		}
+		acc = bit_xor(acc, t);
+		first += block_size;
+	}
+
+	result.actual = reduce(acc);
+	if (!result.end) {
+		result.end = static_cast<const char *>(
+			std::memchr(first, sentence::end_token, static_cast<std::size_t>(last - first)));
+		if (!result.end)
+			return result;
+		result.actual ^= tail(first, result.end);
+	}
+
+	if (last - result.end != 3) {
+		result.result = checksum_scan::status::invalid_format;
+		return result;
+	}
+	const int hi = hex_value(result.end[1]);
+	const int lo = hex_value(result.end[2]);
+	if ((hi < 0) || (lo < 0)) {
+		result.result = checksum_scan::status::invalid_format;
+		return result;
+	}
+	result.expected = static_cast<uint8_t>((hi << 4) | lo);
+	result.result = (result.expected == result.actual) ? checksum_scan::status::ok
+													   : checksum_scan::status::mismatch;
+	return result;
+}
+
 /// Returns the specified checksum as string.
 ///
 /// @param[in] sum The checksum to render as string.
@@ -49,6 +49,26 @@ template <class Iterator> uint8_t checksum(Iterator a, Iterator b) noexcept
 	return sum;
 }
 
+uint8_t checksum(const char * first, const char * last) noexcept;
+
+/// Result of `scan_checksum`.
+struct checksum_scan {
+	/// Possible outcomes of the scan.
+	enum class status {
+		ok, ///< The checksum is present and correct.
+		no_end_token, ///< There is no end token.
+		invalid_format, ///< Not exactly two hex digits after the end token.
+		mismatch, ///< The checksum is present but wrong.
+	};
+
+	status result = status::no_end_token;
+	const char * end = nullptr; ///< Position of the end token, if found.
+	uint8_t expected = 0u; ///< Checksum read from the data.
+	uint8_t actual = 0u; ///< Checksum computed from the data.
+};
+
+checksum_scan scan_checksum(const char * first, const char * last) noexcept;
+
 std::string checksum_to_string(uint8_t sum);
 }
 }
@@ -1,5 +1,8 @@
 #include "date.hpp"
+#include <algorithm>
 #include <stdexcept>
+#include <marnav/nmea/io.hpp>
+#include <marnav/nmea/numeric.hpp>
 
 namespace marnav
 {
@@ -77,20 +80,32 @@ bool operator==(const date & a, const date & b) noexcept
 
 std::string to_string(const date & d)
 {
-	char buf[7];
-	snprintf(buf, sizeof(buf), "%02u%02u%02u", d.day(), static_cast<unsigned int>(d.mon()),
-		d.year());
-	return buf;
+	char buf[32];
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), d));
+}
+
+char * to_chars(char * first, char * last, const date & d) noexcept
+{
+	char buf[32];
+	const auto e = buf + sizeof(buf);
+	char * p = format_to(buf, e, d.day(), 2);
+	p = format_to(p, e, static_cast<uint32_t>(d.mon()), 2);
+	p = format_to(p, e, d.year(), 2);
+	// limited to 'ddmmyy', years beyond 99 are cut off
+	const auto n = static_cast<std::size_t>(std::min(p, buf + 6) - buf);
+	if (!first || (static_cast<std::size_t>(last - first) < n))
+		return nullptr;
+	return std::copy(buf, buf + n, first);
 }
 
 date date::parse(const std::string & str)
 {
+	const auto t = parse_unsigned(str.data(), str.data() + str.size());
+	if (!t || (*t > 999999u))
+		throw std::invalid_argument{"invalid date format, 'DDMMYY' expected"};
+	const auto v = static_cast<uint32_t>(*t);
 	try {
-		std::size_t pos = 0;
-		uint32_t t = std::stoul(str, &pos);
-		if (pos != str.size())
-			throw std::invalid_argument{"invalid format for date"};
-		return date{t % 100, static_cast<month>((t / 100) % 100), (t / 10000) % 100};
+		return date{v % 100, static_cast<month>((v / 100) % 100), (v / 10000) % 100};
 	} catch (std::invalid_argument &) {
 		throw std::invalid_argument{"invalid date format, 'DDMMYY' expected"};
 	}
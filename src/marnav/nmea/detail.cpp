@@ -1,4 +1,5 @@
 #include "detail.hpp"
+#include <cstring>
 #include <marnav/nmea/sentence.hpp>
 #include <marnav/nmea/split.hpp>
 
@@ -46,7 +47,7 @@ extract_sentence_information(const std::string & s, checksum_handling chksum)
 
 	if (chksum == checksum_handling::check) {
 		// check checksum from next character on, ignoring the start token.
-		detail::ensure_checksum(s, fields.back(), search_pos);
+		detail::ensure_checksum(s, search_pos);
 	}
 
 	// extract address and posibly talker_id and tag.
@@ -58,6 +59,43 @@ extract_sentence_information(const std::string & s, checksum_handling chksum)
 
 	return std::make_tuple(talk, tag, tag_block, fields);
 }
+
+/// Locates the address field within the specified raw sentence, without any
+/// further processing of the sentence. An optional tag block is skipped, the
+/// address field must be followed by a field delimiter.
+///
+/// @param[in] s The raw NMEA sentence.
+/// @param[in] n Size of the raw sentence.
+/// @param[out] address Start of the address field, valid only if successful.
+/// @param[out] size Size of the address field, valid only if successful.
+/// @retval true  The address field was found.
+/// @retval false The sentence is malformed.
+bool find_address(
+	const char * s, std::size_t n, const char *& address, std::size_t & size) noexcept
+{
+	if (!s || (n == 0u))
+		return false;
+	if ((s[0] != sentence::start_token) && (s[0] != sentence::start_token_ais)
+		&& (s[0] != sentence::tag_block_token))
+		return false;
+
+	std::size_t pos = 1u; // ignore start token
+	if (s[0] == sentence::tag_block_token) {
+		const char * const i
+			= static_cast<const char *>(std::memchr(s + 1, sentence::tag_block_token, n - 1));
+		if (i != nullptr)
+			pos = static_cast<std::size_t>(i - s) + 2u; // next after tag block and start token
+	}
+
+	for (std::size_t i = pos; i < n; ++i) {
+		if (s[i] == sentence::field_delimiter) {
+			address = s + pos;
+			size = i - pos;
+			return true;
+		}
+	}
+	return false;
+}
 }
 /// @endcond
 }
@@ -1,11 +1,15 @@
 #ifndef MARNAV__NMEA__DETAIL__HPP
 #define MARNAV__NMEA__DETAIL__HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <vector>
+#include <stdexcept>
 #include <marnav/nmea/talker_id.hpp>
+#include <marnav/nmea/sentence_id.hpp>
 #include <marnav/nmea/checksum_enum.hpp>
 
 namespace marnav
@@ -19,8 +23,13 @@ namespace detail
 {
 std::tuple<talker, std::string> parse_address(const std::string & address);
 
-void ensure_checksum(
-	const std::string & s, const std::string & expected, std::string::size_type start_pos);
+bool parse_address(
+	const char * address, std::size_t n, talker & talk, sentence_id & id) noexcept;
+
+bool find_address(
+	const char * s, std::size_t n, const char *& address, std::size_t & size) noexcept;
+
+void ensure_checksum(const std::string & s, std::string::size_type start_pos);
 
 void check_raw_sentence(const std::string & s);
 
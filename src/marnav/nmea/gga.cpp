@@ -80,5 +80,23 @@ void gga::append_data_to(std::string & s) const
 	append(s, to_string(dgps_age_));
 	append(s, to_string(dgps_ref_));
 }
+
+char * gga::write_data_to(char * first, char * last) const
+{
+	first = to_chars(write_delimiter(first, last), last, time_);
+	first = to_chars(write_delimiter(first, last), last, lat_);
+	first = to_chars(write_delimiter(first, last), last, lat_hem_);
+	first = to_chars(write_delimiter(first, last), last, lon_);
+	first = to_chars(write_delimiter(first, last), last, lon_hem_);
+	first = to_chars(write_delimiter(first, last), last, quality_indicator_);
+	first = to_chars(write_delimiter(first, last), last, n_satellites_);
+	first = to_chars(write_delimiter(first, last), last, hor_dilution_);
+	first = to_chars(write_delimiter(first, last), last, altitude_);
+	first = to_chars(write_delimiter(first, last), last, altitude_unit_);
+	first = to_chars(write_delimiter(first, last), last, geodial_separation_);
+	first = to_chars(write_delimiter(first, last), last, geodial_separation_unit_);
+	first = to_chars(write_delimiter(first, last), last, dgps_age_);
+	return to_chars(write_delimiter(first, last), last, dgps_ref_);
+}
 }
 }
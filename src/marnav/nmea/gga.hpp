@@ -74,6 +74,7 @@ public:
 protected:
 	gga(talker talk, fields::const_iterator first, fields::const_iterator last);
 	virtual void append_data_to(std::string &) const override;
+	virtual char * write_data_to(char * first, char * last) const override;
 
 private:
 	utils::optional<nmea::time> time_;
@@ -34,5 +34,11 @@ void hdt::append_data_to(std::string & s) const
 	append(s, to_string(heading_));
 	append(s, to_string(heading_true_));
 }
+
+char * hdt::write_data_to(char * first, char * last) const
+{
+	first = to_chars(write_delimiter(first, last), last, heading_);
+	return to_chars(write_delimiter(first, last), last, heading_true_);
+}
 }
 }
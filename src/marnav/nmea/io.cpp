@@ -1,4 +1,9 @@
 #include "io.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <marnav/nmea/numeric.hpp>
 #include <marnav/nmea/angle.hpp>
 #include <marnav/nmea/date.hpp>
 #include <marnav/nmea/time.hpp>
@@ -10,86 +15,156 @@ namespace marnav
 {
 namespace nmea
 {
+/// @cond DEV
+
+namespace detail
+{
+/// Writes the unsigned integer with at least `width` digits, padded with zeros.
+template <typename T>
+static char * write_unsigned(
+	char * first, char * last, T data, unsigned int width, data_format f) noexcept
+{
+	char tmp[24]; // sufficient for all digits of a 64 bit value
+	char * p = tmp + sizeof(tmp);
+	if (f == data_format::hex) {
+		do {
+			*--p = "0123456789abcdef"[data & 0xf];
+			data >>= 4;
+		} while (data);
+	} else {
+		do {
+			*--p = static_cast<char>('0' + (data % 10));
+			data /= 10;
+		} while (data);
+	}
+
+	const std::size_t n = static_cast<std::size_t>(tmp + sizeof(tmp) - p);
+	const std::size_t pad = (width > n) ? (width - n) : 0u;
+	if (!first || (static_cast<std::size_t>(last - first) < (pad + n)))
+		return nullptr;
+	first = std::fill_n(first, pad, '0');
+	return std::copy(p, tmp + sizeof(tmp), first);
+}
+}
+
+/// @endcond
+
+char * format_to(
+	char * first, char * last, int32_t data, unsigned int width, data_format f) noexcept
+{
+	// hex rendering of negative numbers is done in two's complement, like printf does
+	if ((f == data_format::hex) || (data >= 0))
+		return detail::write_unsigned(first, last, static_cast<uint32_t>(data), width, f);
+
+	// the sign counts to the width, zeros are padded after the sign
+	if (!first || (first == last))
+		return nullptr;
+	*first++ = '-';
+	return detail::write_unsigned(first, last, 0u - static_cast<uint32_t>(data),
+		(width > 0) ? (width - 1) : 0u, f);
+}
+
+char * format_to(
+	char * first, char * last, uint64_t data, unsigned int width, data_format f) noexcept
+{
+	return detail::write_unsigned(first, last, data, width, f);
+}
+
+char * format_to(
+	char * first, char * last, uint32_t data, unsigned int width, data_format f) noexcept
+{
+	return detail::write_unsigned(first, last, data, width, f);
+}
+
+char * format_to(
+	char * first, char * last, double data, unsigned int width, data_format f) noexcept
+{
+	utils::unused(f);
+
+	if (!first)
+		return nullptr;
+
+	static constexpr unsigned int max_width = 18; // 10^18 fits into uint64_t, exact as double
+	static constexpr double max_scaled = 4503599627370496.0; // 2^52
+
+	uint64_t scale = 1;
+	for (unsigned int i = 0; (i < width) && (i < max_width); ++i)
+		scale *= 10;
+	const double x = std::fabs(data);
+	const double s = static_cast<double>(scale);
+	const double scaled = x * s;
+
+	if ((width > max_width) || !std::isfinite(data) || !(scaled < max_scaled)) {
+		// rare cases are left to the C library
+		char tmp[512];
+		char fmt[8];
+		snprintf(fmt, sizeof(fmt), "%%.%uf", width);
+		const int n = snprintf(tmp, sizeof(tmp), fmt, data);
+		if ((n < 0) || (static_cast<std::size_t>(n) >= sizeof(tmp))
+			|| (static_cast<std::size_t>(last - first) < static_cast<std::size_t>(n)))
+			return nullptr;
+		return std::copy(tmp, tmp + n, first);
+	}
+
+	// Round the exact product x * s to nearest, ties to even, like printf does.
+	// The product is scaled + e exactly, with the rounding error e computed by fma.
+	// Below 2^52, the integral and fractional parts of scaled are exact, and
+	// |e| <= 1/4. Therefore fractions below 1/4 always round down, otherwise
+	// the difference to 1/2 is exact and compared with the rounding error.
+	uint64_t value = static_cast<uint64_t>(scaled);
+	const double fraction = scaled - static_cast<double>(value);
+	if (fraction >= 0.25) {
+		const double e = std::fma(x, s, -scaled);
+		const double d = fraction - 0.5;
+		if ((d > -e) || ((d == -e) && (value & 1u)))
+			++value;
+	}
+
+	if (std::signbit(data)) {
+		if (first == last)
+			return nullptr;
+		*first++ = '-';
+	}
+	first = detail::write_unsigned(first, last, value / scale, 1u, data_format::dec);
+	if (!first || (width == 0))
+		return first;
+	if (first == last)
+		return nullptr;
+	*first++ = '.';
+	return detail::write_unsigned(first, last, value % scale, width, data_format::dec);
+}
+
 std::string format(int32_t data, unsigned int width, data_format f)
 {
-	// buffer to hold the resulting string with a static size.
-	// this construct prevents VLA, and should be replaced with C++14 dynarray
 	char buf[32];
 	if (width >= sizeof(buf))
 		throw std::invalid_argument{"width too large in nmea::format"};
-
-	char fmt[8];
-	switch (f) {
-		case data_format::none:
-		case data_format::dec:
-			snprintf(fmt, sizeof(fmt), "%%0%ud", width);
-			break;
-		case data_format::hex:
-			snprintf(fmt, sizeof(fmt), "%%0%ux", width);
-			break;
-	}
-	snprintf(buf, sizeof(buf), fmt, data);
-	return buf;
+	return std::string(buf, format_to(buf, buf + sizeof(buf), data, width, f));
 }
 
 std::string format(uint64_t data, unsigned int width, data_format f)
 {
-	// buffer to hold the resulting string with a static size.
-	// this construct prevents VLA, and should be replaced with C++14 dynarray
 	char buf[64];
 	if (width >= sizeof(buf))
 		throw std::invalid_argument{"width too large in nmea::format"};
-
-	char fmt[8];
-	switch (f) {
-		case data_format::none:
-		case data_format::dec:
-			snprintf(fmt, sizeof(fmt), "%%0%ulu", width);
-			break;
-		case data_format::hex:
-			snprintf(fmt, sizeof(fmt), "%%0%ulx", width);
-			break;
-	}
-	snprintf(buf, sizeof(buf), fmt, data);
-	return buf;
+	return std::string(buf, format_to(buf, buf + sizeof(buf), data, width, f));
 }
 
 std::string format(uint32_t data, unsigned int width, data_format f)
 {
-	// buffer to hold the resulting string with a static size.
-	// this construct prevents VLA, and should be replaced with C++14 dynarray
 	char buf[32];
 	if (width >= sizeof(buf))
 		throw std::invalid_argument{"width too large in nmea::format"};
-
-	char fmt[8];
-	switch (f) {
-		case data_format::none:
-		case data_format::dec:
-			snprintf(fmt, sizeof(fmt), "%%0%uu", width);
-			break;
-		case data_format::hex:
-			snprintf(fmt, sizeof(fmt), "%%0%ux", width);
-			break;
-	}
-	snprintf(buf, sizeof(buf), fmt, data);
-	return buf;
+	return std::string(buf, format_to(buf, buf + sizeof(buf), data, width, f));
 }
 
 std::string format(double data, unsigned int width, data_format f)
 {
-	utils::unused(f);
-
-	// buffer to hold the resulting string with a static size.
-	// this construct prevents VLA, and should be replaced with C++14 dynarray
-	char buf[32];
-	if (width >= sizeof(buf))
+	char buf[512];
+	if (width >= 32)
 		throw std::invalid_argument{"width too large in nmea::format"};
-
-	char fmt[8];
-	snprintf(fmt, sizeof(fmt), "%%.%uf", width);
-	snprintf(buf, sizeof(buf), fmt, data);
-	return buf;
+	char * end = format_to(buf, buf + sizeof(buf), data, width, f);
+	return end ? std::string(buf, end) : std::string{};
 }
 
 void read(const std::string & s, geo::latitude & value, data_format fmt)
@@ -146,32 +221,41 @@ void read(const std::string & s, char & value, data_format fmt)
 
 namespace detail
 {
-template <typename T> T sto(const std::string &, std::size_t *, int);
-
-template <> uint64_t sto(const std::string & s, std::size_t * pos, int base)
+static std::runtime_error conversion_error(const std::string & s, numeric_error e)
 {
-	return std::stoull(s, pos, base);
+	return std::runtime_error{
+		"invalid string to convert to number (" + to_string(e) + "): [" + s + "]"};
 }
 
-template <> uint32_t sto(const std::string & s, std::size_t * pos, int base)
-{
-	return std::stoul(s, pos, base);
-}
-
-template <> int32_t sto(const std::string & s, std::size_t * pos, int base)
+template <typename T,
+	typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value,
+		int>::type
+	= 0>
+void read_integer(const std::string & s, T & value, data_format fmt)
 {
-	return std::stol(s, pos, base);
+	if (s.empty())
+		return;
+	const auto t = parse_unsigned(s.data(), s.data() + s.size(), fmt);
+	if (!t)
+		throw conversion_error(s, t.error());
+	if (*t > std::numeric_limits<T>::max())
+		throw conversion_error(s, numeric_error::out_of_range);
+	value = static_cast<T>(*t);
 }
 
-template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+template <typename T,
+	typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type
+	= 0>
 void read_integer(const std::string & s, T & value, data_format fmt)
 {
 	if (s.empty())
 		return;
-	std::size_t pos = 0;
-	value = sto<T>(s, &pos, (fmt == data_format::hex) ? 16 : 10);
-	if (pos != s.size())
-		throw std::runtime_error{"invalid string to convert to number: [" + s + "]"};
+	const auto t = parse_signed(s.data(), s.data() + s.size(), fmt);
+	if (!t)
+		throw conversion_error(s, t.error());
+	if ((*t < std::numeric_limits<T>::min()) || (*t > std::numeric_limits<T>::max()))
+		throw conversion_error(s, numeric_error::out_of_range);
+	value = static_cast<T>(*t);
 }
 }
 
@@ -204,10 +288,11 @@ void read(const std::string & s, double & value, data_format fmt)
 	utils::unused(fmt);
 	if (s.empty())
 		return;
-	std::size_t pos = 0;
-	value = std::stod(s, &pos);
-	if (pos != s.size())
-		throw std::runtime_error{"invalid string to convert to double: [" + s + "]"};
+	const auto t = parse_decimal(s.data(), s.data() + s.size());
+	if (!t)
+		throw std::runtime_error{
+			"invalid string to convert to double (" + to_string(t.error()) + "): [" + s + "]"};
+	value = *t;
 }
 
 void read(const std::string & s, std::string & value, data_format fmt)
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <functional>
+#include <stdexcept>
 #include <marnav/nmea/constants.hpp>
 #include <marnav/nmea/string.hpp>
 #include <marnav/utils/optional.hpp>
@@ -94,6 +95,91 @@ inline std::string format(
 
 /// @{
 
+/// Writes the formatted data into the specified buffer, the rendering is the
+/// same as the one of the corresponding `format` function. No memory is allocated
+/// and no terminating zero is written.
+///
+/// If `first` is `nullptr`, nothing is written and `nullptr` returns. This makes
+/// it possible to chain calls and to check only the final result.
+///
+/// @param[in] first Start of the buffer.
+/// @param[in] last End of the buffer (exclusive).
+/// @param[in] data The data to format.
+/// @param[in] width Minimum number of digits.
+/// @param[in] f Base of the data to be rendered in
+/// @return Pointer after the last written character, `nullptr` if the buffer is
+///   too small. In this case the content of the buffer is undefined.
+char * format_to(char * first, char * last, int32_t data, unsigned int width,
+	data_format f = data_format::dec) noexcept;
+
+/// @see format_to(char * first, char * last, int32_t data, unsigned int width, data_format f)
+char * format_to(char * first, char * last, uint64_t data, unsigned int width,
+	data_format f = data_format::dec) noexcept;
+
+/// @see format_to(char * first, char * last, int32_t data, unsigned int width, data_format f)
+char * format_to(char * first, char * last, uint32_t data, unsigned int width,
+	data_format f = data_format::dec) noexcept;
+
+/// Fixed point variant, the parameter `width` specifies the number of decimals.
+///
+/// @see format_to(char * first, char * last, int32_t data, unsigned int width, data_format f)
+char * format_to(char * first, char * last, double data, unsigned int width,
+	data_format f = data_format::none) noexcept;
+
+/// @}
+
+/// @{
+
+/// Writes the data into the specified buffer, the rendering is the same as the
+/// one of the corresponding `to_string` function. No memory is allocated and no
+/// terminating zero is written. Like `format_to`, calls may be chained.
+///
+/// @param[in] first Start of the buffer.
+/// @param[in] last End of the buffer (exclusive).
+/// @param[in] data The data to render.
+/// @return Pointer after the last written character, `nullptr` if the buffer is
+///   too small or `first` is `nullptr`.
+char * to_chars(char * first, char * last, char data) noexcept;
+char * to_chars(char * first, char * last, uint64_t data) noexcept;
+char * to_chars(char * first, char * last, uint32_t data) noexcept;
+char * to_chars(char * first, char * last, int32_t data) noexcept;
+char * to_chars(char * first, char * last, double data) noexcept;
+char * to_chars(char * first, char * last, const std::string & data) noexcept;
+char * to_chars(char * first, char * last, side t) noexcept;
+char * to_chars(char * first, char * last, route t) noexcept;
+char * to_chars(char * first, char * last, selection_mode t) noexcept;
+char * to_chars(char * first, char * last, ais_channel t) noexcept;
+char * to_chars(char * first, char * last, type_of_point t) noexcept;
+char * to_chars(char * first, char * last, direction t) noexcept;
+char * to_chars(char * first, char * last, reference t) noexcept;
+char * to_chars(char * first, char * last, mode_indicator t) noexcept;
+char * to_chars(char * first, char * last, status t) noexcept;
+char * to_chars(char * first, char * last, quality t) noexcept;
+char * to_chars(char * first, char * last, target_status t) noexcept;
+char * to_chars(char * first, char * last, unit::distance t) noexcept;
+char * to_chars(char * first, char * last, unit::velocity t) noexcept;
+char * to_chars(char * first, char * last, unit::temperature t) noexcept;
+char * to_chars(char * first, char * last, unit::pressure t) noexcept;
+char * to_chars(char * first, char * last, const utils::mmsi & t) noexcept;
+char * to_chars(char * first, char * last, const geo::latitude & v) noexcept;
+char * to_chars(char * first, char * last, const geo::longitude & v) noexcept;
+char * to_chars(char * first, char * last, const time & t) noexcept;
+char * to_chars(char * first, char * last, const duration & d) noexcept;
+char * to_chars(char * first, char * last, const date & d) noexcept;
+
+/// Renders nothing if the optional is not set, the same as `to_string` does.
+template <class T>
+inline char * to_chars(char * first, char * last, const utils::optional<T> & data) noexcept
+{
+	if (!data)
+		return first;
+	return to_chars(first, last, data.value());
+}
+
+/// @}
+
+/// @{
+
 void read(const std::string & s, geo::latitude & value, data_format fmt = data_format::none);
 void read(const std::string & s, geo::longitude & value, data_format fmt = data_format::none);
 void read(const std::string & s, date & value, data_format fmt = data_format::none);
@@ -1,11 +1,18 @@
 #include "nmea.hpp"
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <marnav/nmea/angle.hpp>
+#include <marnav/nmea/any_sentence.hpp>
 #include <marnav/nmea/checksum.hpp>
 #include <marnav/nmea/date.hpp>
 #include <marnav/nmea/detail.hpp>
 #include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/sentence_arena.hpp>
+#include <marnav/nmea/sentence_view.hpp>
+#include <marnav/nmea/split.hpp>
 #include <marnav/nmea/time.hpp>
 #include <marnav/nmea/aam.hpp>
 #include <marnav/nmea/alm.hpp>
@@ -98,48 +105,165 @@ namespace nmea
 namespace
 {
 // local macro, used for convenience while registering sentences
-#define REGISTER_SENTENCE(s)                     \
-	{                                            \
-		s::TAG, s::ID, detail::factory::parse<s> \
+#define REGISTER_SENTENCE(s)                                                              \
+	{                                                                                     \
+		s::TAG, s::ID, detail::factory::parse<s>, detail::factory::emplace<s>, sizeof(s), \
+			alignof(s), detail::factory::emplace_variant<s, any_sentence>                 \
 	}
 
 struct entry {
+	using emplace_function = sentence * (*)(void *, talker, sentence::fields::const_iterator,
+		sentence::fields::const_iterator);
+	using emplace_variant_function = void (*)(any_sentence &, talker,
+		sentence::fields::const_iterator, sentence::fields::const_iterator);
+
 	const char * TAG;
 	const sentence_id ID;
 	const sentence::parse_function parse;
+	const emplace_function emplace;
+	const std::size_t size;
+	const std::size_t alignment;
+	const emplace_variant_function emplace_variant;
 };
-static const std::vector<entry> known_sentences = {
-	// regular
-	REGISTER_SENTENCE(aam), REGISTER_SENTENCE(alm), REGISTER_SENTENCE(apa),
-	REGISTER_SENTENCE(apb), REGISTER_SENTENCE(bod), REGISTER_SENTENCE(bwc),
-	REGISTER_SENTENCE(bwr), REGISTER_SENTENCE(bww), REGISTER_SENTENCE(dbk),
-	REGISTER_SENTENCE(dbt), REGISTER_SENTENCE(dpt), REGISTER_SENTENCE(dsc),
-	REGISTER_SENTENCE(dse), REGISTER_SENTENCE(dtm), REGISTER_SENTENCE(fsi),
-	REGISTER_SENTENCE(gbs), REGISTER_SENTENCE(gga), REGISTER_SENTENCE(glc),
-	REGISTER_SENTENCE(gll), REGISTER_SENTENCE(grs), REGISTER_SENTENCE(gns),
-	REGISTER_SENTENCE(gsa), REGISTER_SENTENCE(gst), REGISTER_SENTENCE(gsv),
-	REGISTER_SENTENCE(gtd), REGISTER_SENTENCE(hdg), REGISTER_SENTENCE(hfb),
-	REGISTER_SENTENCE(hdm), REGISTER_SENTENCE(hdt), REGISTER_SENTENCE(hsc),
-	REGISTER_SENTENCE(its), REGISTER_SENTENCE(lcd), REGISTER_SENTENCE(msk),
-	REGISTER_SENTENCE(mss), REGISTER_SENTENCE(mtw), REGISTER_SENTENCE(mwd),
-	REGISTER_SENTENCE(mwv), REGISTER_SENTENCE(osd), REGISTER_SENTENCE(r00),
-	REGISTER_SENTENCE(rma), REGISTER_SENTENCE(rmb), REGISTER_SENTENCE(rmc),
-	REGISTER_SENTENCE(rot), REGISTER_SENTENCE(rpm), REGISTER_SENTENCE(rsa),
-	REGISTER_SENTENCE(rsd), REGISTER_SENTENCE(rte), REGISTER_SENTENCE(sfi),
-	REGISTER_SENTENCE(stn), REGISTER_SENTENCE(tds), REGISTER_SENTENCE(tfi),
-	REGISTER_SENTENCE(tll), REGISTER_SENTENCE(tpc), REGISTER_SENTENCE(tpr),
-	REGISTER_SENTENCE(tpt), REGISTER_SENTENCE(ttm), REGISTER_SENTENCE(vbw),
-	REGISTER_SENTENCE(vdm), REGISTER_SENTENCE(vdo), REGISTER_SENTENCE(vdr),
-	REGISTER_SENTENCE(vhw), REGISTER_SENTENCE(vlw), REGISTER_SENTENCE(vpw),
-	REGISTER_SENTENCE(vtg), REGISTER_SENTENCE(vwr), REGISTER_SENTENCE(wcv),
-	REGISTER_SENTENCE(wnc), REGISTER_SENTENCE(wpl), REGISTER_SENTENCE(xdr),
-	REGISTER_SENTENCE(xte), REGISTER_SENTENCE(xtr), REGISTER_SENTENCE(zda),
-	REGISTER_SENTENCE(zdl), REGISTER_SENTENCE(zfo), REGISTER_SENTENCE(ztg),
-
-	// vendor extensions
-	REGISTER_SENTENCE(pgrme), REGISTER_SENTENCE(pgrmm), REGISTER_SENTENCE(pgrmz),
-	REGISTER_SENTENCE(stalk)};
+
+/// Returns the registry of all known sentences.
+///
+/// The registry is a function local static, which makes it safe to use
+/// during static initialization of other translation units.
+static const std::vector<entry> & known_sentences()
+{
+	static const std::vector<entry> entries = {
+		// regular
+		REGISTER_SENTENCE(aam), REGISTER_SENTENCE(alm), REGISTER_SENTENCE(apa),
+		REGISTER_SENTENCE(apb), REGISTER_SENTENCE(bod), REGISTER_SENTENCE(bwc),
+		REGISTER_SENTENCE(bwr), REGISTER_SENTENCE(bww), REGISTER_SENTENCE(dbk),
+		REGISTER_SENTENCE(dbt), REGISTER_SENTENCE(dpt), REGISTER_SENTENCE(dsc),
+		REGISTER_SENTENCE(dse), REGISTER_SENTENCE(dtm), REGISTER_SENTENCE(fsi),
+		REGISTER_SENTENCE(gbs), REGISTER_SENTENCE(gga), REGISTER_SENTENCE(glc),
+		REGISTER_SENTENCE(gll), REGISTER_SENTENCE(grs), REGISTER_SENTENCE(gns),
+		REGISTER_SENTENCE(gsa), REGISTER_SENTENCE(gst), REGISTER_SENTENCE(gsv),
+		REGISTER_SENTENCE(gtd), REGISTER_SENTENCE(hdg), REGISTER_SENTENCE(hfb),
+		REGISTER_SENTENCE(hdm), REGISTER_SENTENCE(hdt), REGISTER_SENTENCE(hsc),
+		REGISTER_SENTENCE(its), REGISTER_SENTENCE(lcd), REGISTER_SENTENCE(msk),
+		REGISTER_SENTENCE(mss), REGISTER_SENTENCE(mtw), REGISTER_SENTENCE(mwd),
+		REGISTER_SENTENCE(mwv), REGISTER_SENTENCE(osd), REGISTER_SENTENCE(r00),
+		REGISTER_SENTENCE(rma), REGISTER_SENTENCE(rmb), REGISTER_SENTENCE(rmc),
+		REGISTER_SENTENCE(rot), REGISTER_SENTENCE(rpm), REGISTER_SENTENCE(rsa),
+		REGISTER_SENTENCE(rsd), REGISTER_SENTENCE(rte), REGISTER_SENTENCE(sfi),
+		REGISTER_SENTENCE(stn), REGISTER_SENTENCE(tds), REGISTER_SENTENCE(tfi),
+		REGISTER_SENTENCE(tll), REGISTER_SENTENCE(tpc), REGISTER_SENTENCE(tpr),
+		REGISTER_SENTENCE(tpt), REGISTER_SENTENCE(ttm), REGISTER_SENTENCE(vbw),
+		REGISTER_SENTENCE(vdm), REGISTER_SENTENCE(vdo), REGISTER_SENTENCE(vdr),
+		REGISTER_SENTENCE(vhw), REGISTER_SENTENCE(vlw), REGISTER_SENTENCE(vpw),
+		REGISTER_SENTENCE(vtg), REGISTER_SENTENCE(vwr), REGISTER_SENTENCE(wcv),
+		REGISTER_SENTENCE(wnc), REGISTER_SENTENCE(wpl), REGISTER_SENTENCE(xdr),
+		REGISTER_SENTENCE(xte), REGISTER_SENTENCE(xtr), REGISTER_SENTENCE(zda),
+		REGISTER_SENTENCE(zdl), REGISTER_SENTENCE(zfo), REGISTER_SENTENCE(ztg),
+
+		// vendor extensions
+		REGISTER_SENTENCE(pgrme), REGISTER_SENTENCE(pgrmm), REGISTER_SENTENCE(pgrmz),
+		REGISTER_SENTENCE(stalk)};
+	return entries;
+}
 #undef REGISTER_SENTENCE
+
+/// Packs a tag of up to 8 characters into an integer, the first character
+/// in the most significant byte. Returns 0 for empty or longer tags.
+///
+/// All registered tags are at most 5 characters long, therefore the packed
+/// value identifies a tag uniquely.
+static uint64_t pack_tag(const char * tag, std::size_t n) noexcept
+{
+	if ((n == 0u) || (n > sizeof(uint64_t)))
+		return 0u;
+	uint64_t key = 0u;
+	for (std::size_t i = 0; i < n; ++i)
+		key = (key << 8) | static_cast<uint8_t>(tag[i]);
+	return key;
+}
+
+/// Lookup tables for the known sentences, by tag and by ID.
+///
+/// The tag table is an open addressing hash table over the packed tags, with
+/// more than twice as many slots as there are sentences. It is built once at
+/// startup, lookups need on average about one probe and no string comparison.
+/// The ID table maps the sentence ID directly to the index of the entry.
+class sentence_index
+{
+public:
+	static constexpr std::size_t none = 0xff;
+
+	sentence_index()
+	{
+		for (auto & slot : tag_table_)
+			slot = slot_entry{0u, none};
+		for (auto & slot : id_table_)
+			slot = static_cast<uint8_t>(none);
+
+		for (std::size_t i = 0; i < known_sentences().size(); ++i) {
+			const auto & e = known_sentences()[i];
+			const uint64_t key = pack_tag(e.TAG, std::strlen(e.TAG));
+			std::size_t h = hash(key);
+			while (tag_table_[h].index != none)
+				h = (h + 1) & (tag_slots - 1);
+			tag_table_[h] = slot_entry{key, i};
+
+			const auto id = static_cast<std::size_t>(e.ID);
+			if (id < id_slots)
+				id_table_[id] = static_cast<uint8_t>(i);
+		}
+	}
+
+	/// Returns the index of the entry with the specified tag, or `none`.
+	std::size_t find(const char * tag, std::size_t n) const noexcept
+	{
+		const uint64_t key = pack_tag(tag, n);
+		if (key == 0u)
+			return none;
+		for (std::size_t h = hash(key);; h = (h + 1) & (tag_slots - 1)) {
+			const auto & slot = tag_table_[h];
+			if (slot.index == none)
+				return none;
+			if (slot.key == key)
+				return slot.index;
+		}
+	}
+
+	/// Returns the index of the entry with the specified ID, or `none`.
+	std::size_t find(sentence_id id) const noexcept
+	{
+		const auto i = static_cast<std::size_t>(id);
+		return (i < id_slots) ? id_table_[i] : none;
+	}
+
+private:
+	static constexpr std::size_t tag_slots = 256; // must be a power of two
+	static constexpr std::size_t id_slots = static_cast<std::size_t>(sentence_id::STALK) + 1;
+
+	struct slot_entry {
+		uint64_t key;
+		std::size_t index;
+	};
+
+	static std::size_t hash(uint64_t key) noexcept
+	{
+		// multiplicative hashing, the upper bits are well mixed
+		return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> 56) & (tag_slots - 1);
+	}
+
+	slot_entry tag_table_[tag_slots];
+	uint8_t id_table_[id_slots];
+};
+
+constexpr std::size_t sentence_index::none;
+constexpr std::size_t sentence_index::tag_slots;
+constexpr std::size_t sentence_index::id_slots;
+
+static const sentence_index & known_sentences_index()
+{
+	static const sentence_index index;
+	return index;
+}
 }
 
 /// @endcond
@@ -148,27 +272,18 @@ static const std::vector<entry> known_sentences = {
 namespace detail
 {
 /// Searches in the known sentences for the entry carrying the specified tag.
-static std::vector<entry>::const_iterator find_tag(const std::string & tag)
+static std::vector<entry>::const_iterator find_tag(const char * tag, std::size_t n)
 {
-	return std::find_if(std::begin(known_sentences), std::end(known_sentences),
-		[tag](const entry & e) { return e.TAG == tag; });
+	const auto i = known_sentences_index().find(tag, n);
+	if (i == sentence_index::none)
+		return std::end(known_sentences());
+	return std::next(std::begin(known_sentences()), i);
 }
 
-/// Returns the parse function of a particular sentence.
-///
-/// If an unknown sentence tag is specified, an exception is thrown.
-///
-/// @param[in] tag The tag of the sentence to get the parse function for.
-/// @return The parse function of the specified sentence.
-/// @exception std::unknown_sentence The specified tag could not be found,
-///   the argument cannot be processed.
-static sentence::parse_function find_parse_func(const std::string & tag)
+/// Searches in the known sentences for the entry carrying the specified tag.
+static std::vector<entry>::const_iterator find_tag(const std::string & tag)
 {
-	const auto i = find_tag(tag);
-	if (i == std::end(known_sentences))
-		throw unknown_sentence{"unknown sentence in nmea/find_parse_func: " + tag};
-
-	return i->parse;
+	return find_tag(tag.data(), tag.size());
 }
 
 /// Checks if the address field of the specified sentence is a vendor extension or
@@ -190,7 +305,7 @@ std::tuple<talker, std::string> parse_address(const std::string & address)
 
 	// if the address is found as-is, it's a proprietary sentence, respectively
 	// an address without a talker.
-	if (find_tag(address) != std::end(known_sentences))
+	if (find_tag(address) != std::end(known_sentences()))
 		return make_tuple(talker_id::none, address);
 
 	// if the address looks like a regular address, we search for it, if not, it's an error
@@ -198,16 +313,46 @@ std::tuple<talker, std::string> parse_address(const std::string & address)
 		throw std::invalid_argument{"unknown or malformed address field: [" + address + "]"};
 
 	const auto tag = address.substr(2, 3);
-	if (find_tag(tag) == std::end(known_sentences))
+	if (find_tag(tag) == std::end(known_sentences()))
 		throw std::invalid_argument("unknown regular tag in address: [" + address + "]");
 	return make_tuple(make_talker(address.substr(0, 2)), tag);
 }
 
+/// Raw buffer variant of `parse_address`, which does not allocate and reports
+/// errors instead of throwing. Instead of the tag, the sentence ID is returned.
+///
+/// @param[in] address The address field of a sentence.
+/// @param[in] n Size of the address field.
+/// @param[out] talk The talker, `talker::none` for vendor extensions.
+/// @param[out] id The ID of the sentence.
+/// @retval true  Success.
+/// @retval false The address is malformed or the sentence is not supported.
+bool parse_address(
+	const char * address, std::size_t n, talker & talk, sentence_id & id) noexcept
+{
+	auto i = find_tag(address, n);
+	if (i != std::end(known_sentences())) {
+		talk = talker_id::none;
+		id = i->ID;
+		return true;
+	}
+
+	if (n != 5u) // talker ID:2 + tag:3
+		return false;
+
+	i = find_tag(address + 2, 3u);
+	if (i == std::end(known_sentences()))
+		return false;
+	talk = make_talker(address[0], address[1]);
+	id = i->ID;
+	return true;
+}
+
 /// Computes and checks the checksum of the specified sentence against the
-/// expected checksum.
+/// expected checksum, which is read from the sentence (the field after the end
+/// token) together with the computation of the checksum (see `scan_checksum`).
 ///
 /// @param[in] s Sentence to check.
-/// @param[in] expected The expected checksum to test against.
 /// @param[in] start_pos Position within the sentence to start with computation of the checksum.
 /// @exception checksum_error Thrown if the checksum does not match.
 /// @exception std::invalid_argument Arguments were invalid.
@@ -219,18 +364,21 @@ std::tuple<talker, std::string> parse_address(const std::string & address)
 /// @todo Parameters s/start_pos should be replaced with `string_view`, but not available in
 /// C++11.
 ///
-void ensure_checksum(
-	const std::string & s, const std::string & expected, std::string::size_type start_pos)
+void ensure_checksum(const std::string & s, std::string::size_type start_pos)
 {
-	const auto end_pos = s.find_first_of(sentence::end_token, start_pos);
-	if (end_pos == std::string::npos) // end token not found
+	if (start_pos > s.size())
 		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
-	if (s.size() != end_pos + 3) // short or no checksum
-		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
-	const uint8_t expected_checksum = static_cast<uint8_t>(std::stoul(expected, nullptr, 16));
-	const uint8_t sum = checksum(begin(s) + start_pos, begin(s) + end_pos);
-	if (expected_checksum != sum)
-		throw checksum_error{expected_checksum, sum};
+	const auto r = scan_checksum(s.data() + start_pos, s.data() + s.size());
+	switch (r.result) {
+		case checksum_scan::status::ok:
+			return;
+		case checksum_scan::status::mismatch:
+			throw checksum_error{r.expected, r.actual};
+		case checksum_scan::status::no_end_token:
+		case checksum_scan::status::invalid_format:
+			break;
+	}
+	throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
 }
 
 /// @note This function must be defined here, not in the file detail.cpp,
@@ -245,6 +393,193 @@ void check_raw_sentence(const std::string & s)
 		&& (s[0] != sentence::tag_block_token))
 		throw std::invalid_argument{"no start token in nmea/make_sentence"};
 }
+
+/// Result of the pre-processing of a raw sentence. All data refers to the
+/// raw buffer.
+struct raw_sentence {
+	const char * tag_block = nullptr;
+	std::size_t tag_block_size = 0u;
+	std::array<field_view, max_fields> fields;
+	std::size_t num_fields = 0u;
+	talker talk{talker_id::none};
+	std::vector<entry>::const_iterator info;
+	uint8_t expected_checksum = 0u;
+	uint8_t actual_checksum = 0u;
+};
+
+/// Same as `parse_address` but works on the field view of the raw sentence and
+/// reports errors instead of throwing. Instead of the tag, the registry entry is
+/// stored, which saves a second lookup and any temporary strings.
+static parse_error parse_address(raw_sentence & r)
+{
+	const field_view & address = r.fields[0];
+	if (address.empty())
+		return parse_error::invalid_address;
+
+	r.info = find_tag(address.data, address.size);
+	if (r.info != std::end(known_sentences())) {
+		r.talk = talker_id::none;
+		return parse_error::none;
+	}
+
+	if (address.size != 5u) // talker ID:2 + tag:3
+		return parse_error::invalid_address;
+
+	r.info = find_tag(address.data + 2, 3u);
+	if (r.info == std::end(known_sentences()))
+		return parse_error::unknown_sentence;
+	r.talk = make_talker(address.data[0], address.data[1]);
+	return parse_error::none;
+}
+
+/// Raw buffer variant of `ensure_checksum`, reads the expected checksum directly
+/// from the buffer (the two characters after the end token). Reports errors instead
+/// of throwing.
+///
+/// @see ensure_checksum(const std::string &, std::string::size_type)
+static parse_error ensure_checksum(
+	const char * s, std::size_t n, std::size_t start_pos, raw_sentence & r) noexcept
+{
+	if (start_pos > n)
+		return parse_error::invalid_checksum;
+	const auto t = scan_checksum(s + start_pos, s + n);
+	r.expected_checksum = t.expected;
+	r.actual_checksum = t.actual;
+	switch (t.result) {
+		case checksum_scan::status::ok:
+			return parse_error::none;
+		case checksum_scan::status::mismatch:
+			return parse_error::checksum_mismatch;
+		case checksum_scan::status::no_end_token:
+		case checksum_scan::status::invalid_format:
+			break;
+	}
+	return parse_error::invalid_checksum;
+}
+
+/// Performs all checks on the raw sentence which are necessary before the
+/// sentence itself can be constructed: start token, tag block, fields,
+/// checksum and address.
+///
+/// The raw sentence is split into fields without copying (see `detail::split_fields`),
+/// the checksum and the address are processed directly within the buffer.
+///
+/// @param[in] s The buffer containing the raw sentence.
+/// @param[in] n Size of the raw sentence.
+/// @param[in] chksum Checksum handling strategy.
+/// @param[out] r The extracted information, valid only if no error is returned.
+/// @return The error found, `parse_error::none` on success.
+static parse_error scan_sentence(
+	const char * s, std::size_t n, checksum_handling chksum, raw_sentence & r)
+{
+	if (!s || (n == 0u))
+		return parse_error::empty;
+	if ((s[0] != sentence::start_token) && (s[0] != sentence::start_token_ais)
+		&& (s[0] != sentence::tag_block_token))
+		return parse_error::no_start_token;
+
+	// handle tag block
+	std::size_t search_pos = 1u; // ignore start token
+	if (s[0] == sentence::tag_block_token) {
+		const char * const i
+			= static_cast<const char *>(std::memchr(s + 1, sentence::tag_block_token, n - 1));
+		if (i != nullptr) {
+			r.tag_block = s + 1;
+			r.tag_block_size = static_cast<std::size_t>(i - r.tag_block);
+			search_pos += r.tag_block_size + 2u; // next after tag block end token
+		}
+	}
+
+	// extract all fields, skip start token
+	r.num_fields = split_fields(s, n, r.fields.data(), r.fields.size(), search_pos);
+	if (r.num_fields < 2) // at least address and checksum must be present
+		return parse_error::malformed;
+	if (r.num_fields > r.fields.size())
+		return parse_error::malformed;
+
+	if (chksum == checksum_handling::check) {
+		const auto e = ensure_checksum(s, n, search_pos, r);
+		if (e != parse_error::none)
+			return e;
+	}
+
+	return parse_address(r);
+}
+
+/// Throws the exception corresponding to the specified error, as it was
+/// thrown by `make_sentence` ever since.
+[[noreturn]] static void throw_parse_error(parse_error e, const raw_sentence & r)
+{
+	switch (e) {
+		case parse_error::none:
+			break;
+		case parse_error::empty:
+			throw std::invalid_argument{"empty string in nmea/make_sentence"};
+		case parse_error::no_start_token:
+			throw std::invalid_argument{"no start token in nmea/make_sentence"};
+		case parse_error::malformed:
+			throw std::invalid_argument{"malformed sentence in nmea/make_sentence"};
+		case parse_error::invalid_checksum:
+			throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
+		case parse_error::checksum_mismatch:
+			throw checksum_error{r.expected_checksum, r.actual_checksum};
+		case parse_error::invalid_address:
+			if (r.fields[0].empty())
+				throw std::invalid_argument{"invalid/malformed address in nmea/parse_address"};
+			throw std::invalid_argument{
+				"unknown or malformed address field: [" + r.fields[0].str() + "]"};
+		case parse_error::unknown_sentence:
+			throw std::invalid_argument(
+				"unknown regular tag in address: [" + r.fields[0].str() + "]");
+		case parse_error::invalid_data:
+			break;
+	}
+	throw std::invalid_argument{"invalid sentence in nmea/make_sentence"};
+}
+
+/// Returns the data fields of the pre-processed raw sentence, without address
+/// and checksum.
+///
+/// A per thread buffer is used, whose strings keep their capacity from call to call.
+static const sentence::fields & data_fields(const raw_sentence & r)
+{
+	static thread_local sentence::fields data;
+	data.resize(r.num_fields - 2);
+	for (std::size_t k = 0; k < data.size(); ++k)
+		data[k].assign(r.fields[k + 1].data, r.fields[k + 1].size);
+	return data;
+}
+
+/// Constructs the sentence from the pre-processed raw sentence.
+static std::unique_ptr<sentence> construct_sentence(const raw_sentence & r)
+{
+	const auto & data = data_fields(r);
+	auto result = r.info->parse(r.talk, std::begin(data), std::end(data));
+	if (r.tag_block_size > 0u)
+		result->set_tag_block(std::string(r.tag_block, r.tag_block_size));
+	return result;
+}
+
+/// Constructs the sentence from the pre-processed raw sentence within the arena.
+static sentence * construct_sentence(sentence_arena & arena, const raw_sentence & r)
+{
+	const auto & data = data_fields(r);
+	sentence * result = arena.emplace(r.info->size, r.info->alignment, [&](void * p) {
+		return r.info->emplace(p, r.talk, std::begin(data), std::end(data));
+	});
+	if (r.tag_block_size > 0u)
+		result->set_tag_block(std::string(r.tag_block, r.tag_block_size));
+	return result;
+}
+
+/// Constructs the sentence from the pre-processed raw sentence within the variant.
+static void construct_sentence(any_sentence & result, const raw_sentence & r)
+{
+	const auto & data = data_fields(r);
+	r.info->emplace_variant(result, r.talk, std::begin(data), std::end(data));
+	if (r.tag_block_size > 0u)
+		as_sentence(result).set_tag_block(std::string(r.tag_block, r.tag_block_size));
+}
 }
 /// @endcond
 
@@ -252,8 +587,8 @@ void check_raw_sentence(const std::string & s)
 std::vector<std::string> get_supported_sentences_str()
 {
 	std::vector<std::string> v;
-	v.reserve(std::distance(std::begin(known_sentences), std::end(known_sentences)));
-	for (const auto & s : known_sentences) {
+	v.reserve(std::distance(std::begin(known_sentences()), std::end(known_sentences())));
+	for (const auto & s : known_sentences()) {
 		v.push_back(s.TAG);
 	}
 	return v;
@@ -263,8 +598,8 @@ std::vector<std::string> get_supported_sentences_str()
 std::vector<sentence_id> get_supported_sentences_id()
 {
 	std::vector<sentence_id> v;
-	v.reserve(std::distance(std::begin(known_sentences), std::end(known_sentences)));
-	for (const auto & s : known_sentences) {
+	v.reserve(std::distance(std::begin(known_sentences()), std::end(known_sentences())));
+	for (const auto & s : known_sentences()) {
 		v.push_back(s.ID);
 	}
 	return v;
@@ -274,12 +609,11 @@ std::vector<sentence_id> get_supported_sentences_id()
 /// an exception is thrown.
 std::string to_string(sentence_id id)
 {
-	auto i = std::find_if(std::begin(known_sentences), std::end(known_sentences),
-		[id](const entry & e) { return e.ID == id; });
-	if (i == std::end(known_sentences))
+	const auto i = known_sentences_index().find(id);
+	if (i == sentence_index::none)
 		throw unknown_sentence{"unknown sentence"};
 
-	return i->TAG;
+	return known_sentences()[i].TAG;
 }
 
 /// Returns the ID of the specified tag. If the sentence is unknown,
@@ -287,7 +621,7 @@ std::string to_string(sentence_id id)
 sentence_id tag_to_id(const std::string & tag)
 {
 	const auto i = detail::find_tag(tag);
-	if (i == std::end(known_sentences))
+	if (i == std::end(known_sentences()))
 		throw unknown_sentence{"unknown sentence: " + tag};
 
 	return i->ID;
@@ -315,17 +649,355 @@ sentence_id tag_to_id(const std::string & tag)
 /// @endcode
 std::unique_ptr<sentence> make_sentence(const std::string & s, checksum_handling chksum)
 {
-	talker talk{talker_id::none};
-	std::string tag;
-	std::string tag_block;
-	std::vector<std::string> fields;
-	std::tie(talk, tag, tag_block, fields) = detail::extract_sentence_information(s, chksum);
-	auto result = detail::find_parse_func(tag)(
-		talk, std::next(std::begin(fields)), std::prev(std::end(fields)));
-	result->set_tag_block(tag_block);
+	return make_sentence(s.data(), s.size(), chksum);
+}
+
+/// Parses the raw sentence in the specified buffer and returns the corresponding
+/// sentence.
+///
+/// The raw sentence is processed directly within the buffer, without copying
+/// the fields (see `detail::scan_sentence`).
+///
+/// @param[in] s The buffer containing the raw sentence, does not have to be
+///   null terminated.
+/// @param[in] n Size of the raw sentence.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The object of the corresponding type.
+/// @exception checksum_error Will be thrown if the checksum is wrong.
+/// @exception std::invalid_argument Will be thrown if the specified string
+///   is not a NMEA sentence (malformed).
+/// @exception unknown_sentence Will be thrown if the sentence is not supported.
+std::unique_ptr<sentence> make_sentence(
+	const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		detail::throw_parse_error(e, r);
+	return detail::construct_sentence(r);
+}
+
+/// Parses the string and returns the corresponding sentence, or an error if the
+/// string is not a valid or supported sentence.
+///
+/// In contrast to `make_sentence`, this function does not throw exceptions on
+/// malformed input. Errors in framing, checksum and address are detected without
+/// exceptions at all, which is the common case on noisy links. Errors in the
+/// contents of data fields, detected by the sentences themselves, are reported
+/// as `parse_error::invalid_data`.
+///
+/// @param[in] s The sentence to parse.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The sentence or the error.
+///
+/// Example:
+/// @code
+///   auto s = nmea::try_make_sentence("$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A");
+///   if (s) {
+///       std::cout << (*s)->tag() << "\n";
+///   } else {
+///       std::cout << nmea::to_string(s.error()) << "\n";
+///   }
+/// @endcode
+utils::expected<std::unique_ptr<sentence>, parse_error> try_make_sentence(
+	const std::string & s, checksum_handling chksum)
+{
+	return try_make_sentence(s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see try_make_sentence(const std::string & s, checksum_handling chksum)
+utils::expected<std::unique_ptr<sentence>, parse_error> try_make_sentence(
+	const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		return utils::make_unexpected(e);
+
+	try {
+		return detail::construct_sentence(r);
+	} catch (const std::logic_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	} catch (const std::runtime_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	}
+}
+
+/// Parses the string and constructs the corresponding sentence within the
+/// specified arena. Apart from the memory management, this is the same as the
+/// regular `make_sentence`.
+///
+/// @param[in,out] arena The arena to construct the sentence in.
+/// @param[in] s The sentence to parse.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The object of the corresponding type, owned by the arena. It is valid
+///   until the arena is reset or destroyed.
+/// @exception checksum_error Will be thrown if the checksum is wrong.
+/// @exception std::invalid_argument Will be thrown if the specified string
+///   is not a NMEA sentence (malformed).
+/// @exception unknown_sentence Will be thrown if the sentence is not supported.
+///
+/// Example:
+/// @code
+///   nmea::sentence_arena arena;
+///   auto s = nmea::make_sentence(arena, "$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A");
+///   ...
+///   arena.reset(); // `s` is no longer valid
+/// @endcode
+sentence * make_sentence(
+	sentence_arena & arena, const std::string & s, checksum_handling chksum)
+{
+	return make_sentence(arena, s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see make_sentence(sentence_arena & arena, const std::string & s, checksum_handling chksum)
+sentence * make_sentence(
+	sentence_arena & arena, const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		detail::throw_parse_error(e, r);
+	return detail::construct_sentence(arena, r);
+}
+
+/// Parses the string and constructs the corresponding sentence within the
+/// specified arena, or returns an error. Apart from the memory management, this
+/// is the same as the regular `try_make_sentence`.
+///
+/// @see make_sentence(sentence_arena & arena, const std::string & s, checksum_handling chksum)
+/// @see try_make_sentence(const std::string & s, checksum_handling chksum)
+utils::expected<sentence *, parse_error> try_make_sentence(
+	sentence_arena & arena, const std::string & s, checksum_handling chksum)
+{
+	return try_make_sentence(arena, s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see try_make_sentence(sentence_arena & arena, const std::string & s,
+///   checksum_handling chksum)
+utils::expected<sentence *, parse_error> try_make_sentence(
+	sentence_arena & arena, const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		return utils::make_unexpected(e);
+
+	try {
+		return detail::construct_sentence(arena, r);
+	} catch (const std::logic_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	} catch (const std::runtime_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	}
+}
+
+/// Parses the string and returns the corresponding sentence by value. Apart
+/// from the type of the result, this is the same as `make_sentence`.
+///
+/// @param[in] s The sentence to parse.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The variant holding the sentence of the corresponding type.
+/// @exception checksum_error Will be thrown if the checksum is wrong.
+/// @exception std::invalid_argument Will be thrown if the specified string
+///   is not a NMEA sentence (malformed).
+/// @exception unknown_sentence Will be thrown if the sentence is not supported.
+///
+/// Example:
+/// @code
+///   auto s = nmea::make_any_sentence("$IIMTW,9.5,C*2F");
+///   if (auto mtw = utils::get_if<nmea::mtw>(&s)) {
+///       ...
+///   }
+/// @endcode
+any_sentence make_any_sentence(const std::string & s, checksum_handling chksum)
+{
+	return make_any_sentence(s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see make_any_sentence(const std::string & s, checksum_handling chksum)
+any_sentence make_any_sentence(const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		detail::throw_parse_error(e, r);
+	any_sentence result;
+	detail::construct_sentence(result, r);
 	return result;
 }
 
+/// Parses the string and returns the corresponding sentence by value, or an error.
+/// Apart from the type of the result, this is the same as `try_make_sentence`.
+///
+/// @see try_make_sentence(const std::string & s, checksum_handling chksum)
+utils::expected<any_sentence, parse_error> try_make_any_sentence(
+	const std::string & s, checksum_handling chksum)
+{
+	return try_make_any_sentence(s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see try_make_any_sentence(const std::string & s, checksum_handling chksum)
+utils::expected<any_sentence, parse_error> try_make_any_sentence(
+	const char * s, std::size_t n, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		return utils::make_unexpected(e);
+
+	try {
+		any_sentence result;
+		detail::construct_sentence(result, r);
+		return result;
+	} catch (const std::logic_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	} catch (const std::runtime_error &) {
+		return utils::make_unexpected(parse_error::invalid_data);
+	}
+}
+
+/// Parses the raw sentence into the specified variant, which is reused from call to
+/// call. This is the exception-free variant of `make_any_sentence` which does not
+/// construct a new variant for each sentence.
+///
+/// @param[in] s The buffer containing the raw sentence, without end of line.
+/// @param[in] n Size of the raw sentence.
+/// @param[out] result The sentence, valid only if no error is returned. In case of
+///   an error, the previous content may be lost.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The error found, `parse_error::none` on success.
+parse_error decode_sentence(
+	const char * s, std::size_t n, any_sentence & result, checksum_handling chksum)
+{
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		return e;
+
+	try {
+		detail::construct_sentence(result, r);
+	} catch (const std::logic_error &) {
+		return parse_error::invalid_data;
+	} catch (const std::runtime_error &) {
+		return parse_error::invalid_data;
+	}
+	return parse_error::none;
+}
+
+/// Checks the raw sentence and returns a view of it, without decoding the data fields.
+///
+/// The same checks as by `try_make_sentence` are performed, except the ones on the
+/// content of the data fields, which are done on request by the view.
+///
+/// @param[in] s The sentence to check, must outlive the view.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The view of the sentence or the error found.
+///
+/// @see sentence_view
+utils::expected<sentence_view, parse_error> try_make_sentence_view(
+	const std::string & s, checksum_handling chksum)
+{
+	return try_make_sentence_view(s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see try_make_sentence_view(const std::string & s, checksum_handling chksum)
+utils::expected<sentence_view, parse_error> try_make_sentence_view(
+	const char * s, std::size_t n, checksum_handling chksum)
+{
+	static_assert(sentence_view::max_fields == detail::max_fields, "inconsistent max_fields");
+
+	// offsets within the view are stored in 16 bits
+	if (n > std::numeric_limits<uint16_t>::max())
+		return utils::make_unexpected(parse_error::malformed);
+
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	if (e != parse_error::none)
+		return utils::make_unexpected(e);
+
+	sentence_view v;
+	v.data_ = s;
+	v.id_ = r.info->ID;
+	v.talker_ = r.talk;
+	if (r.tag_block_size > 0u) {
+		v.tag_block_begin_ = static_cast<uint16_t>(r.tag_block - s);
+		v.tag_block_size_ = static_cast<uint16_t>(r.tag_block_size);
+	}
+	v.num_fields_ = static_cast<uint16_t>(r.num_fields);
+	for (std::size_t i = 0; i < r.num_fields; ++i)
+		v.field_begin_[i] = static_cast<uint16_t>(r.fields[i].data - s);
+	return v;
+}
+
+/// Checks the raw sentence and returns a view of it, without decoding the data fields.
+///
+/// @param[in] s The sentence to check, must outlive the view.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The view of the sentence.
+/// @exception checksum_error Will be thrown if the checksum is wrong.
+/// @exception std::invalid_argument Will be thrown if the specified string
+///   is not a NMEA sentence (malformed).
+///
+/// @see try_make_sentence_view(const std::string & s, checksum_handling chksum)
+sentence_view make_sentence_view(const std::string & s, checksum_handling chksum)
+{
+	return make_sentence_view(s.data(), s.size(), chksum);
+}
+
+/// Raw buffer variant.
+///
+/// @see make_sentence_view(const std::string & s, checksum_handling chksum)
+sentence_view make_sentence_view(const char * s, std::size_t n, checksum_handling chksum)
+{
+	auto v = try_make_sentence_view(s, n, chksum);
+	if (v)
+		return *v;
+
+	// scan again in case of an error, for the details needed by the exception
+	detail::raw_sentence r;
+	const auto e = detail::scan_sentence(s, n, chksum, r);
+	detail::throw_parse_error((e != parse_error::none) ? e : v.error(), r);
+}
+
+/// Returns a textual description of the specified error.
+std::string to_string(parse_error e)
+{
+	switch (e) {
+		case parse_error::none:
+			return "none";
+		case parse_error::empty:
+			return "empty sentence";
+		case parse_error::no_start_token:
+			return "no start token";
+		case parse_error::malformed:
+			return "malformed sentence";
+		case parse_error::invalid_checksum:
+			return "invalid checksum format";
+		case parse_error::checksum_mismatch:
+			return "checksum mismatch";
+		case parse_error::invalid_address:
+			return "invalid address";
+		case parse_error::unknown_sentence:
+			return "unknown sentence";
+		case parse_error::invalid_data:
+			return "invalid data";
+	}
+	return "unknown error";
+}
+
 /// Extracts and returns the sentence ID of the specified raw NMEA sentence.
 ///
 /// This function does not check the checksum.
@@ -335,6 +1007,16 @@ std::unique_ptr<sentence> make_sentence(const std::string & s, checksum_handling
 /// @exception std::invalid_argument Thrown if the sentence is in invalid form.
 sentence_id extract_id(const std::string & s)
 {
+	// fast path, without temporary strings
+	const char * address = nullptr;
+	std::size_t size = 0u;
+	talker talk{talker_id::none};
+	sentence_id id = sentence_id::NONE;
+	if (detail::find_address(s.data(), s.size(), address, size)
+		&& detail::parse_address(address, size, talk, id))
+		return id;
+
+	// otherwise, find out what is wrong
 	detail::check_raw_sentence(s);
 
 	std::string::size_type search_pos = 0;
@@ -351,7 +1033,6 @@ sentence_id extract_id(const std::string & s)
 	if (pos == std::string::npos)
 		throw std::invalid_argument{"malformed sentence in extract_id"};
 
-	talker talk{talker_id::none};
 	std::string tag;
 	std::tie(talk, tag) = detail::parse_address(s.substr(search_pos + 1, pos - search_pos - 1));
 
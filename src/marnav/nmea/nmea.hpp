@@ -1,11 +1,14 @@
 #ifndef MARNAV__NMEA__NMEA__HPP
 #define MARNAV__NMEA__NMEA__HPP
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
+#include <stdexcept>
 #include <marnav/nmea/sentence_id.hpp>
 #include <marnav/nmea/checksum_enum.hpp>
+#include <marnav/utils/expected.hpp>
 
 namespace marnav
 {
@@ -63,11 +66,48 @@ public:
 	using logic_error::logic_error;
 };
 
+/// Errors reported by the exception-free parsing functions.
+enum class parse_error {
+	none, ///< No error.
+	empty, ///< The sentence is empty.
+	no_start_token, ///< The start token is missing.
+	malformed, ///< Too few or too many fields.
+	invalid_checksum, ///< The checksum is missing or malformed.
+	checksum_mismatch, ///< The checksum is wrong.
+	invalid_address, ///< The address field is malformed.
+	unknown_sentence, ///< The sentence is not supported.
+	invalid_data, ///< The data fields are invalid for the sentence.
+};
+
 class sentence; // forward declaration
+class sentence_arena; // forward declaration
 
 std::unique_ptr<sentence> make_sentence(
 	const std::string & s, checksum_handling chksum = checksum_handling::check);
 
+std::unique_ptr<sentence> make_sentence(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+utils::expected<std::unique_ptr<sentence>, parse_error> try_make_sentence(
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+utils::expected<std::unique_ptr<sentence>, parse_error> try_make_sentence(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+sentence * make_sentence(sentence_arena & arena, const std::string & s,
+	checksum_handling chksum = checksum_handling::check);
+
+sentence * make_sentence(sentence_arena & arena, const char * s, std::size_t n,
+	checksum_handling chksum = checksum_handling::check);
+
+utils::expected<sentence *, parse_error> try_make_sentence(sentence_arena & arena,
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+utils::expected<sentence *, parse_error> try_make_sentence(sentence_arena & arena,
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+std::string to_string(parse_error e);
+
 sentence_id extract_id(const std::string & s);
 
 std::vector<std::string> get_supported_sentences_str();
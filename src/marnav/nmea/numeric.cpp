@@ -0,0 +1,237 @@
+#include "numeric.hpp"
+#include <cmath>
+#include <limits>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace
+{
+static bool is_digit(char c) noexcept
+{
+	return (c >= '0') && (c <= '9');
+}
+
+/// Returns the value of the digit, or a value equal or larger than the base
+/// if the character is not a digit of the specified base.
+static uint32_t digit_value(char c, uint32_t base) noexcept
+{
+	if (is_digit(c))
+		return static_cast<uint32_t>(c - '0');
+	if (base == 16) {
+		if ((c >= 'a') && (c <= 'f'))
+			return static_cast<uint32_t>(c - 'a' + 10);
+		if ((c >= 'A') && (c <= 'F'))
+			return static_cast<uint32_t>(c - 'A' + 10);
+	}
+	return base;
+}
+
+/// Powers of ten which are exactly representable as double.
+static const double exact_powers_of_ten[] = {1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6,
+	1.0e7, 1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17,
+	1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+static constexpr int max_exact_power_of_ten = 22;
+static constexpr uint64_t max_exact_mantissa = uint64_t{1} << 53;
+}
+/// @endcond
+
+/// Parses an unsigned integer, consisting of digits only.
+///
+/// @param[in] first Start of the range to parse.
+/// @param[in] last End of the range to parse (exclusive).
+/// @param[in] fmt Base of the number, `data_format::hex` for hexadecimal, decimal otherwise.
+/// @return The parsed value or the error.
+utils::expected<uint64_t, numeric_error> parse_unsigned(
+	const char * first, const char * last, data_format fmt) noexcept
+{
+	if (first == last)
+		return utils::make_unexpected(numeric_error::empty);
+
+	const uint32_t base = (fmt == data_format::hex) ? 16u : 10u;
+	const uint64_t limit = std::numeric_limits<uint64_t>::max() / base;
+
+	uint64_t value = 0;
+	for (; first != last; ++first) {
+		const uint32_t d = digit_value(*first, base);
+		if (d >= base)
+			return utils::make_unexpected(numeric_error::invalid_format);
+		if ((value > limit) || ((value * base) > (std::numeric_limits<uint64_t>::max() - d)))
+			return utils::make_unexpected(numeric_error::out_of_range);
+		value = value * base + d;
+	}
+	return value;
+}
+
+/// Parses a signed integer, consisting of an optional sign followed by digits.
+///
+/// @see parse_unsigned
+utils::expected<int64_t, numeric_error> parse_signed(
+	const char * first, const char * last, data_format fmt) noexcept
+{
+	if (first == last)
+		return utils::make_unexpected(numeric_error::empty);
+
+	const bool negative = (*first == '-');
+	if (negative || (*first == '+'))
+		++first;
+	if (first == last)
+		return utils::make_unexpected(numeric_error::invalid_format);
+
+	const auto t = parse_unsigned(first, last, fmt);
+	if (!t)
+		return utils::make_unexpected(t.error());
+
+	const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+	if (*t > (negative ? max + 1u : max))
+		return utils::make_unexpected(numeric_error::out_of_range);
+	if (negative)
+		return static_cast<int64_t>(0u - *t);
+	return static_cast<int64_t>(*t);
+}
+
+/// Parses a decimal number in fixed point notation: an optional sign, followed
+/// by digits, a decimal point and more digits. Either the digits before or after
+/// the decimal point may be omitted, the decimal point as well. Exponents, as well
+/// as infinity and NaN are not supported.
+///
+/// The result is exact (the nearest representable value) for up to 15 significant
+/// digits, which covers all data of NMEA sentences.
+///
+/// @see parse_unsigned
+utils::expected<double, numeric_error> parse_decimal(
+	const char * first, const char * last) noexcept
+{
+	if (first == last)
+		return utils::make_unexpected(numeric_error::empty);
+
+	const bool negative = (*first == '-');
+	if (negative || (*first == '+'))
+		++first;
+
+	static constexpr uint64_t limit = (std::numeric_limits<uint64_t>::max() - 9u) / 10u;
+
+	uint64_t mantissa = 0;
+	int exponent = 0;
+	bool digits = false;
+	bool point = false;
+
+	for (; first != last; ++first) {
+		const char c = *first;
+		if (is_digit(c)) {
+			digits = true;
+			if (mantissa <= limit) {
+				mantissa = mantissa * 10u + static_cast<uint64_t>(c - '0');
+				if (point)
+					--exponent;
+			} else if (!point) {
+				++exponent; // digits beyond the precision are dropped
+			}
+		} else if ((c == '.') && !point) {
+			point = true;
+		} else {
+			return utils::make_unexpected(numeric_error::invalid_format);
+		}
+	}
+	if (!digits)
+		return utils::make_unexpected(numeric_error::invalid_format);
+
+	double value;
+	if ((mantissa <= max_exact_mantissa) && (exponent >= -max_exact_power_of_ten)
+		&& (exponent <= 0)) {
+		// a single division of exact values, correctly rounded
+		value = static_cast<double>(mantissa) / exact_powers_of_ten[-exponent];
+	} else {
+		value = static_cast<double>(
+			static_cast<long double>(mantissa) * std::pow(10.0L, exponent));
+	}
+	return negative ? -value : value;
+}
+
+/// Parses an angle in the form `DDDMM.MMMM`, degrees followed by two digits of
+/// minutes and optional fractions of minutes, as used for latitudes and longitudes.
+///
+/// @return The angle in degrees, or the error. Minutes of 60 or more are reported
+///   as `numeric_error::out_of_range`.
+///
+/// @see parse_unsigned
+utils::expected<double, numeric_error> parse_degrees_minutes(
+	const char * first, const char * last) noexcept
+{
+	const auto t = parse_decimal(first, last);
+	if (!t)
+		return t;
+
+	const double deg = (*t - std::fmod(*t, 100.0)) / 100.0;
+	const double min = (*t - (deg * 100.0)) / 60.0;
+	if (std::abs(min) >= 1.0)
+		return utils::make_unexpected(numeric_error::out_of_range);
+	return deg + min;
+}
+
+/// Parses a time in the form `HHMMSS.sss`, the fractions of seconds are optional
+/// and taken into account up to milliseconds, further digits are ignored.
+/// Leading zeros of the hour may be omitted.
+///
+/// @note The values are not checked for validity of a time, a value of 99 minutes
+///   is returned as such.
+///
+/// @see parse_unsigned
+utils::expected<time_fields, numeric_error> parse_hhmmss(
+	const char * first, const char * last) noexcept
+{
+	if (first == last)
+		return utils::make_unexpected(numeric_error::empty);
+
+	uint32_t hms = 0;
+	std::size_t n = 0;
+	for (; (first != last) && is_digit(*first); ++first, ++n) {
+		if (n >= 6)
+			return utils::make_unexpected(numeric_error::out_of_range);
+		hms = hms * 10u + static_cast<uint32_t>(*first - '0');
+	}
+	if (n == 0)
+		return utils::make_unexpected(numeric_error::invalid_format);
+
+	uint32_t ms = 0;
+	if (first != last) {
+		if (*first != '.')
+			return utils::make_unexpected(numeric_error::invalid_format);
+		++first;
+		uint32_t scale = 100;
+		for (; first != last; ++first) {
+			if (!is_digit(*first))
+				return utils::make_unexpected(numeric_error::invalid_format);
+			ms += scale * static_cast<uint32_t>(*first - '0');
+			scale /= 10u;
+		}
+	}
+
+	time_fields t;
+	t.hour = hms / 10000u;
+	t.minutes = (hms / 100u) % 100u;
+	t.seconds = hms % 100u;
+	t.milliseconds = ms;
+	return t;
+}
+
+/// Returns a textual description of the specified error.
+std::string to_string(numeric_error e)
+{
+	switch (e) {
+		case numeric_error::none:
+			return "none";
+		case numeric_error::empty:
+			return "empty";
+		case numeric_error::invalid_format:
+			return "invalid format";
+		case numeric_error::out_of_range:
+			return "out of range";
+	}
+	return ""; // never reached, gcc does not get it, prevents compiler warning
+}
+}
+}
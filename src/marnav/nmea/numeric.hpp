@@ -0,0 +1,48 @@
+#ifndef MARNAV__NMEA__NUMERIC__HPP
+#define MARNAV__NMEA__NUMERIC__HPP
+
+#include <cstdint>
+#include <string>
+#include <marnav/nmea/io.hpp>
+#include <marnav/utils/expected.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+/// Errors reported by the numeric parsing functions.
+enum class numeric_error {
+	none, ///< No error.
+	empty, ///< The range to parse is empty.
+	invalid_format, ///< The range contains characters not allowed at their position.
+	out_of_range, ///< The value does not fit into the data type or its valid range.
+};
+
+/// Time of day as it is parsed from a NMEA field, not yet checked for validity.
+struct time_fields {
+	uint32_t hour = 0;
+	uint32_t minutes = 0;
+	uint32_t seconds = 0;
+	uint32_t milliseconds = 0;
+};
+
+utils::expected<uint64_t, numeric_error> parse_unsigned(
+	const char * first, const char * last, data_format fmt = data_format::dec) noexcept;
+
+utils::expected<int64_t, numeric_error> parse_signed(
+	const char * first, const char * last, data_format fmt = data_format::dec) noexcept;
+
+utils::expected<double, numeric_error> parse_decimal(
+	const char * first, const char * last) noexcept;
+
+utils::expected<double, numeric_error> parse_degrees_minutes(
+	const char * first, const char * last) noexcept;
+
+utils::expected<time_fields, numeric_error> parse_hhmmss(
+	const char * first, const char * last) noexcept;
+
+std::string to_string(numeric_error e);
+}
+}
+
+#endif
@@ -88,5 +88,21 @@ void rmc::append_data_to(std::string & s) const
 	append(s, to_string(mag_hem_));
 	append(s, to_string(mode_ind_));
 }
+
+char * rmc::write_data_to(char * first, char * last) const
+{
+	first = to_chars(write_delimiter(first, last), last, time_utc_);
+	first = to_chars(write_delimiter(first, last), last, status_);
+	first = to_chars(write_delimiter(first, last), last, lat_);
+	first = to_chars(write_delimiter(first, last), last, lat_hem_);
+	first = to_chars(write_delimiter(first, last), last, lon_);
+	first = to_chars(write_delimiter(first, last), last, lon_hem_);
+	first = to_chars(write_delimiter(first, last), last, sog_);
+	first = to_chars(write_delimiter(first, last), last, heading_);
+	first = to_chars(write_delimiter(first, last), last, date_);
+	first = to_chars(write_delimiter(first, last), last, mag_);
+	first = to_chars(write_delimiter(first, last), last, mag_hem_);
+	return to_chars(write_delimiter(first, last), last, mode_ind_);
+}
 }
 }
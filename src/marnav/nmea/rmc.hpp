@@ -61,6 +61,7 @@ public:
 protected:
 	rmc(talker talk, fields::const_iterator first, fields::const_iterator last);
 	virtual void append_data_to(std::string &) const override;
+	virtual char * write_data_to(char * first, char * last) const override;
 
 private:
 	utils::optional<nmea::time> time_utc_;
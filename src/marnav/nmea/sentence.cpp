@@ -1,6 +1,8 @@
 #include "sentence.hpp"
 #include <algorithm>
 #include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/hex_digit.hpp>
+#include <marnav/nmea/io.hpp>
 
 namespace marnav
 {
@@ -39,15 +41,88 @@ std::string to_string(const sentence & s)
 		result.reserve(sentence::max_length);
 	}
 	result += s.get_start_token();
+	const auto start = result.size(); // the tag block is not part of the checksum
 	result += to_string(s.get_talker());
 	result += s.tag();
 	s.append_data_to(result);
+	const auto sum = checksum(std::next(std::begin(result), start), std::end(result));
 	result += s.get_end_token();
-	result += checksum_to_string(
-		checksum(std::next(std::begin(result)), std::prev(std::end(result))));
+	result += checksum_to_string(sum);
 	return result;
 }
 
+/// Renders the sentence into the specified buffer, the result is the same
+/// as the one of `to_string`, without terminating zero.
+///
+/// Sentences which implement `write_data_to` (e.g. RMC, GGA, VTG, HDT, VDM
+/// and VDO) are rendered directly into the buffer, without allocating memory.
+/// All others are rendered by `append_data_to` into a per thread buffer which
+/// is reused, their fields are rendered as temporary strings.
+///
+/// Example:
+/// @code
+///   char buf[nmea::sentence::max_length + 2];
+///   const auto n = s.write_to(buf, sizeof(buf) - 2);
+///   buf[n + 0] = '\r';
+///   buf[n + 1] = '\n';
+/// @endcode
+///
+/// @param[out] buf The buffer to write the sentence to.
+/// @param[in] size Size of the buffer.
+/// @return Number of written characters, `0` if the buffer is too small.
+std::size_t sentence::write_to(char * buf, std::size_t size) const
+{
+	if (!buf)
+		return 0u;
+
+	char * const last = buf + size;
+	char * p = buf;
+	if (!tag_block_.empty()) {
+		p = to_chars(p, last, tag_block_token);
+		p = to_chars(p, last, tag_block_);
+		p = to_chars(p, last, tag_block_token);
+	}
+	p = to_chars(p, last, get_start_token());
+	char * const start = p;
+	p = to_chars(p, last, talker_);
+	p = to_chars(p, last, tag_);
+	p = write_data_to(p, last);
+	if (!p || ((last - p) < 3))
+		return 0u;
+
+	const uint8_t sum = checksum(start, p);
+	*p++ = get_end_token();
+	*p++ = detail::hex_digit(sum >> 4);
+	*p++ = detail::hex_digit(sum);
+	return static_cast<std::size_t>(p - buf);
+}
+
+/// Writes the data fields into the buffer, including the leading field delimiters.
+/// The rendering must be the same as the one of `append_data_to`.
+///
+/// This default implementation renders the fields using `append_data_to` into
+/// a per thread buffer and copies them. Sentences which are written frequently
+/// override it to render their fields directly, using `to_chars` and
+/// `write_delimiter`.
+///
+/// @param[in] first Start of the buffer, may be `nullptr`.
+/// @param[in] last End of the buffer (exclusive).
+/// @return Pointer after the last written character, `nullptr` if the buffer is
+///   too small or `first` is `nullptr`.
+char * sentence::write_data_to(char * first, char * last) const
+{
+	static thread_local std::string data;
+	data.clear();
+	append_data_to(data);
+	return to_chars(first, last, data);
+}
+
+/// Writes the field delimiter into the buffer, see `write_data_to`.
+char * sentence::write_delimiter(char * first, char * last) noexcept
+{
+	return to_chars(first, last, field_delimiter);
+}
+
 void sentence::append(std::string & s, const std::string & t)
 {
 	s += field_delimiter;
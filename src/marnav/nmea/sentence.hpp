@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -71,6 +72,8 @@ public:
 	/// at the moment, its handling is separated, @see tag_block.
 	const std::string & get_tag_block() const { return tag_block_; }
 
+	std::size_t write_to(char * buf, std::size_t size) const;
+
 	friend std::string to_string(const sentence &);
 
 protected:
@@ -92,8 +95,11 @@ protected:
 	///
 	virtual void append_data_to(std::string &) const = 0;
 
+	virtual char * write_data_to(char * first, char * last) const;
+
 	static void append(std::string & s, const std::string & t);
 	static void append(std::string & s, const char t);
+	static char * write_delimiter(char * first, char * last) noexcept;
 
 private:
 	sentence_id id_;
@@ -141,6 +147,26 @@ public:
 		return std::unique_ptr<T>(new T{talk, first, last});
 	}
 
+	/// Function to create sentences in the specified memory, used by the NMEA registry
+	/// of known sentences for `make_sentence` with a `sentence_arena`.
+	template <class T,
+		typename std::enable_if<std::is_base_of<sentence, T>::value, int>::type = 0>
+	static sentence * emplace(void * p, talker talk, sentence::fields::const_iterator first,
+		sentence::fields::const_iterator last)
+	{
+		return new (p) T{talk, first, last};
+	}
+
+	/// Function to create sentences within a variant, used by the NMEA registry of
+	/// known sentences for `make_any_sentence`.
+	template <class T, class Variant,
+		typename std::enable_if<std::is_base_of<sentence, T>::value, int>::type = 0>
+	static void emplace_variant(Variant & v, talker talk,
+		sentence::fields::const_iterator first, sentence::fields::const_iterator last)
+	{
+		v.template emplace<T>(T{talk, first, last});
+	}
+
 	/// Helper function to parse a specific sentence.
 	///
 	/// @note Only to be used in unit tests.
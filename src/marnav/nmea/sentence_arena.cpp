@@ -0,0 +1,78 @@
+#include "sentence_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <marnav/nmea/sentence.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t sentence_arena::default_block_size;
+
+/// Initializes the arena, no memory is allocated until the first sentence is
+/// constructed.
+///
+/// @param[in] block_size Size of the memory blocks to allocate. Sentences larger
+///   than this are placed in a block of their own.
+/// @exception std::invalid_argument The block size is zero.
+sentence_arena::sentence_arena(std::size_t block_size)
+	: block_size_(block_size)
+{
+	if (block_size_ == 0u)
+		throw std::invalid_argument{"invalid block size in nmea::sentence_arena"};
+}
+
+sentence_arena::~sentence_arena()
+{
+	reset();
+}
+
+/// Destroys all sentences within the arena, in reverse order of their construction.
+/// The memory is kept for further use.
+void sentence_arena::reset() noexcept
+{
+	for (auto i = objects_.rbegin(); i != objects_.rend(); ++i)
+		(*i)->~sentence();
+	objects_.clear();
+	current_ = 0u;
+	offset_ = 0u;
+}
+
+/// Returns the total size of the allocated memory blocks.
+std::size_t sentence_arena::capacity() const noexcept
+{
+	std::size_t n = 0u;
+	for (const auto & b : blocks_)
+		n += b.size;
+	return n;
+}
+
+/// Returns suitably aligned memory, using the current block or the next one
+/// which has enough space. If none is left, a new block is allocated.
+void * sentence_arena::allocate(std::size_t size, std::size_t alignment)
+{
+	for (;;) {
+		if (current_ < blocks_.size()) {
+			const block & b = blocks_[current_];
+			const auto base = reinterpret_cast<std::uintptr_t>(b.data.get());
+			const auto p = (base + offset_ + alignment - 1u) & ~(alignment - 1u);
+			if (p + size <= base + b.size) {
+				offset_ = p + size - base;
+				return reinterpret_cast<void *>(p);
+			}
+			if (current_ + 1u < blocks_.size()) {
+				++current_;
+				offset_ = 0u;
+				continue;
+			}
+		}
+
+		const std::size_t n = std::max(block_size_, size + alignment);
+		blocks_.push_back(block{std::unique_ptr<char[]>(new char[n]), n});
+		current_ = blocks_.size() - 1u;
+		offset_ = 0u;
+	}
+}
+}
+}
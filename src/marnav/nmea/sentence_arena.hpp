@@ -0,0 +1,104 @@
+#ifndef MARNAV__NMEA__SENTENCE_ARENA__HPP
+#define MARNAV__NMEA__SENTENCE_ARENA__HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace marnav
+{
+namespace nmea
+{
+class sentence; // forward declaration
+
+/// @brief Memory arena for sentences, used by the arena variants of `make_sentence`.
+///
+/// Sentences are constructed in memory blocks owned by the arena, one after the
+/// other. They are not destroyed individually, but all at once by `reset`, which
+/// rewinds the arena. The memory blocks are kept and reused for the next batch
+/// of sentences, therefore, once the arena has grown large enough, no further
+/// memory for the sentence objects is allocated.
+///
+/// Sentences handed out by the arena are valid until the next `reset` or the
+/// destruction of the arena.
+///
+/// @note Data of the sentences stored in dynamically allocated members (e.g.
+///   long strings) is still allocated on the heap.
+///
+/// Example:
+/// @code
+///   nmea::sentence_arena arena;
+///   while (...) {
+///       for (const auto & line : batch) {
+///           nmea::sentence * s = nmea::make_sentence(arena, line);
+///           ...
+///       }
+///       arena.reset();
+///   }
+/// @endcode
+class sentence_arena
+{
+public:
+	static constexpr std::size_t default_block_size = 16384u;
+
+	explicit sentence_arena(std::size_t block_size = default_block_size);
+	~sentence_arena();
+
+	sentence_arena(const sentence_arena &) = delete;
+	sentence_arena(sentence_arena &&) = delete;
+	sentence_arena & operator=(const sentence_arena &) = delete;
+	sentence_arena & operator=(sentence_arena &&) = delete;
+
+	/// Constructs a sentence within the arena.
+	///
+	/// @param[in] size Size of the sentence object.
+	/// @param[in] alignment Alignment of the sentence object, must be a power of two.
+	/// @param[in] construct Function constructing the sentence in the specified memory
+	///   (signature `sentence * (void *)`). If it throws an exception, the memory is
+	///   released and the exception is passed on.
+	/// @return The constructed sentence, owned by the arena.
+	template <class Construct>
+	sentence * emplace(std::size_t size, std::size_t alignment, Construct construct)
+	{
+		if (objects_.size() == objects_.capacity())
+			objects_.reserve(objects_.empty() ? 64u : 2u * objects_.capacity());
+
+		const auto current = current_;
+		const auto offset = offset_;
+		void * p = allocate(size, alignment);
+		try {
+			sentence * s = construct(p);
+			objects_.push_back(s);
+			return s;
+		} catch (...) {
+			current_ = current;
+			offset_ = offset;
+			throw;
+		}
+	}
+
+	void reset() noexcept;
+
+	/// Returns the number of sentences within the arena.
+	std::size_t size() const noexcept { return objects_.size(); }
+
+	std::size_t capacity() const noexcept;
+
+private:
+	struct block {
+		std::unique_ptr<char[]> data;
+		std::size_t size;
+	};
+
+	void * allocate(std::size_t size, std::size_t alignment);
+
+	std::size_t block_size_;
+	std::vector<block> blocks_;
+	std::size_t current_ = 0u; // index of the block currently used
+	std::size_t offset_ = 0u; // first free byte within the current block
+	std::vector<sentence *> objects_;
+};
+}
+}
+
+#endif
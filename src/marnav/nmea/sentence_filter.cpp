@@ -0,0 +1,93 @@
+#include "sentence_filter.hpp"
+#include <stdexcept>
+#include <marnav/nmea/detail.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t sentence_filter::num_ids;
+constexpr std::size_t sentence_filter::num_talkers;
+
+/// Initializes the filter to accept the specified sentences, regardless of the talker.
+sentence_filter::sentence_filter(std::initializer_list<sentence_id> ids)
+{
+	for (const auto id : ids)
+		accept(id);
+}
+
+/// Returns a filter which accepts all sentences.
+sentence_filter sentence_filter::all()
+{
+	sentence_filter f;
+	for (auto & t : f.table_)
+		t.set();
+	return f;
+}
+
+/// @exception std::invalid_argument The sentence ID is invalid.
+std::size_t sentence_filter::index(sentence_id id)
+{
+	const auto i = static_cast<std::size_t>(id);
+	if (i >= num_ids)
+		throw std::invalid_argument{"invalid sentence id in nmea::sentence_filter"};
+	return i;
+}
+
+/// Accepts the specified sentence from all talkers.
+sentence_filter & sentence_filter::accept(sentence_id id)
+{
+	table_[index(id)].set();
+	return *this;
+}
+
+/// Accepts the specified sentence from the specified talker.
+sentence_filter & sentence_filter::accept(sentence_id id, talker t)
+{
+	table_[index(id)].set(static_cast<std::size_t>(t));
+	return *this;
+}
+
+/// Rejects the specified sentence from all talkers.
+sentence_filter & sentence_filter::reject(sentence_id id)
+{
+	table_[index(id)].reset();
+	return *this;
+}
+
+/// Rejects the specified sentence from the specified talker.
+sentence_filter & sentence_filter::reject(sentence_id id, talker t)
+{
+	table_[index(id)].reset(static_cast<std::size_t>(t));
+	return *this;
+}
+
+/// Returns true if the specified sentence ID / talker pair is accepted.
+bool sentence_filter::accepts(sentence_id id, talker t) const noexcept
+{
+	const auto i = static_cast<std::size_t>(id);
+	const auto k = static_cast<std::size_t>(t);
+	return (i < num_ids) && (k < num_talkers) && table_[i][k];
+}
+
+/// Returns true if the specified raw sentence is accepted. Only the address
+/// field is examined.
+///
+/// @param[in] s The raw sentence, with or without tag block.
+/// @param[in] n Size of the raw sentence.
+bool sentence_filter::accepts(const char * s, std::size_t n) const noexcept
+{
+	const char * address = nullptr;
+	std::size_t size = 0u;
+	if (!detail::find_address(s, n, address, size))
+		return false;
+
+	talker t = talker::none;
+	sentence_id id = sentence_id::NONE;
+	if (!detail::parse_address(address, size, t, id))
+		return false;
+
+	return accepts(id, t);
+}
+}
+}
@@ -0,0 +1,75 @@
+#ifndef MARNAV__NMEA__SENTENCE_FILTER__HPP
+#define MARNAV__NMEA__SENTENCE_FILTER__HPP
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <marnav/nmea/sentence_id.hpp>
+#include <marnav/nmea/talker_id.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Filter for raw sentences by sentence ID and talker.
+///
+/// The filter decides whether or not a raw sentence is of interest, before it is
+/// parsed. Only the address field is examined: the checksum is not verified and
+/// the sentence is neither split into fields nor copied. No memory is allocated
+/// and no exceptions are thrown, which makes it possible to skip unwanted sentences
+/// at a fraction of the cost of parsing them.
+///
+/// The filter holds a set of accepted sentence ID / talker pairs. A default
+/// constructed filter accepts nothing. Sentences which are not supported by the
+/// library or whose address is malformed are never accepted.
+///
+/// Example: drop all satellite information
+/// @code
+///   const auto filter = nmea::sentence_filter::all()
+///       .reject(nmea::sentence_id::GSV)
+///       .reject(nmea::sentence_id::GSA);
+///
+///   for (const auto & line : lines) {
+///       if (!filter.accepts(line))
+///           continue;
+///       auto s = nmea::make_sentence(line);
+///       ...
+///   }
+/// @endcode
+class sentence_filter
+{
+public:
+	sentence_filter() = default;
+	sentence_filter(std::initializer_list<sentence_id> ids);
+
+	static sentence_filter all();
+
+	sentence_filter & accept(sentence_id id);
+	sentence_filter & accept(sentence_id id, talker t);
+	sentence_filter & reject(sentence_id id);
+	sentence_filter & reject(sentence_id id, talker t);
+
+	bool accepts(sentence_id id, talker t) const noexcept;
+	bool accepts(const char * s, std::size_t n) const noexcept;
+
+	/// String variant.
+	bool accepts(const std::string & s) const noexcept { return accepts(s.data(), s.size()); }
+
+private:
+	static constexpr std::size_t num_ids = static_cast<std::size_t>(sentence_id::STALK) + 1u;
+	static constexpr std::size_t num_talkers
+		= static_cast<std::size_t>(talker::ais_physical_shore_station) + 1u;
+
+	using talkers = std::bitset<num_talkers>;
+
+	static std::size_t index(sentence_id id);
+
+	std::array<talkers, num_ids> table_; ///< Accepted talkers per sentence ID.
+};
+}
+}
+
+#endif
@@ -0,0 +1,182 @@
+#include "sentence_view.hpp"
+#include <stdexcept>
+#include <marnav/nmea/convert.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t sentence_view::max_fields;
+
+/// Returns the tag block of the sentence, empty if there is none.
+std::string sentence_view::get_tag_block() const
+{
+	if (tag_block_size_ == 0u)
+		return {};
+	return std::string(data_ + tag_block_begin_, tag_block_size_);
+}
+
+/// Returns the position and size of the specified data field within the raw sentence.
+///
+/// @exception std::out_of_range The index is invalid.
+std::pair<const char *, std::size_t> sentence_view::field(std::size_t index) const
+{
+	if (index >= size())
+		throw std::out_of_range{"invalid field index in nmea::sentence_view"};
+
+	// data field `index` is preceded by the address, the field delimiter of the
+	// next field is not part of the field.
+	const auto begin = field_begin_[index + 1u];
+	const auto end = field_begin_[index + 2u] - 1u;
+	return {data_ + begin, static_cast<std::size_t>(end - begin)};
+}
+
+/// Returns the raw content of the specified data field.
+///
+/// @param[in] index Index of the data field, the first one has index 0.
+/// @exception std::out_of_range The index is invalid.
+std::string sentence_view::get_field(std::size_t index) const
+{
+	const auto f = field(index);
+	return std::string(f.first, f.second);
+}
+
+/// Returns true if the specified data field is empty.
+///
+/// @param[in] index Index of the data field, the first one has index 0.
+/// @exception std::out_of_range The index is invalid.
+bool sentence_view::is_empty(std::size_t index) const
+{
+	return field(index).second == 0u;
+}
+
+namespace
+{
+/// Index of the latitude field of position sentences, followed by the fields
+/// of the latitude hemisphere, longitude and longitude hemisphere.
+std::size_t latitude_index(sentence_id id) noexcept
+{
+	switch (id) {
+		case sentence_id::GGA:
+		case sentence_id::GNS:
+			return 1u;
+		case sentence_id::GLL:
+			return 0u;
+		case sentence_id::RMC:
+			return 2u;
+		default:
+			break;
+	}
+	return sentence_view::max_fields;
+}
+
+/// Index of the time field of position sentences.
+std::size_t time_index(sentence_id id) noexcept
+{
+	switch (id) {
+		case sentence_id::GGA:
+		case sentence_id::GNS:
+		case sentence_id::RMC:
+			return 0u;
+		case sentence_id::GLL:
+			return 4u;
+		default:
+			break;
+	}
+	return sentence_view::max_fields;
+}
+
+std::size_t checked_latitude_index(sentence_id id)
+{
+	const auto index = latitude_index(id);
+	if (index == sentence_view::max_fields)
+		throw std::invalid_argument{"no position in nmea::sentence_view"};
+	return index;
+}
+}
+
+/// Returns true if the sentence provides a position, supported by
+/// `get_latitude`, `get_longitude` and `get_time_utc`.
+bool sentence_view::has_position() const noexcept
+{
+	return latitude_index(id_) != max_fields;
+}
+
+/// Returns the latitude, corrected by its hemisphere. Only the two fields of the
+/// latitude are decoded.
+///
+/// @return The latitude, empty if the latitude or its hemisphere is not set.
+/// @exception std::invalid_argument The sentence provides no position, or the
+///   data of the fields is invalid.
+/// @exception std::out_of_range The sentence has not enough fields.
+utils::optional<geo::latitude> sentence_view::get_latitude() const
+{
+	const auto index = checked_latitude_index(id_);
+	utils::optional<geo::latitude> lat;
+	utils::optional<direction> hem;
+	read(index + 0u, lat);
+	read(index + 1u, hem);
+	if (!lat || !hem)
+		return {};
+	return correct_hemisphere(lat, hem);
+}
+
+/// Returns the longitude, corrected by its hemisphere. Only the two fields of the
+/// longitude are decoded.
+///
+/// @return The longitude, empty if the longitude or its hemisphere is not set.
+/// @exception std::invalid_argument The sentence provides no position, or the
+///   data of the fields is invalid.
+/// @exception std::out_of_range The sentence has not enough fields.
+utils::optional<geo::longitude> sentence_view::get_longitude() const
+{
+	const auto index = checked_latitude_index(id_) + 2u;
+	utils::optional<geo::longitude> lon;
+	utils::optional<direction> hem;
+	read(index + 0u, lon);
+	read(index + 1u, hem);
+	if (!lon || !hem)
+		return {};
+	return correct_hemisphere(lon, hem);
+}
+
+/// Returns the time (UTC) of the position.
+///
+/// @exception std::invalid_argument The sentence provides no position, or the
+///   data of the field is invalid.
+/// @exception std::out_of_range The sentence has not enough fields.
+utils::optional<nmea::time> sentence_view::get_time_utc() const
+{
+	const auto index = time_index(id_);
+	if (index == max_fields)
+		throw std::invalid_argument{"no time in nmea::sentence_view"};
+	utils::optional<nmea::time> t;
+	read(index, t);
+	return t;
+}
+
+/// Returns the date of the position, supported by `RMC` only.
+///
+/// @exception std::invalid_argument The sentence provides no date, or the
+///   data of the field is invalid.
+/// @exception std::out_of_range The sentence has not enough fields.
+utils::optional<nmea::date> sentence_view::get_date() const
+{
+	if (id_ != sentence_id::RMC)
+		throw std::invalid_argument{"no date in nmea::sentence_view"};
+	utils::optional<nmea::date> d;
+	read(8u, d);
+	return d;
+}
+
+/// Returns all data fields, as needed by the sentence constructors.
+sentence::fields sentence_view::fields() const
+{
+	sentence::fields result;
+	result.reserve(size());
+	for (std::size_t i = 0; i < size(); ++i)
+		result.push_back(get_field(i));
+	return result;
+}
+}
+}
@@ -0,0 +1,157 @@
+#ifndef MARNAV__NMEA__SENTENCE_VIEW__HPP
+#define MARNAV__NMEA__SENTENCE_VIEW__HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/angle.hpp>
+#include <marnav/nmea/date.hpp>
+#include <marnav/nmea/io.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/time.hpp>
+#include <marnav/utils/optional.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+class sentence_view; // forward declaration
+
+utils::expected<sentence_view, parse_error> try_make_sentence_view(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+
+/// @brief Non-owning, lazily decoded view of a raw NMEA sentence.
+///
+/// Creating the view (see `make_sentence_view`) performs all checks of the raw
+/// sentence, which `make_sentence` does: start token, tag block, number of fields,
+/// checksum and address. The data fields however are not decoded, but only located
+/// within the raw sentence. Individual fields are decoded on request, using the
+/// same conversion functions the sentences use.
+///
+/// This is useful for consumers which need only one or two fields of a sentence,
+/// for example the position of `GGA` or the heading of `HDT`. The position and
+/// time of the common position sentences are provided by typed accessors, with
+/// the same semantics as the accessors of the sentences. Other fields are decoded
+/// by index, see `read`. If the full sentence is needed, it is decoded by `as`,
+/// which provides all typed accessors.
+///
+/// The view refers to the raw sentence, which therefore must outlive the view.
+///
+/// Example:
+/// @code
+///   const std::string raw = "$GPHDT,123.4,T*31";
+///   const auto v = nmea::make_sentence_view(raw);
+///   if (v.id() == nmea::sentence_id::HDT) {
+///       utils::optional<double> heading;
+///       v.read(0, heading);
+///       ...
+///   } else if (v.has_position()) {
+///       const auto lat = v.get_latitude();
+///       const auto lon = v.get_longitude();
+///       ...
+///   }
+/// @endcode
+class sentence_view
+{
+	friend utils::expected<sentence_view, parse_error> try_make_sentence_view(
+		const char * s, std::size_t n, checksum_handling chksum);
+
+public:
+	/// Maximum number of fields (including address and checksum) supported by the view.
+	static constexpr std::size_t max_fields = 128u;
+
+	/// Constructs an empty view, not referring to any sentence.
+	sentence_view() = default;
+
+	sentence_view(const sentence_view &) = default;
+	sentence_view & operator=(const sentence_view &) = default;
+
+	sentence_id id() const noexcept { return id_; }
+	talker get_talker() const noexcept { return talker_; }
+	std::string get_tag_block() const;
+
+	/// Returns the number of data fields, without address and checksum.
+	std::size_t size() const noexcept { return (num_fields_ < 2u) ? 0u : num_fields_ - 2u; }
+
+	std::string get_field(std::size_t index) const;
+	bool is_empty(std::size_t index) const;
+
+	/// Decodes the specified data field, exactly as the sentence would.
+	///
+	/// All overloads of `nmea::read` are supported, including the ones for
+	/// optional values and the ones with mapping functions for enumerations.
+	///
+	/// @param[in] index Index of the data field, the first one has index 0.
+	/// @param[out] value The decoded value.
+	/// @param[in] args Further arguments to `nmea::read`, e.g. the data format.
+	/// @exception std::out_of_range The index is invalid.
+	/// @exception std::invalid_argument The data of the field is invalid.
+	template <class T, class... Args>
+	void read(std::size_t index, T & value, Args &&... args) const
+	{
+		nmea::read(get_field(index), value, std::forward<Args>(args)...);
+	}
+
+	/// @{
+	/// Decodes only the fields needed, supported are `GGA`, `GLL`, `GNS` and `RMC`,
+	/// `get_date` is supported by `RMC` only.
+	bool has_position() const noexcept;
+	utils::optional<geo::latitude> get_latitude() const;
+	utils::optional<geo::longitude> get_longitude() const;
+	utils::optional<nmea::time> get_time_utc() const;
+	utils::optional<nmea::date> get_date() const;
+	/// @}
+
+	/// Decodes the entire sentence, providing all typed accessors.
+	///
+	/// @tparam T The sentence type, must match the ID of the view.
+	/// @return The decoded sentence.
+	/// @exception std::invalid_argument The view refers to a different sentence, or
+	///   its data is invalid for the sentence.
+	template <class T> std::unique_ptr<T> as() const
+	{
+		if (id_ != T::ID)
+			throw std::invalid_argument{"sentence id mismatch in nmea::sentence_view::as"};
+		const auto f = fields();
+		auto result = detail::factory::parse<T>(talker_, f.begin(), f.end());
+		if (tag_block_size_ > 0u)
+			result->set_tag_block(get_tag_block());
+		return result;
+	}
+
+private:
+	sentence::fields fields() const;
+	std::pair<const char *, std::size_t> field(std::size_t index) const;
+
+	const char * data_ = nullptr;
+	sentence_id id_ = sentence_id::NONE;
+	talker talker_ = talker_id::none;
+	std::uint16_t tag_block_begin_ = 0u;
+	std::uint16_t tag_block_size_ = 0u;
+	std::uint16_t num_fields_ = 0u;
+	std::array<std::uint16_t, max_fields> field_begin_ = {}; ///< Offsets of the fields.
+};
+
+utils::expected<sentence_view, parse_error> try_make_sentence_view(
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+/// The view would refer to a temporary string.
+utils::expected<sentence_view, parse_error> try_make_sentence_view(
+	std::string && s, checksum_handling chksum = checksum_handling::check) = delete;
+
+sentence_view make_sentence_view(
+	const std::string & s, checksum_handling chksum = checksum_handling::check);
+
+/// The view would refer to a temporary string.
+sentence_view make_sentence_view(
+	std::string && s, checksum_handling chksum = checksum_handling::check) = delete;
+
+sentence_view make_sentence_view(
+	const char * s, std::size_t n, checksum_handling chksum = checksum_handling::check);
+}
+}
+
+#endif
@@ -34,6 +34,43 @@ std::vector<std::string> parse_fields(
 	}
 	return result;
 }
+
+/// Splits the specified buffer into fields without copying any data. Uses ',' and '*'
+/// as delimiter, the same way as `parse_fields` does.
+///
+/// The resulting views point into the specified buffer, which therefore must outlive
+/// them.
+///
+/// @param[in] s The buffer to split.
+/// @param[in] n Size of the buffer.
+/// @param[out] fields Destination for the field views.
+/// @param[in] max_fields Capacity of `fields`.
+/// @param[in] start_pos The position within the buffer to start the parsing of the
+///   fields, usually right after the start token.
+/// @return The number of fields found. If this number is greater than `max_fields`,
+///   only the first `max_fields` were stored.
+std::size_t split_fields(const char * s, std::size_t n, field_view * fields,
+	std::size_t max_fields, std::size_t start_pos) noexcept
+{
+	if ((n < 1u) || (start_pos > n))
+		return 0u;
+
+	std::size_t count = 0u;
+	const char * p = s + start_pos;
+	const char * const end = s + n;
+	for (;;) {
+		const char * const last = p;
+		while ((p != end) && (*p != ',') && (*p != '*'))
+			++p;
+		if (count < max_fields)
+			fields[count] = field_view{last, static_cast<std::size_t>(p - last)};
+		++count;
+		if (p == end)
+			break;
+		++p;
+	}
+	return count;
+}
 }
 /// @endcond
 }
@@ -1,6 +1,7 @@
 #ifndef MARNAV__NMEA__SPLIT__HPP
 #define MARNAV__NMEA__SPLIT__HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,24 @@ namespace detail
 {
 std::vector<std::string> parse_fields(
 	const std::string & s, const std::string::size_type start_pos = 1u);
+
+/// Maximum number of fields (including address and checksum) processed by the
+/// non-allocating sentence parsing.
+constexpr std::size_t max_fields = 128u;
+
+/// Non-owning reference to a field within a raw NMEA sentence.
+///
+/// The referenced buffer must outlive the view.
+struct field_view {
+	const char * data;
+	std::size_t size;
+
+	bool empty() const noexcept { return size == 0u; }
+	std::string str() const { return std::string(data, size); }
+};
+
+std::size_t split_fields(const char * s, std::size_t n, field_view * fields,
+	std::size_t max_fields, std::size_t start_pos = 1u) noexcept;
 }
 /// @endcond
 }
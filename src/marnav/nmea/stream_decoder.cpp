@@ -0,0 +1,140 @@
+#include "stream_decoder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t stream_decoder::default_max_line_length;
+
+namespace
+{
+/// Returns the first end of line character (CR or LF) within the range,
+/// or `last` if there is none.
+const char * find_eol(const char * first, const char * last) noexcept
+{
+	for (; first != last; ++first)
+		if ((*first == '\n') || (*first == '\r'))
+			return first;
+	return last;
+}
+}
+
+/// Initializes the decoder.
+///
+/// @param[in] on_sentence Handler for the decoded sentences.
+/// @param[in] on_error Optional handler for lines which could not be decoded.
+/// @param[in] chksum Checksum handling strategy.
+/// @param[in] max_line_length Maximum length of lines spanning chunks. Longer lines
+///   are reported as `parse_error::malformed`.
+/// @exception std::invalid_argument The sentence handler is not set or the
+///   maximum line length is zero.
+stream_decoder::stream_decoder(sentence_handler on_sentence, error_handler on_error,
+	checksum_handling chksum, std::size_t max_line_length)
+	: on_sentence_(std::move(on_sentence))
+	, on_error_(std::move(on_error))
+	, chksum_(chksum)
+	, buffer_(max_line_length)
+{
+	if (!on_sentence_)
+		throw std::invalid_argument{"no sentence handler in nmea::stream_decoder"};
+	if (max_line_length == 0u)
+		throw std::invalid_argument{"invalid line length in nmea::stream_decoder"};
+}
+
+/// Discards an incomplete line, kept from previous calls of `feed`.
+void stream_decoder::reset() noexcept
+{
+	pending_ = 0u;
+	overflow_ = false;
+}
+
+/// Sets the filter to apply to all lines before they are decoded, replaces
+/// a previously set filter.
+void stream_decoder::set_filter(const sentence_filter & filter)
+{
+	filter_.reset(new sentence_filter(filter));
+}
+
+/// Removes the filter, all lines are decoded.
+void stream_decoder::clear_filter() noexcept
+{
+	filter_.reset();
+}
+
+/// Processes the specified chunk of data. All complete lines are decoded and passed
+/// to the handlers, an incomplete line at the end of the chunk is kept until the
+/// next call.
+///
+/// @param[in] data The data to process.
+/// @param[in] size Number of bytes of the data.
+void stream_decoder::feed(const char * data, std::size_t size)
+{
+	if (!data || (size == 0u))
+		return;
+
+	const char * const last = data + size;
+	const char * p = data;
+
+	// complete the line of the previous chunk
+	if ((pending_ > 0u) || overflow_) {
+		const char * const eol = find_eol(p, last);
+		append(p, static_cast<std::size_t>(eol - p));
+		if (eol == last)
+			return;
+		p = eol + 1;
+
+		const bool overflow = overflow_;
+		const std::size_t n = pending_;
+		reset();
+		if (overflow) {
+			if (on_error_)
+				on_error_(parse_error::malformed, buffer_.data(), n);
+		} else {
+			process_line(buffer_.data(), n);
+		}
+	}
+
+	// all complete lines within the chunk, directly from the chunk
+	for (;;) {
+		const char * const eol = find_eol(p, last);
+		if (eol == last)
+			break;
+		process_line(p, static_cast<std::size_t>(eol - p));
+		p = eol + 1;
+	}
+
+	append(p, static_cast<std::size_t>(last - p));
+}
+
+/// Appends data to the internal buffer. If the buffer is full, the remainder
+/// of the line is skipped.
+void stream_decoder::append(const char * s, std::size_t n)
+{
+	const std::size_t k = std::min(n, buffer_.size() - pending_);
+	if (k > 0u) {
+		std::memcpy(buffer_.data() + pending_, s, k);
+		pending_ += k;
+	}
+	if (k < n)
+		overflow_ = true;
+}
+
+/// Decodes one line and passes the result to the handlers. Empty lines
+/// (e.g. between CR and LF) and lines rejected by the filter are ignored.
+void stream_decoder::process_line(const char * s, std::size_t n)
+{
+	if (n == 0u)
+		return;
+	if (filter_ && !filter_->accepts(s, n))
+		return;
+	const auto e = decode_sentence(s, n, sentence_, chksum_);
+	if (e == parse_error::none)
+		on_sentence_(sentence_);
+	else if (on_error_)
+		on_error_(e, s, n);
+}
+}
+}
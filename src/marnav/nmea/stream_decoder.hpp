@@ -0,0 +1,101 @@
+#ifndef MARNAV__NMEA__STREAM_DECODER__HPP
+#define MARNAV__NMEA__STREAM_DECODER__HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <marnav/nmea/any_sentence.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Incremental decoder for raw NMEA data streams.
+///
+/// Data is pushed into the decoder in chunks of arbitrary size, as they are received
+/// from a socket, a file, an event loop, etc. The decoder frames the data into lines,
+/// decodes them and calls the sentence handler for every valid sentence. Lines may
+/// be terminated by CR, LF or CRLF, empty lines are ignored.
+///
+/// Lines which lie completely within a chunk are decoded directly from the chunk.
+/// Only lines spanning chunks are copied into an internal buffer of fixed size.
+/// The decoded sentence is kept in a variant owned by the decoder, which is reused
+/// for all lines. Therefore no memory is allocated per line for the framing and
+/// the sentence object.
+///
+/// Lines which cannot be decoded are reported to the error handler (if any) and
+/// skipped. This includes the first line if the stream is joined in the middle
+/// of a sentence, the decoder synchronizes automatically on the next end of line.
+///
+/// If a filter is set (see `set_filter`), lines which are not accepted by the
+/// filter are dropped silently before they are decoded. This includes lines
+/// which are malformed.
+///
+/// Exceptions thrown by the handlers are passed on to the caller of `feed`. The
+/// data following the line being processed is dropped in this case.
+///
+/// @note The sentence passed to the sentence handler is valid only during the call.
+///
+/// Example:
+/// @code
+///   nmea::stream_decoder decoder{[](const nmea::any_sentence & s) {
+///       if (auto rmc = utils::get_if<nmea::rmc>(&s))
+///           std::cout << rmc->get_lat().value() << "\n";
+///   }};
+///
+///   char buffer[1024];
+///   ssize_t n;
+///   while ((n = ::read(fd, buffer, sizeof(buffer))) > 0)
+///       decoder.feed(buffer, static_cast<std::size_t>(n));
+/// @endcode
+class stream_decoder
+{
+public:
+	/// Called for every successfully decoded sentence.
+	using sentence_handler = std::function<void(const any_sentence &)>;
+
+	/// Called for every line which could not be decoded. The line is passed
+	/// without end of line, it is valid only during the call.
+	using error_handler = std::function<void(parse_error, const char *, std::size_t)>;
+
+	/// Default maximum length of a line, including an optional tag block.
+	static constexpr std::size_t default_max_line_length = 1024u;
+
+	explicit stream_decoder(sentence_handler on_sentence, error_handler on_error = nullptr,
+		checksum_handling chksum = checksum_handling::check,
+		std::size_t max_line_length = default_max_line_length);
+
+	stream_decoder(const stream_decoder &) = delete;
+	stream_decoder(stream_decoder &&) = default;
+
+	stream_decoder & operator=(const stream_decoder &) = delete;
+	stream_decoder & operator=(stream_decoder &&) = default;
+
+	void feed(const char * data, std::size_t size);
+	void reset() noexcept;
+
+	void set_filter(const sentence_filter & filter);
+	void clear_filter() noexcept;
+
+	/// Returns the number of bytes of an incomplete line, kept for the next call of `feed`.
+	std::size_t pending() const noexcept { return pending_; }
+
+private:
+	void process_line(const char * s, std::size_t n);
+	void append(const char * s, std::size_t n);
+
+	sentence_handler on_sentence_;
+	error_handler on_error_;
+	checksum_handling chksum_;
+	std::vector<char> buffer_; ///< Incomplete line of the previous chunks.
+	std::size_t pending_ = 0u; ///< Number of valid bytes within the buffer.
+	bool overflow_ = false; ///< The current line exceeds the buffer, skip until end of line.
+	std::unique_ptr<sentence_filter> filter_; ///< Optional filter, applied before decoding.
+	any_sentence sentence_; ///< The sentence, reused for all lines.
+};
+}
+}
+
+#endif
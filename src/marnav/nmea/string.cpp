@@ -1,15 +1,43 @@
 #include "string.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <marnav/nmea/io.hpp>
 #include <marnav/utils/mmsi.hpp>
 
 namespace marnav
 {
 namespace nmea
 {
+/// @cond DEV
+namespace
+{
+static char * copy_to(char * first, char * last, const char * s, std::size_t n) noexcept
+{
+	if (!first || (static_cast<std::size_t>(last - first) < n))
+		return nullptr;
+	return std::copy(s, s + n, first);
+}
+
+static char * copy_to(char * first, char * last, const char * s) noexcept
+{
+	return copy_to(first, last, s, std::strlen(s));
+}
+}
+/// @endcond
+
 std::string to_string(char data)
 {
-	char buf[sizeof(int)]; // sizeof(int) is for stack anlignment and protection
-	snprintf(buf, sizeof(buf), "%c", data);
-	return buf;
+	// the zero character renders as empty string, like printf does
+	return data ? std::string(1, data) : std::string{};
+}
+
+char * to_chars(char * first, char * last, char data) noexcept
+{
+	if (!data)
+		return first;
+	return copy_to(first, last, &data, 1u);
 }
 
 std::string to_string(uint64_t data)
@@ -17,21 +45,72 @@ std::string to_string(uint64_t data)
 	return std::to_string(data);
 }
 
+char * to_chars(char * first, char * last, uint64_t data) noexcept
+{
+	return format_to(first, last, data, 0u);
+}
+
 std::string to_string(uint32_t data)
 {
 	return std::to_string(data);
 }
 
+char * to_chars(char * first, char * last, uint32_t data) noexcept
+{
+	return format_to(first, last, data, 0u);
+}
+
 std::string to_string(int32_t data)
 {
 	return std::to_string(data);
 }
 
+char * to_chars(char * first, char * last, int32_t data) noexcept
+{
+	return format_to(first, last, data, 0u);
+}
+
 std::string to_string(double data)
 {
 	char buf[32];
-	snprintf(buf, sizeof(buf), "%g", data);
-	return buf;
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), data));
+}
+
+/// Renders the same as `printf("%g")` does: six significant digits, trailing
+/// zeros removed. Values which would be rendered in exponential notation are
+/// left to the C library, all others are rendered as fixed point numbers.
+char * to_chars(char * first, char * last, double data) noexcept
+{
+	char buf[32];
+
+	const double a = std::fabs(data);
+	if (!(a >= 1.0e-4) || !(a < 999999.5)) {
+		if (data == 0.0)
+			return copy_to(first, last, std::signbit(data) ? "-0" : "0");
+		snprintf(buf, sizeof(buf), "%g", data);
+		return copy_to(first, last, buf);
+	}
+
+	// exponent of the value, rounding up to the next power of ten results
+	// in the same string after the removal of trailing zeros.
+	static const double limits[]
+		= {1.0e-3, 1.0e-2, 1.0e-1, 1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5};
+	int exponent = -4;
+	for (const auto limit : limits) {
+		if (a < limit)
+			break;
+		++exponent;
+	}
+
+	const auto decimals = static_cast<unsigned int>(5 - exponent);
+	char * end = format_to(buf, buf + sizeof(buf), data, decimals);
+	if (std::find(buf, end, '.') != end) {
+		while (*(end - 1) == '0')
+			--end;
+		if (*(end - 1) == '.')
+			--end;
+	}
+	return copy_to(first, last, buf, static_cast<std::size_t>(end - buf));
 }
 
 std::string to_string(const std::string & data)
@@ -39,7 +118,12 @@ std::string to_string(const std::string & data)
 	return data;
 }
 
-std::string to_string(side t)
+char * to_chars(char * first, char * last, const std::string & data) noexcept
+{
+	return copy_to(first, last, data.data(), data.size());
+}
+
+static const char * c_str(side t) noexcept
 {
 	switch (t) {
 		case side::left:
@@ -50,7 +134,17 @@ std::string to_string(side t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(route t)
+std::string to_string(side t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, side t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(route t) noexcept
 {
 	switch (t) {
 		case route::complete:
@@ -61,7 +155,17 @@ std::string to_string(route t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(selection_mode t)
+std::string to_string(route t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, route t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(selection_mode t) noexcept
 {
 	switch (t) {
 		case selection_mode::manual:
@@ -72,7 +176,17 @@ std::string to_string(selection_mode t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(ais_channel t)
+std::string to_string(selection_mode t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, selection_mode t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(ais_channel t) noexcept
 {
 	switch (t) {
 		case ais_channel::A:
@@ -83,7 +197,17 @@ std::string to_string(ais_channel t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(type_of_point t)
+std::string to_string(ais_channel t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, ais_channel t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(type_of_point t) noexcept
 {
 	switch (t) {
 		case type_of_point::collision:
@@ -98,7 +222,17 @@ std::string to_string(type_of_point t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(direction t)
+std::string to_string(type_of_point t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, type_of_point t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(direction t) noexcept
 {
 	switch (t) {
 		case direction::north:
@@ -115,7 +249,17 @@ std::string to_string(direction t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(reference t)
+std::string to_string(direction t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, direction t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(reference t) noexcept
 {
 	switch (t) {
 		case reference::TRUE:
@@ -128,7 +272,17 @@ std::string to_string(reference t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(mode_indicator t)
+std::string to_string(reference t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, reference t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(mode_indicator t) noexcept
 {
 	switch (t) {
 		case mode_indicator::invalid:
@@ -151,7 +305,17 @@ std::string to_string(mode_indicator t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(status t)
+std::string to_string(mode_indicator t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, mode_indicator t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(status t) noexcept
 {
 	switch (t) {
 		case status::ok:
@@ -162,7 +326,17 @@ std::string to_string(status t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(quality t)
+std::string to_string(status t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, status t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(quality t) noexcept
 {
 	switch (t) {
 		case quality::invalid:
@@ -179,7 +353,17 @@ std::string to_string(quality t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(target_status t)
+std::string to_string(quality t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, quality t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(target_status t) noexcept
 {
 	switch (t) {
 		case target_status::lost:
@@ -192,7 +376,17 @@ std::string to_string(target_status t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(unit::distance t)
+std::string to_string(target_status t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, target_status t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(unit::distance t) noexcept
 {
 	switch (t) {
 		case unit::distance::meter:
@@ -209,7 +403,17 @@ std::string to_string(unit::distance t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(unit::velocity t)
+std::string to_string(unit::distance t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, unit::distance t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(unit::velocity t) noexcept
 {
 	switch (t) {
 		case unit::velocity::knot:
@@ -222,7 +426,17 @@ std::string to_string(unit::velocity t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(unit::temperature t)
+std::string to_string(unit::velocity t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, unit::velocity t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(unit::temperature t) noexcept
 {
 	switch (t) {
 		case unit::temperature::celsius:
@@ -231,7 +445,17 @@ std::string to_string(unit::temperature t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
-std::string to_string(unit::pressure t)
+std::string to_string(unit::temperature t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, unit::temperature t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
+static const char * c_str(unit::pressure t) noexcept
 {
 	switch (t) {
 		case unit::pressure::bar:
@@ -242,11 +466,25 @@ std::string to_string(unit::pressure t)
 	return ""; // never reached, gcc does not get it, prevents compiler warning
 }
 
+std::string to_string(unit::pressure t)
+{
+	return c_str(t);
+}
+
+char * to_chars(char * first, char * last, unit::pressure t) noexcept
+{
+	return copy_to(first, last, c_str(t));
+}
+
 std::string to_string(const utils::mmsi & t)
 {
 	char buf[16];
-	snprintf(buf, sizeof(buf), "%09u", static_cast<uint32_t>(t));
-	return buf;
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), t));
+}
+
+char * to_chars(char * first, char * last, const utils::mmsi & t) noexcept
+{
+	return format_to(first, last, static_cast<uint32_t>(t), 9);
 }
 }
 }
@@ -63,7 +63,7 @@ tag_block::tag_block(const std::string & s)
 	if (fields.size() < 1u)
 		throw std::invalid_argument{"malformed tag block in nmea/tag_block"};
 
-	detail::ensure_checksum(s, fields.back(), 0u);
+	detail::ensure_checksum(s, 0u);
 
 	// it is assumed, each field has the form "x:yyy" with 'x' as the field type (1 character),
 	// a delimiter of one colon (':', 1 character), followed by the data.
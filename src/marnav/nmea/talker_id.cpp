@@ -1,5 +1,6 @@
 #include "talker_id.hpp"
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace marnav
@@ -89,6 +90,21 @@ std::string to_string(talker t)
 	return (i == std::end(detail::entries)) ? "-" : i->id;
 }
 
+/// Writes the talker ID into the buffer, the same as `to_string` returns.
+///
+/// @return Pointer after the last written character, `nullptr` if the buffer is
+///   too small or `first` is `nullptr`.
+char * to_chars(char * first, char * last, talker t) noexcept
+{
+	auto i = std::find_if(std::begin(detail::entries), std::end(detail::entries),
+		[&](const detail::entry & e) { return t == e.t; });
+	const char * id = (i == std::end(detail::entries)) ? "-" : i->id;
+	const std::size_t n = std::strlen(id);
+	if (!first || (static_cast<std::size_t>(last - first) < n))
+		return nullptr;
+	return std::copy(id, id + n, first);
+}
+
 /// Returns a talker from the specified string.
 ///
 /// @param[in] s The string to create a talker from. This must be
@@ -102,9 +118,36 @@ talker make_talker(const std::string & s)
 {
 	if (s.size() != 2)
 		throw std::invalid_argument{"invalid talker in make_talker: " + s};
-	auto i = std::find_if(std::begin(detail::entries), std::end(detail::entries),
-		[&](const detail::entry & e) { return s == e.id; });
-	return (i == std::end(detail::entries)) ? talker::none : i->t;
+	return make_talker(s[0], s[1]);
+}
+
+/// Returns a talker from the two characters of its ID, without creating
+/// a temporary string.
+///
+/// @return The corresponding talker or talker::none if the characters
+///   do not represent a known talker.
+talker make_talker(char c0, char c1) noexcept
+{
+	// all talker IDs consist of two upper case letters, therefore a table over
+	// all combinations is small enough, built once on first use.
+	struct table {
+		talker t[26][26];
+
+		table()
+		{
+			for (auto & row : t)
+				for (auto & e : row)
+					e = talker::none;
+			for (const auto & e : detail::entries)
+				if (e.id[0] != '\0')
+					t[e.id[0] - 'A'][e.id[1] - 'A'] = e.t;
+		}
+	};
+	static const table lookup;
+
+	if ((c0 < 'A') || (c0 > 'Z') || (c1 < 'A') || (c1 > 'Z'))
+		return talker::none;
+	return lookup.t[c0 - 'A'][c1 - 'A'];
 }
 }
 }
@@ -83,7 +83,9 @@ enum class talker {
 using talker_id = talker; // deprecated
 
 std::string to_string(talker t);
+char * to_chars(char * first, char * last, talker t) noexcept;
 talker make_talker(const std::string & s);
+talker make_talker(char c0, char c1) noexcept;
 }
 }
 
@@ -1,5 +1,7 @@
 #include "time.hpp"
 #include <stdexcept>
+#include <marnav/nmea/io.hpp>
+#include <marnav/nmea/numeric.hpp>
 
 namespace marnav
 {
@@ -11,21 +13,24 @@ namespace
 {
 template <class T> static T parse_time(const std::string & str)
 {
+	const auto t = parse_hhmmss(str.data(), str.data() + str.size());
+	if (!t)
+		throw std::invalid_argument{"invalid format, 'HHMMSS[.mmm]' expected"};
 	try {
-		std::size_t pos = 0;
-		double t = std::stod(str, &pos);
-		if (pos != str.size())
-			throw std::invalid_argument{"invalid format for 'double'"};
-
-		const uint32_t h = static_cast<uint32_t>(t / 10000) % 100;
-		const uint32_t m = static_cast<uint32_t>(t / 100) % 100;
-		const uint32_t s = static_cast<uint32_t>(t) % 100;
-		const uint32_t ms = static_cast<uint32_t>(t * 1000) % 1000;
-		return T{h, m, s, ms};
+		return T{t->hour, t->minutes, t->seconds, t->milliseconds};
 	} catch (std::invalid_argument &) {
 		throw std::invalid_argument{"invalid format, 'HHMMSS[.mmm]' expected"};
 	}
 }
+
+/// Writes 'hhmmss' into the buffer, `nullptr` if the buffer is too small.
+static char * format_hms(
+	char * first, char * last, uint32_t h, uint32_t m, uint32_t s) noexcept
+{
+	first = format_to(first, last, h, 2);
+	first = format_to(first, last, m, 2);
+	return format_to(first, last, s, 2);
+}
 }
 /// @endcond
 
@@ -72,9 +77,13 @@ time time::parse(const std::string & str)
 /// Returns a string representation in the form 'hhmmss', does not render fractions of seconds.
 std::string to_string(const time & t)
 {
-	char buf[7];
-	snprintf(buf, sizeof(buf), "%02u%02u%02u", t.hour(), t.minutes(), t.seconds());
-	return buf;
+	char buf[32];
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), t));
+}
+
+char * to_chars(char * first, char * last, const time & t) noexcept
+{
+	return format_hms(first, last, t.hour(), t.minutes(), t.seconds());
 }
 
 /// Returns the data as formatted string.
@@ -91,14 +100,15 @@ std::string format(const nmea::time & t, unsigned int width)
 	if (width > 3)
 		width = 3;
 
-	char fmt[32];
-	snprintf(fmt, sizeof(fmt), "%%02u%%02u%%02u.%%0%uu", width);
 	uint32_t div = 1;
 	for (unsigned int i = 0; i < width; ++i)
 		div *= 10;
 	char buf[64];
-	snprintf(buf, sizeof(buf), fmt, t.hour(), t.minutes(), t.seconds(), t.milliseconds() / div);
-	return buf;
+	const auto e = buf + sizeof(buf);
+	char * p = format_hms(buf, e, t.hour(), t.minutes(), t.seconds());
+	*p++ = '.';
+	p = format_to(p, e, t.milliseconds() / div, width);
+	return std::string(buf, p);
 }
 
 /// Parses the duration information within the specified string (start and end of string).
@@ -120,9 +130,13 @@ duration duration::parse(const std::string & str)
 /// Returns a string representation in the form 'hhmmss', does not render fractions of seconds.
 std::string to_string(const duration & d)
 {
-	char buf[7];
-	snprintf(buf, sizeof(buf), "%02u%02u%02u", d.hour(), d.minutes(), d.seconds());
-	return buf;
+	char buf[32];
+	return std::string(buf, to_chars(buf, buf + sizeof(buf), d));
+}
+
+char * to_chars(char * first, char * last, const duration & d) noexcept
+{
+	return format_hms(first, last, d.hour(), d.minutes(), d.seconds());
 }
 }
 }
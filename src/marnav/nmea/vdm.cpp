@@ -48,5 +48,15 @@ void vdm::append_data_to(std::string & s) const
 	append(s, to_string(payload_));
 	append(s, to_string(n_fill_bits_));
 }
+
+char * vdm::write_data_to(char * first, char * last) const
+{
+	first = to_chars(write_delimiter(first, last), last, n_fragments_);
+	first = to_chars(write_delimiter(first, last), last, fragment_);
+	first = to_chars(write_delimiter(first, last), last, seq_msg_id_);
+	first = to_chars(write_delimiter(first, last), last, radio_channel_);
+	first = to_chars(write_delimiter(first, last), last, payload_);
+	return to_chars(write_delimiter(first, last), last, n_fill_bits_);
+}
 }
 }
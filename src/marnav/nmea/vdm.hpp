@@ -45,6 +45,7 @@ protected:
 	vdm(talker talk, fields::const_iterator first, fields::const_iterator last);
 
 	virtual void append_data_to(std::string &) const override;
+	virtual char * write_data_to(char * first, char * last) const override;
 	virtual char get_start_token() const override { return start_token_ais; }
 
 	void read_fields(fields::const_iterator first);
@@ -71,5 +71,18 @@ void vtg::append_data_to(std::string & s) const
 	append(s, to_string(speed_kmh_unit_));
 	append(s, to_string(mode_ind_));
 }
+
+char * vtg::write_data_to(char * first, char * last) const
+{
+	first = to_chars(write_delimiter(first, last), last, track_true_);
+	first = to_chars(write_delimiter(first, last), last, type_true_);
+	first = to_chars(write_delimiter(first, last), last, track_magn_);
+	first = to_chars(write_delimiter(first, last), last, type_magn_);
+	first = to_chars(write_delimiter(first, last), last, speed_kn_);
+	first = to_chars(write_delimiter(first, last), last, speed_kn_unit_);
+	first = to_chars(write_delimiter(first, last), last, speed_kmh_);
+	first = to_chars(write_delimiter(first, last), last, speed_kmh_unit_);
+	return to_chars(write_delimiter(first, last), last, mode_ind_);
+}
 }
 }
@@ -48,6 +48,7 @@ public:
 protected:
 	vtg(talker talk, fields::const_iterator first, fields::const_iterator last);
 	virtual void append_data_to(std::string &) const override;
+	virtual char * write_data_to(char * first, char * last) const override;
 
 private:
 	utils::optional<double> track_true_;
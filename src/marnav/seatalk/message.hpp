@@ -4,6 +4,7 @@
 #include <vector>
 #include <functional>
 #include <typeinfo>
+#include <stdexcept>
 #include <marnav/utils/unique.hpp>
 
 namespace marnav
@@ -1,6 +1,7 @@
 #include "seatalk.hpp"
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <marnav/seatalk/message_00.hpp>
 #include <marnav/seatalk/message_01.hpp>
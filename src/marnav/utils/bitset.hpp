@@ -4,8 +4,11 @@
 /// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
 /// The code is licensed under the BSD License (see file LICENSE)
 
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 #include <cassert>
@@ -26,6 +29,10 @@ namespace utils
 /// claims nor wants to be.
 ///
 /// @tparam Block The data type of the underlying block type.
+/// @tparam Container The container to hold the blocks. This is a `std::vector` by
+///   default, which grows dynamically. A container with fixed capacity, like
+///   `utils::fixed_vector`, may be used to avoid dynamic memory allocations at
+///   the cost of a maximum size.
 ///
 /// **Example:** appending individual bits
 /// @code
@@ -51,10 +58,13 @@ namespace utils
 /// bits.set(1, 512, 1); // set one bit to 1 at offset 512
 /// @endcode
 ///
-template <class Block,
+template <class Block, class Container = std::vector<Block>,
 	class = typename std::enable_if<!std::numeric_limits<Block>::is_signed>::type>
 class bitset
 {
+	static_assert(std::is_same<Block, typename Container::value_type>::value,
+		"container must hold elements of the block type");
+
 public:
 	using block_type = Block;
 
@@ -65,7 +75,7 @@ public:
 	static constexpr auto bits_per_block = sizeof(block_type) * bits_per_byte;
 
 public:
-	using container = std::vector<block_type>;
+	using container = Container;
 	using size_type = typename container::size_type;
 	using data_const_iterator = typename container::const_iterator;
 
@@ -342,7 +352,7 @@ private:
 
 		// fraction of the last block
 		if (bits > 0) {
-			set_block(v << (bits_per_block - bits), ofs);
+			set_block(v, ofs, bits);
 		}
 	}
 
@@ -388,6 +398,77 @@ private:
 		}
 	}
 
+	/// Throws the exception for `get` if the number of bits exceeds the data type.
+	///
+	/// The construction of the message is kept out of `get`, which keeps it small.
+	[[noreturn]] static void throw_invalid_number_of_bits(size_type bits, size_type available)
+	{
+		throw std::invalid_argument{"number of bits (" + std::to_string(bits)
+			+ ") exceed number of available bits (" + std::to_string(available) + ")"};
+	}
+
+	/// Throws the exception for `get` if offset and bits exceed the data.
+	[[noreturn]] void throw_out_of_range(size_type ofs, size_type bits) const
+	{
+		throw std::out_of_range{"offset (" + std::to_string(ofs) + ") and bits ("
+			+ std::to_string(bits) + ") exceed available number of bits ("
+			+ std::to_string(pos) + ")"};
+	}
+
+	/// Converts the specified word, loaded from memory in big endian order, to
+	/// the native byte order.
+	static uint64_t load_big_endian(uint64_t w) noexcept
+	{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		return w;
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) \
+	&& (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		return __builtin_bswap64(w);
+#else
+		const uint8_t * p = reinterpret_cast<const uint8_t *>(&w);
+		uint64_t result = 0;
+		for (size_type k = 0; k < sizeof(w); ++k)
+			result = (result << 8) | p[k];
+		return result;
+#endif
+	}
+
+	/// Maximum number of bits which can be read by `get_window`.
+	static constexpr size_type max_window_bits = 57u;
+
+	/// Reads up to `max_window_bits` bits at once, for byte sized blocks only.
+	///
+	/// The 8 bytes containing the desired bits are loaded into a 64 bit word in
+	/// big endian order, the value is extracted with one shift and one mask.
+	/// Near the end of the data, the window is moved back to end with the last byte,
+	/// which avoids reading past the end of the container. Only containers
+	/// smaller than 8 bytes are read byte by byte.
+	///
+	/// @param[in] ofs The offset in bits at which the data has to be read.
+	/// @param[in] bits Number of bits to be read, between 1 and `max_window_bits`.
+	/// @return The read bits, right aligned.
+	uint64_t get_window(size_type ofs, size_type bits) const noexcept
+	{
+		assert(bits_per_block == 8u);
+		assert(bits > 0 && bits <= max_window_bits);
+
+		size_type i = ofs / bits_per_block;
+		uint64_t w = 0;
+		if (data.size() >= 8u) {
+			if (data.size() - i < 8u)
+				i = data.size() - 8u;
+			std::memcpy(&w, &data[i], sizeof(w));
+			w = load_big_endian(w);
+		} else {
+			i = 0;
+			for (size_type k = 0; k < 8u; ++k)
+				w = (w << 8) | (k < data.size() ? static_cast<uint8_t>(data[k]) : 0u);
+		}
+
+		const size_type shift = 64u - (ofs - i * bits_per_block) - bits;
+		return (w >> shift) & ((uint64_t{1} << bits) - 1u);
+	}
+
 	/// Copies a block from source to destination offsets.
 	///
 	/// This is the equivalent of `set_block(get_block(...), ...)`
@@ -443,6 +524,21 @@ public: // constructors
 	{
 	}
 
+	/// Construction with move of the container and the specified number of used bits,
+	/// this does not copy any data. Bits past the specified number of bits are expected
+	/// to be zero.
+	///
+	/// @param[in] container The blocks to take over.
+	/// @param[in] bits Number of used bits, must not exceed the capacity of the container.
+	/// @exception std::invalid_argument The number of bits exceeds the container.
+	bitset(container && container, size_type bits)
+		: pos(bits)
+		, data(std::move(container))
+	{
+		if (bits > capacity())
+			throw std::invalid_argument{"number of bits exceed capacity"};
+	}
+
 	/// Constructs a bitset from the specified range.
 	///
 	/// It tries to copy blockwise.
@@ -525,7 +621,7 @@ public: // append
 	///
 	/// @note It is not allowed to append a bitself to itself.
 	/// @note This algorithm is not efficient.
-	template <class U> void append(const bitset<U> & bs)
+	template <class U, class C> void append(const bitset<U, C> & bs)
 	{
 		if (reinterpret_cast<const void *>(this) == reinterpret_cast<const void *>(&bs))
 			return;
@@ -571,7 +667,7 @@ public: // set
 	///
 	/// @note It is not allowed to set a bitself to itself.
 	/// @note This algorithm is not efficient.
-	template <class U> void set(const bitset<U> & bs, size_type ofs)
+	template <class U, class C> void set(const bitset<U, C> & bs, size_type ofs)
 	{
 		if (reinterpret_cast<const void *>(this) == reinterpret_cast<const void *>(&bs))
 			return;
@@ -671,13 +767,14 @@ public: // get
 		if (bits <= 0)
 			return T{};
 		if (bits > sizeof(T) * bits_per_byte)
-			throw std::invalid_argument{"number of bits (" + std::to_string(bits)
-				+ ") exceed number of available bits ("
-				+ std::to_string(sizeof(T) * bits_per_byte) + ")"};
+			throw_invalid_number_of_bits(bits, sizeof(T) * bits_per_byte);
 		if (ofs + bits > pos)
-			throw std::out_of_range{"offset (" + std::to_string(ofs) + ") and bits ("
-				+ std::to_string(bits) + ") exceed available number of bits ("
-				+ std::to_string(pos) + ")"};
+			throw_out_of_range(ofs, bits);
+
+		// fast path: the whole value is accessible within one 64 bit window.
+		// the condition on the block size is known at compile time.
+		if ((bits_per_block == 8u) && (bits <= max_window_bits))
+			return static_cast<T>(get_window(ofs, bits));
 
 		T value = 0;
 
@@ -757,9 +854,9 @@ public: // comparison operators
 	/// Since the blocks differ, a comparison bit by bit is done.
 	///
 	/// @note This is implemented for readablility, not max performance.
-	template <class XBlock,
+	template <class XBlock, class XContainer,
 		class = typename std::enable_if<!std::numeric_limits<XBlock>::is_signed>::type>
-	bool operator==(const bitset<XBlock> & other) const
+	bool operator==(const bitset<XBlock, XContainer> & other) const
 	{
 		if (size() != other.size())
 			return false;
@@ -780,9 +877,9 @@ public: // comparison operators
 	/// Since the blocks differ, a comparison bit by bit is done.
 	///
 	/// @note This is implemented for readablility, not max performance.
-	template <class XBlock,
+	template <class XBlock, class XContainer,
 		class = typename std::enable_if<!std::numeric_limits<XBlock>::is_signed>::type>
-	bool operator!=(const bitset<XBlock> & other) const
+	bool operator!=(const bitset<XBlock, XContainer> & other) const
 	{
 		return !(*this == other);
 	}
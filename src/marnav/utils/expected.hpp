@@ -0,0 +1,100 @@
+#ifndef MARNAV__UTILS__EXPECTED__HPP
+#define MARNAV__UTILS__EXPECTED__HPP
+
+#include <utility>
+
+namespace marnav
+{
+namespace utils
+{
+/// @brief Wrapper to construct an `expected` carrying an error.
+///
+/// @tparam E Error type.
+template <class E> struct unexpected {
+	E value;
+};
+
+/// @brief Creates an `unexpected` from the specified error.
+template <class E> constexpr unexpected<E> make_unexpected(E e)
+{
+	return unexpected<E>{e};
+}
+
+/// @brief Carries either a value or an error.
+///
+/// This is a very reduced version of the proposed `std::expected`, used by the
+/// parts of the library which report errors without exceptions.
+///
+/// @tparam T Data type to be held in case of success.
+/// @tparam E Error type, usually an enumeration.
+///
+/// @note Similar to `utils::optional`, the value is stored as member data, not as
+///   pointer. This means `T` must be default constructible. In the error state the
+///   value is the default constructed type.
+///
+/// @note There is no support for exceptions on access. Accessing the value of an
+///   `expected` carrying an error, or the error of one carrying a value, is undefined.
+///
+template <class T, class E> class expected
+{
+public:
+	using value_type = T;
+	using error_type = E;
+
+	expected(const T & data)
+		: flag_(true)
+		, data_(data)
+		, error_()
+	{
+	}
+
+	expected(T && data)
+		: flag_(true)
+		, data_(std::move(data))
+		, error_()
+	{
+	}
+
+	expected(const unexpected<E> & e)
+		: flag_(false)
+		, data_()
+		, error_(e.value)
+	{
+	}
+
+	expected(const expected &) = default;
+	expected(expected &&) = default;
+	expected & operator=(const expected &) = default;
+	expected & operator=(expected &&) = default;
+
+	// observers
+
+	const T * operator->() const { return &data_; }
+
+	T * operator->() { return &data_; }
+
+	const T & operator*() const & { return data_; }
+
+	T & operator*() & { return data_; }
+
+	constexpr explicit operator bool() const { return flag_; }
+
+	constexpr bool has_value() const { return flag_; }
+
+	const T & value() const & { return data_; }
+
+	T & value() & { return data_; }
+
+	T && value() && { return std::move(data_); }
+
+	constexpr const E & error() const { return error_; }
+
+private:
+	bool flag_;
+	T data_;
+	E error_;
+};
+}
+}
+
+#endif
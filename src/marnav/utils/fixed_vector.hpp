@@ -0,0 +1,131 @@
+#ifndef MARNAV__UTILS__FIXED_VECTOR__HPP
+#define MARNAV__UTILS__FIXED_VECTOR__HPP
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace utils
+{
+/// @brief Sequence container with a fixed capacity, storing its elements inline.
+///
+/// This container provides the subset of the `std::vector` interface which is
+/// needed by `utils::bitset`, but never allocates memory. All elements are part
+/// of the object itself, which makes it suitable to hold small amounts of data
+/// of known maximum size on the stack.
+///
+/// @tparam T Data type of the elements, must be default constructible.
+/// @tparam N Maximum number of elements.
+///
+/// @note Exceeding the capacity results in a `std::length_error`.
+///
+template <class T, std::size_t N> class fixed_vector
+{
+	using storage = std::array<T, N>;
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = T &;
+	using const_reference = const T &;
+	using iterator = typename storage::iterator;
+	using const_iterator = typename storage::const_iterator;
+
+	fixed_vector()
+		: size_(0)
+		, data_()
+	{
+	}
+
+	template <class InputIt>
+	fixed_vector(InputIt first, InputIt last)
+		: fixed_vector()
+	{
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	fixed_vector(std::initializer_list<T> init_list)
+		: fixed_vector(init_list.begin(), init_list.end())
+	{
+	}
+
+	fixed_vector(const fixed_vector &) = default;
+	fixed_vector(fixed_vector &&) = default;
+	fixed_vector & operator=(const fixed_vector &) = default;
+	fixed_vector & operator=(fixed_vector &&) = default;
+
+	static constexpr size_type max_size() noexcept { return N; }
+
+	size_type size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	size_type capacity() const noexcept { return N; }
+
+	/// Does not allocate anything, the storage is always there. Like `std::vector`,
+	/// requests beyond `max_size` are rejected.
+	///
+	/// @exception std::length_error The requested size exceeds the capacity.
+	void reserve(size_type n)
+	{
+		if (n > N)
+			throw std::length_error{"fixed_vector: capacity exceeded"};
+	}
+
+	void clear() noexcept { size_ = 0; }
+
+	/// @exception std::length_error The capacity is exhausted.
+	void push_back(const T & value)
+	{
+		if (size_ >= N)
+			throw std::length_error{"fixed_vector: capacity exceeded"};
+		data_[size_] = value;
+		++size_;
+	}
+
+	void assign(std::initializer_list<T> init_list)
+	{
+		reserve(init_list.size());
+		std::copy(init_list.begin(), init_list.end(), data_.begin());
+		size_ = init_list.size();
+	}
+
+	reference operator[](size_type i) { return data_[i]; }
+
+	const_reference operator[](size_type i) const { return data_[i]; }
+
+	T * data() noexcept { return data_.data(); }
+
+	const T * data() const noexcept { return data_.data(); }
+
+	iterator begin() noexcept { return data_.begin(); }
+
+	iterator end() noexcept { return data_.begin() + size_; }
+
+	const_iterator begin() const noexcept { return data_.begin(); }
+
+	const_iterator end() const noexcept { return data_.begin() + size_; }
+
+	const_iterator cbegin() const noexcept { return data_.cbegin(); }
+
+	const_iterator cend() const noexcept { return data_.cbegin() + size_; }
+
+	bool operator==(const fixed_vector & other) const
+	{
+		return (size_ == other.size_) && std::equal(begin(), end(), other.begin());
+	}
+
+	bool operator!=(const fixed_vector & other) const { return !(*this == other); }
+
+private:
+	size_type size_;
+	storage data_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef MARNAV__UTILS__VARIANT__HPP
+#define MARNAV__UTILS__VARIANT__HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace marnav
+{
+namespace utils
+{
+/// @cond DEV
+namespace detail
+{
+template <std::size_t A, std::size_t... B> struct static_max;
+
+template <std::size_t A>
+struct static_max<A> : std::integral_constant<std::size_t, A> {
+};
+
+template <std::size_t A, std::size_t B, std::size_t... C>
+struct static_max<A, B, C...> : static_max<(A > B ? A : B), C...> {
+};
+
+/// Index of type `T` within the list of types, equals the number of types
+/// if `T` is not part of the list.
+template <class T, class... Ts> struct type_index;
+
+template <class T> struct type_index<T> : std::integral_constant<std::size_t, 0u> {
+};
+
+template <class T, class... Ts>
+struct type_index<T, T, Ts...> : std::integral_constant<std::size_t, 0u> {
+};
+
+template <class T, class U, class... Ts>
+struct type_index<T, U, Ts...>
+	: std::integral_constant<std::size_t, 1u + type_index<T, Ts...>::value> {
+};
+
+template <bool... B> struct bool_pack {
+};
+
+/// True if all of the values are true.
+template <bool... B>
+struct all_of : std::is_same<bool_pack<true, B...>, bool_pack<B..., true>> {
+};
+
+template <class... Ts> struct first_type;
+
+template <class T, class... Ts> struct first_type<T, Ts...> {
+	using type = T;
+};
+}
+/// @endcond
+
+/// @brief Holds a value of one of the specified types.
+///
+/// This is a very reduced version of `std::variant`, storing the value within the
+/// object itself, without any dynamic memory allocation. A default constructed
+/// variant holds a default constructed value of the first type.
+///
+/// The contained value is accessed by `get`, `get_if` or `visit`. Accessing
+/// the value as a type other than the contained one results in `std::bad_cast`.
+///
+/// @tparam Ts The types the variant may hold, all must be distinct, nothrow
+///   move constructible and the first one default constructible.
+///
+/// @note If the construction of a new value by `emplace` or by assignment throws,
+///   the variant is unchanged.
+///
+/// Example:
+/// @code
+///   utils::variant<int, std::string> v = std::string{"hello"};
+///   utils::visit([](const auto & t) { std::cout << t; }, v);  // C++14
+/// @endcode
+///
+template <class... Ts> class variant
+{
+	static_assert(sizeof...(Ts) > 0u, "variant must hold at least one type");
+	static_assert(detail::all_of<std::is_nothrow_move_constructible<Ts>::value...>::value,
+		"all types of variant must be nothrow move constructible");
+
+public:
+	/// Number of types the variant may hold.
+	static constexpr std::size_t size = sizeof...(Ts);
+
+	/// Index of the specified type, equals `size` if the type is not part of the variant.
+	template <class T> using index_of = detail::type_index<T, Ts...>;
+
+	variant()
+		: index_(0u)
+	{
+		new (&storage_) first();
+	}
+
+	variant(const variant & other)
+		: index_(other.index_)
+	{
+		static void (*const table[])(void *, const void *) = {&copy_construct<Ts>...};
+		table[index_](&storage_, &other.storage_);
+	}
+
+	variant(variant && other) noexcept
+		: index_(other.index_)
+	{
+		static void (*const table[])(void *, void *) = {&move_construct<Ts>...};
+		table[index_](&storage_, &other.storage_);
+	}
+
+	/// Constructs the variant holding the specified value.
+	template <class T, class U = typename std::decay<T>::type,
+		typename = typename std::enable_if<(index_of<U>::value < size)>::type>
+	variant(T && t)
+		: index_(index_of<U>::value)
+	{
+		new (&storage_) U(std::forward<T>(t));
+	}
+
+	~variant() { destroy(); }
+
+	variant & operator=(const variant & other)
+	{
+		if (this != &other)
+			*this = variant{other};
+		return *this;
+	}
+
+	variant & operator=(variant && other) noexcept
+	{
+		if (this != &other) {
+			static void (*const table[])(void *, void *) = {&move_construct<Ts>...};
+			destroy();
+			index_ = other.index_;
+			table[index_](&storage_, &other.storage_);
+		}
+		return *this;
+	}
+
+	/// Assigns the specified value, the variant holds its type afterwards.
+	/// If the variant already holds this type, the value is assigned in place.
+	template <class T, class U = typename std::decay<T>::type,
+		typename = typename std::enable_if<(index_of<U>::value < size)>::type>
+	variant & operator=(T && t)
+	{
+		if (holds<U>())
+			*reinterpret_cast<U *>(&storage_) = std::forward<T>(t);
+		else
+			emplace<U>(std::forward<T>(t));
+		return *this;
+	}
+
+	/// Returns the index of the type currently held.
+	std::size_t index() const noexcept { return index_; }
+
+	/// Returns true if the variant holds the specified type.
+	template <class T> bool holds() const noexcept { return index_ == index_of<T>::value; }
+
+	/// Replaces the current value by a new value of type `T`, constructed from
+	/// the specified arguments.
+	///
+	/// The new value is constructed before the current one is destroyed, the
+	/// arguments may therefore refer to the current value.
+	///
+	/// @return The new value.
+	template <class T, class... Args> T & emplace(Args &&... args)
+	{
+		static_assert(index_of<T>::value < size, "type not part of variant");
+		T t(std::forward<Args>(args)...);
+		destroy();
+		new (&storage_) T(std::move(t));
+		index_ = index_of<T>::value;
+		return *reinterpret_cast<T *>(&storage_);
+	}
+
+	/// Returns a pointer to the value if the variant holds type `T`, `nullptr` otherwise.
+	template <class T> T * get_if() noexcept
+	{
+		return holds<T>() ? reinterpret_cast<T *>(&storage_) : nullptr;
+	}
+
+	/// Const variant.
+	template <class T> const T * get_if() const noexcept
+	{
+		return holds<T>() ? reinterpret_cast<const T *>(&storage_) : nullptr;
+	}
+
+	/// Returns the value as type `T`.
+	///
+	/// @exception std::bad_cast The variant does not hold type `T`.
+	template <class T> T & get()
+	{
+		if (!holds<T>())
+			throw std::bad_cast{};
+		return *reinterpret_cast<T *>(&storage_);
+	}
+
+	/// Const variant.
+	template <class T> const T & get() const
+	{
+		if (!holds<T>())
+			throw std::bad_cast{};
+		return *reinterpret_cast<const T *>(&storage_);
+	}
+
+	/// Calls the specified function with the contained value. The function must
+	/// accept all types of the variant and return the same type for all of them.
+	///
+	/// The dispatch is done by a table of functions, indexed by the type index.
+	template <class F>
+	auto visit(F && f)
+		-> decltype(f(std::declval<typename detail::first_type<Ts...>::type &>()))
+	{
+		using result = decltype(f(std::declval<first &>()));
+		using function = typename std::remove_reference<F>::type;
+		static result (*const table[])(function &, void *) = {&invoke<result, function, Ts>...};
+		return table[index_](f, &storage_);
+	}
+
+	/// Const variant.
+	template <class F>
+	auto visit(F && f) const
+		-> decltype(f(std::declval<const typename detail::first_type<Ts...>::type &>()))
+	{
+		using result = decltype(f(std::declval<const first &>()));
+		using function = typename std::remove_reference<F>::type;
+		static result (*const table[])(function &, const void *)
+			= {&invoke_const<result, function, Ts>...};
+		return table[index_](f, &storage_);
+	}
+
+private:
+	using first = typename detail::first_type<Ts...>::type;
+
+	template <class T> static void copy_construct(void * dst, const void * src)
+	{
+		new (dst) T(*static_cast<const T *>(src));
+	}
+
+	template <class T> static void move_construct(void * dst, void * src) noexcept
+	{
+		new (dst) T(std::move(*static_cast<T *>(src)));
+	}
+
+	template <class T> static void destruct(void * p) noexcept { static_cast<T *>(p)->~T(); }
+
+	template <class R, class F, class T> static R invoke(F & f, void * p)
+	{
+		return f(*static_cast<T *>(p));
+	}
+
+	template <class R, class F, class T> static R invoke_const(F & f, const void * p)
+	{
+		return f(*static_cast<const T *>(p));
+	}
+
+	void destroy() noexcept
+	{
+		static void (*const table[])(void *) = {&destruct<Ts>...};
+		table[index_](&storage_);
+	}
+
+	std::size_t index_;
+	typename std::aligned_storage<detail::static_max<sizeof(Ts)...>::value,
+		detail::static_max<alignof(Ts)...>::value>::type storage_;
+};
+
+template <class... Ts> constexpr std::size_t variant<Ts...>::size;
+
+/// Returns true if the variant holds the specified type.
+template <class T, class... Ts> bool holds_alternative(const variant<Ts...> & v) noexcept
+{
+	return v.template holds<T>();
+}
+
+/// @see variant::get
+template <class T, class... Ts> T & get(variant<Ts...> & v)
+{
+	return v.template get<T>();
+}
+
+/// @see variant::get
+template <class T, class... Ts> const T & get(const variant<Ts...> & v)
+{
+	return v.template get<T>();
+}
+
+/// @see variant::get_if
+template <class T, class... Ts> T * get_if(variant<Ts...> * v) noexcept
+{
+	return v ? v->template get_if<T>() : nullptr;
+}
+
+/// @see variant::get_if
+template <class T, class... Ts> const T * get_if(const variant<Ts...> * v) noexcept
+{
+	return v ? v->template get_if<T>() : nullptr;
+}
+
+/// @see variant::visit
+template <class F, class... Ts>
+auto visit(F && f, variant<Ts...> & v) -> decltype(v.visit(std::forward<F>(f)))
+{
+	return v.visit(std::forward<F>(f));
+}
+
+/// @see variant::visit
+template <class F, class... Ts>
+auto visit(F && f, const variant<Ts...> & v) -> decltype(v.visit(std::forward<F>(f)))
+{
+	return v.visit(std::forward<F>(f));
+}
+}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include <marnav/ais/ais.hpp>
+#include <marnav/ais/any_message.hpp>
 
 namespace
 {
@@ -47,4 +48,17 @@ static void Benchmark_make_message(benchmark::State & state)
 
 BENCHMARK(Benchmark_make_message)->Apply(all_messages);
 
+static void Benchmark_decode_message(benchmark::State & state)
+{
+	state.SetLabel(messages[state.range(0)].label);
+	marnav::ais::any_message tmp;
+	while (state.KeepRunning()) {
+		auto rc = marnav::ais::decode_message(messages[state.range(0)].data, tmp);
+		benchmark::DoNotOptimize(rc);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_decode_message)->Apply(all_messages);
+
 BENCHMARK_MAIN()
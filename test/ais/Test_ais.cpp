@@ -55,6 +55,105 @@ TEST_F(Test_ais, make_message)
 	auto result = ais::make_message(v);
 }
 
+TEST_F(Test_ais, make_message_roundtrip_fragments_and_padding)
+{
+	using payload = std::vector<std::pair<std::string, uint32_t>>;
+
+	const std::vector<payload> data = {
+		{{"55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53", 0},
+			{"1@0000000000000", 2}},
+		{{"E@28isPVa9Qh:0a90SWW0h@@@@@@2kJP;hHP@00003v0100", 2}},
+		{{"G00000000000000000000000000", 2}},
+	};
+
+	for (auto const & v : data) {
+		auto m = ais::make_message(v);
+		ASSERT_TRUE(m != nullptr);
+		EXPECT_EQ(v, ais::encode_message(*m));
+	}
+}
+
+TEST_F(Test_ais, make_message_invalid_padding)
+{
+	EXPECT_THROW(
+		ais::make_message({{"133m@ogP00PD;88MD5MTDww@2D7k", 7}}), std::invalid_argument);
+}
+
+TEST_F(Test_ais, make_message_payload_too_large)
+{
+	const std::string payload(ais::max_raw_size * 8 / 6 + 1, '0');
+
+	EXPECT_THROW(ais::make_message({{"1" + payload, 0}}), std::invalid_argument);
+	EXPECT_EQ(ais::decode_error::invalid_payload,
+		ais::try_make_message({{"1" + payload, 0}}).error());
+}
+
+TEST_F(Test_ais, try_make_message)
+{
+	const auto result = ais::try_make_message({{"133m@ogP00PD;88MD5MTDww@2D7k", 0}});
+
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(ais::message_id::position_report_class_a, result.value()->type());
+}
+
+TEST_F(Test_ais, try_make_message_errors)
+{
+	using ais::decode_error;
+
+	EXPECT_EQ(decode_error::empty, ais::try_make_message({}).error());
+	EXPECT_EQ(decode_error::empty, ais::try_make_message({{"", 0}}).error());
+	EXPECT_EQ(decode_error::invalid_payload,
+		ais::try_make_message({{"133m@ogP00PD;88MD5MTDww@2D7k", 6}}).error());
+	EXPECT_EQ(decode_error::invalid_payload,
+		ais::try_make_message({{"133m@ogP00PD;88MD5MTD ww@2D7k", 0}}).error());
+	EXPECT_EQ(decode_error::unknown_message, ais::try_make_message({{"?", 0}}).error());
+	EXPECT_EQ(decode_error::invalid_data, ais::try_make_message({{"133m@og", 0}}).error());
+}
+
+TEST_F(Test_ais, peek_header)
+{
+	const auto header = ais::peek_header("133m@ogP00PD;88MD5MTDww@2D7k");
+
+	ASSERT_TRUE(header.has_value());
+	EXPECT_EQ(ais::message_id::position_report_class_a, header->type);
+	EXPECT_EQ(0u, header->repeat_indicator);
+	EXPECT_EQ(utils::mmsi{205344990}, header->mmsi);
+}
+
+TEST_F(Test_ais, peek_header_equals_message)
+{
+	const std::vector<std::string> payloads = {
+		"133m@ogP00PD;88MD5MTDww@2D7k",
+		"4020ssAuho;N?PeNwjOAp<70089A",
+		"55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53",
+		"B000000000H0htY08D41qwv00000",
+		"E@28isPVa9Qh:0a90SWW0h@@@@@@2kJP;hHP@00003v0100",
+	};
+
+	for (auto const & payload : payloads) {
+		const auto header = ais::peek_header(payload);
+		ASSERT_TRUE(header.has_value());
+
+		const ais::raw bits = [&payload] {
+			ais::raw result;
+			for (auto c : payload)
+				result.append(ais::decode_armoring(c), 6);
+			return result;
+		}();
+		EXPECT_EQ(bits.get<ais::message_id>(0, 6), header->type) << payload;
+		EXPECT_EQ(bits.get<uint32_t>(6, 2), header->repeat_indicator) << payload;
+		EXPECT_EQ(bits.get<uint32_t>(8, 30), header->mmsi) << payload;
+	}
+}
+
+TEST_F(Test_ais, peek_header_errors)
+{
+	EXPECT_EQ(ais::decode_error::empty, ais::peek_header("").error());
+	EXPECT_EQ(ais::decode_error::empty, ais::peek_header("133m@o").error());
+	EXPECT_EQ(ais::decode_error::empty, ais::peek_header(nullptr, 10).error());
+	EXPECT_EQ(ais::decode_error::invalid_payload, ais::peek_header("133 m@ogP").error());
+}
+
 TEST_F(Test_ais, encode_message_zero_sized_bits)
 {
 	message_zero_bits m;
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <marnav/ais/any_message.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_ais_any_message : public ::testing::Test
+{
+public:
+	using payload = std::vector<std::pair<std::string, uint32_t>>;
+
+	static const payload message_01_payload;
+	static const payload message_05_payload;
+
+	struct get_mmsi {
+		template <class T> utils::mmsi operator()(const T & m) const { return m.get_mmsi(); }
+	};
+
+	struct count_types {
+		int position = 0;
+		int voyage = 0;
+		int other = 0;
+
+		void operator()(const ais::message_01 &) { ++position; }
+		void operator()(const ais::message_05 &) { ++voyage; }
+		template <class T> void operator()(const T &) { ++other; }
+	};
+};
+
+const Test_ais_any_message::payload Test_ais_any_message::message_01_payload
+	= {{"133m@ogP00PD;88MD5MTDww@2D7k", 0}};
+
+const Test_ais_any_message::payload Test_ais_any_message::message_05_payload
+	= {{"55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53", 0},
+		{"1@0000000000000", 2}};
+
+TEST_F(Test_ais_any_message, make_any_message)
+{
+	const auto m = ais::make_any_message(message_01_payload);
+	ASSERT_TRUE(utils::holds_alternative<ais::message_01>(m));
+	EXPECT_EQ(ais::message_id::position_report_class_a, ais::as_message(m).type());
+
+	const auto p = ais::message_cast<ais::message_01>(ais::make_message(message_01_payload));
+	EXPECT_EQ(p->get_mmsi(), utils::get<ais::message_01>(m).get_mmsi());
+	EXPECT_EQ(*p->get_sog(), *utils::get<ais::message_01>(m).get_sog());
+}
+
+TEST_F(Test_ais_any_message, make_any_message_unknown)
+{
+	// message type 15, not supported
+	EXPECT_THROW(ais::make_any_message({{"?000000000000000", 0}}), ais::unknown_message);
+}
+
+TEST_F(Test_ais_any_message, decode_message_reuses_variant)
+{
+	ais::any_message m;
+
+	EXPECT_EQ(ais::decode_error::none, ais::decode_message(message_05_payload, m));
+	ASSERT_TRUE(utils::holds_alternative<ais::message_05>(m));
+	EXPECT_EQ(utils::mmsi{369190000}, utils::get<ais::message_05>(m).get_mmsi());
+
+	EXPECT_EQ(ais::decode_error::none, ais::decode_message(message_01_payload, m));
+	ASSERT_TRUE(utils::holds_alternative<ais::message_01>(m));
+	EXPECT_EQ(ais::message_id::position_report_class_a, ais::as_message(m).type());
+}
+
+TEST_F(Test_ais_any_message, decode_message_errors)
+{
+	ais::any_message m;
+
+	EXPECT_EQ(ais::decode_error::empty, ais::decode_message({}, m));
+	EXPECT_EQ(ais::decode_error::invalid_payload, ais::decode_message({{"1xx", 0}}, m));
+	EXPECT_EQ(ais::decode_error::invalid_payload, ais::decode_message({{"133m", 6}}, m));
+	EXPECT_EQ(ais::decode_error::unknown_message,
+		ais::decode_message({{"?000000000000000", 0}}, m));
+	EXPECT_EQ(ais::decode_error::invalid_data, ais::decode_message({{"1000", 0}}, m));
+}
+
+TEST_F(Test_ais_any_message, visit)
+{
+	std::vector<ais::any_message> v;
+	v.push_back(ais::make_any_message(message_01_payload));
+	v.push_back(ais::make_any_message(message_05_payload));
+	v.push_back(ais::make_any_message(message_01_payload));
+
+	count_types counter;
+	for (const auto & m : v)
+		utils::visit(counter, m);
+	EXPECT_EQ(2, counter.position);
+	EXPECT_EQ(1, counter.voyage);
+	EXPECT_EQ(0, counter.other);
+
+	EXPECT_EQ(utils::get<ais::message_05>(v[1]).get_mmsi(), utils::visit(get_mmsi{}, v[1]));
+}
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <marnav/ais/binary_data.hpp>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Provides access to the protected functions of binary_data.
+class binary_data_access : public ais::binary_data
+{
+public:
+	using binary_data::read_string;
+	using binary_data::write_string;
+};
+
+class Test_ais_binary_data : public ::testing::Test
+{
+public:
+	static const std::string SIXBIT_ASCII;
+};
+
+const std::string Test_ais_binary_data::SIXBIT_ASCII
+	= "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_ !\"#$%&'()*+,-./0123456789:;<=>?";
+
+TEST_F(Test_ais_binary_data, decode_sixbit_ascii)
+{
+	for (uint8_t value = 0; value < 64; ++value)
+		EXPECT_EQ(SIXBIT_ASCII[value], ais::decode_sixbit_ascii(value));
+}
+
+TEST_F(Test_ais_binary_data, decode_sixbit_ascii_invalid)
+{
+	EXPECT_EQ(static_cast<char>(0xff), ais::decode_sixbit_ascii(64));
+	EXPECT_EQ(static_cast<char>(0xff), ais::decode_sixbit_ascii(255));
+}
+
+TEST_F(Test_ais_binary_data, encode_sixbit_ascii)
+{
+	for (uint8_t value = 0; value < 64; ++value)
+		EXPECT_EQ(value, ais::encode_sixbit_ascii(SIXBIT_ASCII[value]));
+}
+
+TEST_F(Test_ais_binary_data, encode_sixbit_ascii_invalid)
+{
+	for (int c = 0; c < 256; ++c) {
+		if (SIXBIT_ASCII.find(static_cast<char>(c)) == std::string::npos) {
+			EXPECT_EQ(0xffu, ais::encode_sixbit_ascii(static_cast<char>(c))) << "c=" << c;
+		}
+	}
+}
+
+TEST_F(Test_ais_binary_data, write_and_read_string)
+{
+	for (ais::raw::size_type n = 0; n <= SIXBIT_ASCII.size(); ++n) {
+		const std::string s = SIXBIT_ASCII.substr(0, n);
+		ais::raw bits(3 + 64 * 6);
+
+		binary_data_access::write_string(bits, 3, n, s);
+
+		EXPECT_EQ(s, binary_data_access::read_string(bits, 3, n));
+		for (ais::raw::size_type i = 0; i < n; ++i)
+			EXPECT_EQ(static_cast<uint8_t>(i), bits.get<uint8_t>(3 + i * 6, 6));
+	}
+}
+
+TEST_F(Test_ais_binary_data, write_string_fill)
+{
+	ais::raw bits(20 * 6);
+
+	binary_data_access::write_string(bits, 0, 20, "NAME");
+
+	EXPECT_EQ("NAME@@@@@@@@@@@@@@@@", binary_data_access::read_string(bits, 0, 20));
+}
+
+TEST_F(Test_ais_binary_data, write_string_does_not_touch_neighbours)
+{
+	ais::raw bits(2 + 4 * 6 + 2);
+	bits.set(0x3u, 0, 2);
+	bits.set(0x3u, 26, 2);
+
+	binary_data_access::write_string(bits, 2, 4, "@@@@");
+
+	EXPECT_EQ(0x3u, bits.get<uint8_t>(0, 2));
+	EXPECT_EQ(0x0u, bits.get<uint32_t>(2, 24));
+	EXPECT_EQ(0x3u, bits.get<uint8_t>(26, 2));
+}
+
+TEST_F(Test_ais_binary_data, trim_ais_string)
+{
+	EXPECT_EQ("NAME", ais::trim_ais_string("NAME@@@@"));
+	EXPECT_EQ("NAME", ais::trim_ais_string("NAME"));
+	EXPECT_EQ("", ais::trim_ais_string("@@@@"));
+}
+}
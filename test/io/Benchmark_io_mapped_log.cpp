@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <marnav/io/file_device.hpp>
+#include <marnav/io/mapped_log.hpp>
+#include <marnav/nmea/stream_decoder.hpp>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+static const std::string sentences
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPHDT,123.4,T*31\r\n"
+	   "$IIMTW,10.5,C*17\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"};
+
+/// Temporary log of about 8 MB, removed at destruction.
+class temp_log
+{
+public:
+	temp_log()
+	{
+		char name[] = "/tmp/marnav-benchmark-XXXXXX";
+		const int fd = ::mkstemp(name);
+		if (fd < 0)
+			throw std::runtime_error{"unable to create temporary file"};
+		filename = name;
+
+		std::string block;
+		for (int i = 0; i < 1000; ++i)
+			block += sentences;
+		for (int i = 0; i < 50; ++i) {
+			if (::write(fd, block.data(), block.size()) != static_cast<ssize_t>(block.size()))
+				throw std::runtime_error{"unable to write temporary file"};
+			size += block.size();
+		}
+		::close(fd);
+	}
+
+	~temp_log() { std::remove(filename.c_str()); }
+
+	std::string filename;
+	std::size_t size = 0u;
+};
+
+static const temp_log & get_log()
+{
+	static const temp_log log;
+	return log;
+}
+}
+
+static void Benchmark_mapped_log_replay(benchmark::State & state)
+{
+	const auto & f = get_log();
+	std::size_t num_sentences = 0u;
+	marnav::nmea::stream_decoder decoder{
+		[&num_sentences](const marnav::nmea::any_sentence &) { ++num_sentences; }};
+	marnav::io::mapped_log log{f.filename};
+	log.open();
+
+	while (state.KeepRunning()) {
+		log.rewind();
+		log.replay([&decoder](const char * data, std::size_t size) {
+			decoder.feed(data, size);
+		});
+	}
+	benchmark::DoNotOptimize(num_sentences);
+	state.SetBytesProcessed(state.iterations() * f.size);
+}
+
+BENCHMARK(Benchmark_mapped_log_replay)->Unit(benchmark::kMillisecond);
+
+static void Benchmark_file_device_read(benchmark::State & state)
+{
+	const auto & f = get_log();
+	std::size_t num_sentences = 0u;
+	marnav::nmea::stream_decoder decoder{
+		[&num_sentences](const marnav::nmea::any_sentence &) { ++num_sentences; }};
+	std::vector<char> buffer(static_cast<std::size_t>(state.range(0)));
+
+	while (state.KeepRunning()) {
+		marnav::io::file_device dev{f.filename};
+		dev.open();
+		int rc;
+		while ((rc = dev.read(buffer.data(), static_cast<uint32_t>(buffer.size()))) > 0)
+			decoder.feed(buffer.data(), static_cast<std::size_t>(rc));
+	}
+	benchmark::DoNotOptimize(num_sentences);
+	state.SetBytesProcessed(state.iterations() * f.size);
+}
+
+BENCHMARK(Benchmark_file_device_read)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <marnav/io/file_device.hpp>
+#include <marnav/io/default_nmea_reader.hpp>
+#include <marnav/utils/unique.hpp>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+/// Temporary file with the specified content, removed at destruction.
+class temp_file
+{
+public:
+	explicit temp_file(const std::string & content)
+	{
+		char name[] = "/tmp/marnav-test-XXXXXX";
+		const int fd = ::mkstemp(name);
+		if (fd < 0)
+			throw std::runtime_error{"unable to create temporary file"};
+		const auto rc = ::write(fd, content.data(), content.size());
+		::close(fd);
+		filename = name;
+		if (rc != static_cast<ssize_t>(content.size()))
+			throw std::runtime_error{"unable to write temporary file"};
+	}
+
+	~temp_file() { std::remove(filename.c_str()); }
+
+	const std::string & name() const { return filename; }
+
+private:
+	std::string filename;
+};
+
+class Test_io_file_device : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_file_device, open_non_existing_file)
+{
+	::io::file_device dev{"/tmp/marnav-non-existing-file"};
+
+	EXPECT_THROW(dev.open(), std::runtime_error);
+}
+
+TEST_F(Test_io_file_device, read_not_open)
+{
+	temp_file f{DATA};
+	::io::file_device dev{f.name()};
+	char buffer[16];
+
+	EXPECT_THROW(dev.read(buffer, sizeof(buffer)), std::runtime_error);
+	EXPECT_GT(0, dev.get_fd());
+}
+
+TEST_F(Test_io_file_device, read_entire_file)
+{
+	temp_file f{DATA};
+	::io::file_device dev{f.name()};
+	dev.open();
+	EXPECT_LE(0, dev.get_fd());
+
+	std::string data;
+	char buffer[16];
+	int rc;
+	while ((rc = dev.read(buffer, sizeof(buffer))) > 0)
+		data.append(buffer, static_cast<std::size_t>(rc));
+
+	EXPECT_EQ(0, rc);
+	EXPECT_EQ(DATA, data);
+}
+
+TEST_F(Test_io_file_device, write_not_supported)
+{
+	temp_file f{DATA};
+	::io::file_device dev{f.name()};
+	dev.open();
+
+	EXPECT_THROW(dev.write("abc", 3u), std::runtime_error);
+}
+
+TEST_F(Test_io_file_device, nmea_reader)
+{
+	temp_file f{DATA};
+	::io::default_nmea_reader reader{utils::make_unique<::io::file_device>(f.name()),
+		::io::nmea_reader::default_buffer_size};
+
+	int num_sentences = 0;
+	std::string s;
+	while (reader.read_sentence(s))
+		++num_sentences;
+
+	EXPECT_EQ(3, num_sentences);
+}
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <marnav/io/mapped_log.hpp>
+#include <marnav/io/default_nmea_reader.hpp>
+#include <marnav/nmea/stream_decoder.hpp>
+#include <marnav/utils/unique.hpp>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+// one second between the lines, checksums of the tag blocks not relevant
+static const std::string DATA_TIMED
+	= {"\\s:r1,c:1600000000*00\\$GPHDT,123.4,T*31\r\n"
+	   "$GPHDT,123.4,T*31\r\n"
+	   "\\c:1600000001,s:r1*00\\$GPHDT,123.4,T*31\r\n"
+	   "\\c:1600000002000*00\\$GPHDT,123.4,T*31\r\n"};
+
+/// Temporary file with the specified content, removed at destruction.
+class temp_file
+{
+public:
+	explicit temp_file(const std::string & content)
+	{
+		char name[] = "/tmp/marnav-test-XXXXXX";
+		const int fd = ::mkstemp(name);
+		if (fd < 0)
+			throw std::runtime_error{"unable to create temporary file"};
+		const auto rc = ::write(fd, content.data(), content.size());
+		::close(fd);
+		filename = name;
+		if (rc != static_cast<ssize_t>(content.size()))
+			throw std::runtime_error{"unable to write temporary file"};
+	}
+
+	~temp_file() { std::remove(filename.c_str()); }
+
+	const std::string & name() const { return filename; }
+
+private:
+	std::string filename;
+};
+
+class Test_io_mapped_log : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_mapped_log, open_non_existing_file)
+{
+	::io::mapped_log log{"/tmp/marnav-non-existing-file"};
+
+	EXPECT_THROW(log.open(), std::runtime_error);
+}
+
+TEST_F(Test_io_mapped_log, not_open)
+{
+	temp_file f{DATA};
+	::io::mapped_log log{f.name()};
+	char buffer[16];
+
+	EXPECT_EQ(nullptr, log.data());
+	EXPECT_EQ(0u, log.size());
+	EXPECT_THROW(log.read(buffer, sizeof(buffer)), std::runtime_error);
+	EXPECT_THROW(log.replay([](const char *, std::size_t) {}), std::runtime_error);
+}
+
+TEST_F(Test_io_mapped_log, empty_file)
+{
+	temp_file f{""};
+	::io::mapped_log log{f.name()};
+	log.open();
+	char buffer[16];
+
+	EXPECT_EQ(0u, log.size());
+	EXPECT_EQ(0, log.read(buffer, sizeof(buffer)));
+	EXPECT_EQ(0u, log.replay([](const char *, std::size_t) {}));
+}
+
+TEST_F(Test_io_mapped_log, replay_without_copies)
+{
+	temp_file f{DATA};
+	::io::mapped_log log{f.name()};
+	log.open();
+	ASSERT_EQ(DATA.size(), log.size());
+
+	std::vector<const char *> chunks;
+	const auto n = log.replay([&chunks](const char * data, std::size_t) {
+		chunks.push_back(data);
+	});
+
+	EXPECT_EQ(DATA.size(), n);
+	EXPECT_EQ(DATA.size(), log.tell());
+	ASSERT_EQ(1u, chunks.size());
+	EXPECT_EQ(log.data(), chunks[0]);
+	EXPECT_EQ(DATA, std::string(log.data(), log.size()));
+}
+
+TEST_F(Test_io_mapped_log, replay_stream_decoder_chunks)
+{
+	temp_file f{DATA};
+	::io::mapped_log log{f.name()};
+	log.open();
+
+	for (std::size_t chunk = 1u; chunk <= DATA.size(); ++chunk) {
+		int num_sentences = 0;
+		nmea::stream_decoder decoder{
+			[&num_sentences](const nmea::any_sentence &) { ++num_sentences; }};
+
+		log.rewind();
+		log.replay(
+			[&decoder](const char * data, std::size_t size) { decoder.feed(data, size); },
+			chunk);
+
+		EXPECT_EQ(3, num_sentences) << "chunk size: " << chunk;
+	}
+}
+
+TEST_F(Test_io_mapped_log, replay_invalid_arguments)
+{
+	temp_file f{DATA};
+	::io::mapped_log log{f.name()};
+	log.open();
+
+	EXPECT_THROW(log.replay(nullptr), std::invalid_argument);
+	EXPECT_THROW(log.replay([](const char *, std::size_t) {}, 0u), std::invalid_argument);
+}
+
+TEST_F(Test_io_mapped_log, nmea_reader)
+{
+	temp_file f{DATA};
+	::io::default_nmea_reader reader{
+		utils::make_unique<::io::mapped_log>(f.name()), ::io::nmea_reader::default_buffer_size};
+
+	int num_sentences = 0;
+	std::string s;
+	while (reader.read_sentence(s))
+		++num_sentences;
+
+	EXPECT_EQ(3, num_sentences);
+}
+
+TEST_F(Test_io_mapped_log, set_pacing_invalid_speed)
+{
+	::io::mapped_log log{"/tmp/marnav-non-existing-file"};
+
+	EXPECT_THROW(log.set_pacing(-1.0), std::invalid_argument);
+	EXPECT_DOUBLE_EQ(0.0, log.get_pacing());
+}
+
+TEST_F(Test_io_mapped_log, replay_paced_line_by_line)
+{
+	temp_file f{DATA_TIMED};
+	::io::mapped_log log{f.name()};
+	log.set_pacing(50.0); // 20 ms per second of log time
+	log.open();
+
+	std::vector<std::string> lines;
+	const auto start = std::chrono::steady_clock::now();
+	log.replay([&lines](const char * data, std::size_t size) {
+		lines.emplace_back(data, size);
+	});
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	ASSERT_EQ(4u, lines.size());
+	EXPECT_EQ("$GPHDT,123.4,T*31\r\n", lines[1]);
+	EXPECT_LE(std::chrono::milliseconds(39), elapsed);
+	EXPECT_GT(std::chrono::milliseconds(1000), elapsed);
+}
+
+TEST_F(Test_io_mapped_log, read_paced_line_by_line)
+{
+	temp_file f{DATA_TIMED};
+	::io::mapped_log log{f.name()};
+	log.set_pacing(1000.0);
+	log.open();
+
+	char buffer[256];
+	EXPECT_EQ(41, log.read(buffer, sizeof(buffer)));
+	EXPECT_EQ(19, log.read(buffer, sizeof(buffer)));
+	EXPECT_EQ(10, log.read(buffer, 10u));
+	EXPECT_EQ(31, log.read(buffer, sizeof(buffer)));
+}
+}
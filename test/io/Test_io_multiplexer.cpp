@@ -0,0 +1,456 @@
+#include <gtest/gtest.h>
+#include <marnav/io/multiplexer.hpp>
+#include <marnav/io/device.hpp>
+#include <marnav/io/gather_writable.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/io/udp_device.hpp>
+#include <marnav/utils/unique.hpp>
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "pipe_device.hpp"
+
+namespace
+{
+
+using namespace marnav;
+
+const std::string hdt = "$GPHDT,123.4,T*31";
+const std::string mtw = "$IIMTW,10.5,C*17";
+const std::string vdm = "!AIVDM,1,1,,A,13aEOK?P00PD2wVMdLDRhgvL289?,0*26";
+
+/// Records all written data, optionally refuses to write (would block).
+class memory_device : public ::io::device
+{
+public:
+	explicit memory_device(std::string & data)
+		: data(data)
+	{
+	}
+
+	void open() override {}
+	void close() override {}
+
+	int read(char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+	int write(const char * buffer, uint32_t size) override
+	{
+		if (blocked) {
+			errno = EAGAIN;
+			return -1;
+		}
+		data.append(buffer, size);
+		return static_cast<int>(size);
+	}
+
+	bool blocked = false;
+
+protected:
+	std::string & data;
+};
+
+/// Records all written data and the number of gather writes.
+class gather_device : public memory_device, public ::io::gather_writable
+{
+public:
+	gather_device(std::string & data, int & num_writes, int max_size = -1)
+		: memory_device(data)
+		, num_writes(num_writes)
+		, max_size(max_size)
+	{
+	}
+
+	int write_gather(const struct iovec * iov, int count) override
+	{
+		++num_writes;
+		int total = 0;
+		for (int i = 0; i < count; ++i) {
+			int n = static_cast<int>(iov[i].iov_len);
+			if ((max_size >= 0) && (total + n > max_size))
+				n = max_size - total;
+			data.append(static_cast<const char *>(iov[i].iov_base), n);
+			total += n;
+		}
+		return total;
+	}
+
+private:
+	int & num_writes;
+	int max_size; ///< Maximum number of bytes written per call, simulates partial writes.
+};
+
+/// Fails on every write.
+class failing_device : public ::io::device
+{
+public:
+	void open() override {}
+	void close() override {}
+	int read(char *, uint32_t) override { return -1; }
+	int write(const char *, uint32_t) override { throw std::runtime_error{"device not open"}; }
+};
+
+class Test_io_multiplexer : public ::testing::Test
+{
+public:
+	void process(std::size_t input, const std::string & s)
+	{
+		mux.process(input, s.data(), s.size());
+	}
+
+	::io::multiplexer mux;
+	std::string data;
+};
+
+TEST_F(Test_io_multiplexer, forward_sentences)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	process(in, hdt + "\r\n" + mtw + "\n");
+
+	EXPECT_EQ(hdt + "\r\n" + mtw + "\r\n", data);
+	EXPECT_EQ(2u, mux.get_input_statistics(in).received);
+	EXPECT_EQ(0u, mux.get_input_statistics(in).invalid);
+	EXPECT_EQ(2u, mux.get_output_statistics(out).sent);
+	EXPECT_EQ(0u, mux.get_queue_size(out));
+}
+
+TEST_F(Test_io_multiplexer, sentences_split_across_chunks)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	const std::string s = hdt + "\r\n" + vdm + "\r\n";
+	for (const char c : s)
+		mux.process(in, &c, 1u);
+
+	EXPECT_EQ(s, data);
+	EXPECT_EQ(2u, mux.get_input_statistics(in).received);
+}
+
+TEST_F(Test_io_multiplexer, invalid_sentences_are_dropped)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	process(in, "$GPHDT,123.4,T*32\r\n");
+	process(in, "$GPHDT,123.4,T\r\n");
+	process(in, "GPHDT,123.4,T*31\r\n");
+	process(in, "\\s:foo*00$GPHDT,123.4,T*31\r\n");
+	process(in, hdt + "\r\n");
+
+	EXPECT_EQ(hdt + "\r\n", data);
+	EXPECT_EQ(5u, mux.get_input_statistics(in).received);
+	EXPECT_EQ(4u, mux.get_input_statistics(in).invalid);
+}
+
+TEST_F(Test_io_multiplexer, overlong_lines_are_dropped)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	const std::string garbage(::io::multiplexer::max_line_length + 1u, 'x');
+	process(in, garbage.substr(0u, 10u));
+	process(in, garbage.substr(10u));
+	process(in, "\r\n" + hdt + "\r\n");
+
+	EXPECT_EQ(hdt + "\r\n", data);
+	EXPECT_EQ(2u, mux.get_input_statistics(in).received);
+	EXPECT_EQ(1u, mux.get_input_statistics(in).invalid);
+}
+
+TEST_F(Test_io_multiplexer, unknown_sentences_are_forwarded_unfiltered)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	const std::string s = "$PGRME,15.0,M,45.0,M,25.0,M*1C";
+	process(in, s + "\r\n");
+
+	EXPECT_EQ(s + "\r\n", data);
+}
+
+TEST_F(Test_io_multiplexer, tag_block_is_forwarded)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out, {nmea::sentence_id::HDT});
+
+	const std::string s = "\\s:r003669945*6A\\" + hdt;
+	process(in, s + "\r\n");
+
+	EXPECT_EQ(s + "\r\n", data);
+}
+
+TEST_F(Test_io_multiplexer, route_filter)
+{
+	std::string data_ais;
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	const auto out_ais = mux.add_output(utils::make_unique<memory_device>(data_ais));
+	mux.add_route(in, out, {nmea::sentence_id::HDT, nmea::sentence_id::MTW});
+	mux.add_route(in, out_ais, {nmea::sentence_id::VDM});
+
+	process(in, hdt + "\r\n" + vdm + "\r\n" + mtw + "\r\n");
+
+	EXPECT_EQ(hdt + "\r\n" + mtw + "\r\n", data);
+	EXPECT_EQ(vdm + "\r\n", data_ais);
+}
+
+TEST_F(Test_io_multiplexer, multiple_inputs_and_outputs)
+{
+	std::string data2;
+	const auto in1 = mux.add_input();
+	const auto in2 = mux.add_input();
+	const auto out1 = mux.add_output(utils::make_unique<memory_device>(data));
+	const auto out2 = mux.add_output(utils::make_unique<memory_device>(data2));
+	mux.add_route(in1, out1);
+	mux.add_route(in1, out2);
+	mux.add_route(in2, out2);
+
+	process(in1, hdt + "\r\n");
+	process(in2, mtw + "\r\n");
+
+	EXPECT_EQ(hdt + "\r\n", data);
+	EXPECT_EQ(hdt + "\r\n" + mtw + "\r\n", data2);
+}
+
+TEST_F(Test_io_multiplexer, rate_limit)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+	mux.set_rate_limit(out, nmea::sentence_id::HDT, std::chrono::hours{1});
+
+	process(in, hdt + "\r\n" + mtw + "\r\n" + hdt + "\r\n" + mtw + "\r\n");
+
+	EXPECT_EQ(hdt + "\r\n" + mtw + "\r\n" + mtw + "\r\n", data);
+	EXPECT_EQ(3u, mux.get_output_statistics(out).sent);
+	EXPECT_EQ(1u, mux.get_output_statistics(out).rate_limited);
+}
+
+TEST_F(Test_io_multiplexer, rate_limit_interval_elapsed)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+	mux.set_rate_limit(out, nmea::sentence_id::HDT, std::chrono::milliseconds{10});
+
+	process(in, hdt + "\r\n");
+	std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	process(in, hdt + "\r\n");
+
+	EXPECT_EQ(2u, mux.get_output_statistics(out).sent);
+	EXPECT_EQ(0u, mux.get_output_statistics(out).rate_limited);
+}
+
+TEST_F(Test_io_multiplexer, bounded_queue)
+{
+	auto dev = utils::make_unique<memory_device>(data);
+	auto & mem = *dev;
+	mem.blocked = true;
+
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(std::move(dev), 2u);
+	mux.add_route(in, out);
+
+	process(in, hdt + "\r\n" + mtw + "\r\n" + hdt + "\r\n");
+
+	EXPECT_TRUE(data.empty());
+	EXPECT_EQ(2u, mux.get_queue_size(out));
+	EXPECT_EQ(1u, mux.get_output_statistics(out).dropped);
+
+	mem.blocked = false;
+	EXPECT_TRUE(mux.flush());
+
+	EXPECT_EQ(hdt + "\r\n" + mtw + "\r\n", data);
+	EXPECT_EQ(0u, mux.get_queue_size(out));
+	EXPECT_EQ(2u, mux.get_output_statistics(out).sent);
+}
+
+TEST_F(Test_io_multiplexer, write_error_drops_queue)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<failing_device>());
+	mux.add_route(in, out);
+
+	process(in, hdt + "\r\n");
+
+	EXPECT_EQ(0u, mux.get_queue_size(out));
+	EXPECT_EQ(1u, mux.get_output_statistics(out).errors);
+	EXPECT_EQ(1u, mux.get_output_statistics(out).dropped);
+}
+
+TEST_F(Test_io_multiplexer, gather_write_batches_sentences)
+{
+	int num_writes = 0;
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<gather_device>(data, num_writes));
+	mux.add_route(in, out);
+
+	std::string s;
+	for (int i = 0; i < 10; ++i)
+		s += hdt + "\r\n";
+	process(in, s);
+
+	EXPECT_EQ(s, data);
+	EXPECT_EQ(1, num_writes);
+	EXPECT_EQ(10u, mux.get_output_statistics(out).sent);
+}
+
+TEST_F(Test_io_multiplexer, gather_write_partial)
+{
+	int num_writes = 0;
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<gather_device>(data, num_writes, 7));
+	mux.add_route(in, out);
+
+	const std::string s = hdt + "\r\n" + mtw + "\r\n";
+	process(in, s);
+
+	EXPECT_EQ(s, data);
+	EXPECT_EQ(2u, mux.get_output_statistics(out).sent);
+	EXPECT_EQ(0u, mux.get_queue_size(out));
+}
+
+TEST_F(Test_io_multiplexer, udp_output_one_sentence_per_datagram)
+{
+	::io::udp_device rx{0u}; // default maximum datagram size
+	rx.open();
+	::fcntl(rx.get_fd(), F_SETFL, ::fcntl(rx.get_fd(), F_GETFL) | O_NONBLOCK);
+
+	auto tx = utils::make_unique<::io::udp_device>(0u);
+	tx->set_destination("127.0.0.1", rx.get_port());
+
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(std::move(tx));
+	mux.add_route(in, out);
+
+	const std::string rmc
+		= "$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n";
+	std::string s;
+	for (int i = 0; i < 40; ++i)
+		s += rmc;
+	ASSERT_LT(::io::udp_device::default_max_datagram_size, s.size());
+	process(in, s);
+
+	EXPECT_EQ(40u, mux.get_output_statistics(out).sent);
+	EXPECT_EQ(0u, mux.get_output_statistics(out).errors);
+
+	std::string received;
+	char buffer[8192];
+	for (int retry = 0; (retry < 100) && (received.size() < s.size());) {
+		const int rc = rx.read(buffer, sizeof(buffer));
+		if (rc > 0) {
+			received.append(buffer, static_cast<std::size_t>(rc));
+		} else {
+			std::this_thread::sleep_for(std::chrono::milliseconds{10});
+			++retry;
+		}
+	}
+	EXPECT_EQ(s, received);
+}
+
+TEST_F(Test_io_multiplexer, blocks_are_reused)
+{
+	auto dev = utils::make_unique<memory_device>(data);
+	auto & mem = *dev;
+
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(std::move(dev));
+	mux.add_route(in, out);
+
+	// queued data of a blocked output must remain intact, while other chunks
+	// are processed
+	mem.blocked = true;
+	process(in, hdt + "\r\n");
+	mem.blocked = false;
+	for (int i = 0; i < 100; ++i)
+		process(in, mtw + "\r\n");
+
+	std::string expected = hdt + "\r\n";
+	for (int i = 0; i < 100; ++i)
+		expected += mtw + "\r\n";
+	EXPECT_EQ(expected, data);
+}
+
+TEST_F(Test_io_multiplexer, run_with_device_input)
+{
+	int fds[2];
+	ASSERT_EQ(0, ::pipe(fds));
+
+	const auto in = mux.add_input(utils::make_unique<pipe_device>(fds[0]));
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+	mux.add_route(in, out);
+
+	const std::string s = hdt + "\r\n" + mtw + "\r\n";
+	ASSERT_EQ(static_cast<ssize_t>(s.size()), ::write(fds[1], s.data(), s.size()));
+	::close(fds[1]);
+
+	mux.run(); // returns after the input is closed
+
+	EXPECT_EQ(s, data);
+}
+
+TEST_F(Test_io_multiplexer, stop_from_other_thread)
+{
+	int fds[2];
+	ASSERT_EQ(0, ::pipe(fds));
+
+	mux.add_input(utils::make_unique<pipe_device>(fds[0]));
+
+	std::thread t([this] {
+		std::this_thread::sleep_for(std::chrono::milliseconds{20});
+		mux.stop();
+	});
+	mux.run();
+	t.join();
+	::close(fds[1]);
+}
+
+TEST_F(Test_io_multiplexer, stop_before_run)
+{
+	int fds[2];
+	ASSERT_EQ(0, ::pipe(fds));
+
+	mux.add_input(utils::make_unique<pipe_device>(fds[0]));
+
+	mux.stop();
+	mux.run(); // returns immediately, the input is still open
+	::close(fds[1]);
+}
+
+TEST_F(Test_io_multiplexer, invalid_ids)
+{
+	const auto in = mux.add_input();
+	const auto out = mux.add_output(utils::make_unique<memory_device>(data));
+
+	EXPECT_ANY_THROW(mux.add_route(in + 1, out));
+	EXPECT_ANY_THROW(mux.add_route(in, out + 1));
+	EXPECT_ANY_THROW(mux.process(in + 1, "x", 1u));
+	EXPECT_ANY_THROW(mux.get_queue_size(out + 1));
+	EXPECT_ANY_THROW(
+		mux.set_rate_limit(out + 1, nmea::sentence_id::HDT, std::chrono::seconds{1}));
+}
+
+TEST_F(Test_io_multiplexer, invalid_devices)
+{
+	EXPECT_ANY_THROW(mux.add_input(std::unique_ptr<::io::device>{}));
+	EXPECT_ANY_THROW(mux.add_input(utils::make_unique<memory_device>(data)));
+	EXPECT_ANY_THROW(mux.add_output(std::unique_ptr<::io::device>{}));
+	EXPECT_ANY_THROW(mux.add_output(utils::make_unique<memory_device>(data), 0u));
+}
+}
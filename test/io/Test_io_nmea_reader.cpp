@@ -2,6 +2,7 @@
 #include <marnav/io/nmea_reader.hpp>
 #include <marnav/io/device.hpp>
 #include <marnav/utils/unique.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace
@@ -56,6 +57,45 @@ private:
 	std::string data;
 };
 
+/// Delivers the data in chunks of at most the specified size, partial reads.
+class chunk_device : public ::io::device
+{
+public:
+	chunk_device(const std::string & data, std::string::size_type chunk, int & num_reads)
+		: index(0)
+		, chunk(chunk)
+		, data(data)
+		, num_reads(num_reads)
+	{
+	}
+
+	void open() override {}
+	void close() override {}
+
+	virtual int read(char * buffer, uint32_t size) override
+	{
+		++num_reads;
+		if (index >= data.size())
+			return 0; // end of data
+		const auto n = std::min({static_cast<std::string::size_type>(size), chunk,
+			data.size() - index});
+		std::copy_n(data.data() + index, n, buffer);
+		index += n;
+		return static_cast<int>(n);
+	}
+
+	virtual int write(const char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+private:
+	std::string::size_type index;
+	std::string::size_type chunk;
+	std::string data;
+	int & num_reads;
+};
+
 class test_device : public ::io::device
 {
 public:
@@ -115,8 +155,8 @@ public:
 	{
 	}
 
-	message_reader(std::unique_ptr<::io::device> && dev)
-		: nmea_reader(std::move(dev))
+	message_reader(std::unique_ptr<::io::device> && dev, std::size_t buffer_size = unbuffered)
+		: nmea_reader(std::move(dev), buffer_size)
 		, sentence_received(false)
 	{
 	}
@@ -236,4 +276,110 @@ TEST_F(Test_io_nmea_reader, read_after_close)
 
 	ASSERT_THROW(dev.read(), std::runtime_error);
 }
+
+TEST_F(Test_io_nmea_reader, buffered_invalid_buffer_size)
+{
+	EXPECT_ANY_THROW(message_reader(utils::make_unique<dummy_device>(DATA_COMPLETE), 0u));
+}
+
+TEST_F(Test_io_nmea_reader, buffered_read_sentence)
+{
+	int num_reads = 0;
+	message_reader dev{utils::make_unique<chunk_device>(DATA_COMPLETE, 4096u, num_reads),
+		::io::nmea_reader::default_buffer_size};
+
+	std::vector<std::string> sentences;
+	std::string data;
+	while (dev.read_sentence(data))
+		sentences.push_back(data);
+
+	ASSERT_EQ(3u, sentences.size());
+	EXPECT_EQ(
+		"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19", sentences[0]);
+	EXPECT_EQ(
+		"$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a", sentences[1]);
+	EXPECT_EQ(
+		"$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b", sentences[2]);
+
+	// one read for all data, one read for the end of data
+	EXPECT_EQ(2, num_reads);
+}
+
+TEST_F(Test_io_nmea_reader, buffered_partial_reads)
+{
+	for (std::string::size_type chunk = 1u; chunk < 80u; ++chunk) {
+		int num_reads = 0;
+		message_reader dev{utils::make_unique<chunk_device>(DATA_COMPLETE, chunk, num_reads),
+			::io::nmea_reader::default_buffer_size};
+
+		int num_sentences = 0;
+		std::string data;
+		while (dev.read_sentence(data)) {
+			EXPECT_EQ(68u, data.size()) << "chunk size: " << chunk;
+			++num_sentences;
+		}
+
+		EXPECT_EQ(3, num_sentences) << "chunk size: " << chunk;
+	}
+}
+
+TEST_F(Test_io_nmea_reader, buffered_buffer_smaller_than_sentence)
+{
+	int num_reads = 0;
+	message_reader dev{utils::make_unique<chunk_device>(DATA_COMPLETE, 4096u, num_reads), 7u};
+
+	int num_sentences = 0;
+	std::string data;
+	while (dev.read_sentence(data))
+		++num_sentences;
+
+	EXPECT_EQ(3, num_sentences);
+}
+
+TEST_F(Test_io_nmea_reader, buffered_read_synchronization)
+{
+	int num_reads = 0;
+	message_reader dev{utils::make_unique<chunk_device>(DATA_INCOMPLETE, 4096u, num_reads),
+		::io::nmea_reader::default_buffer_size};
+	std::string sentence;
+	bool rc = false;
+
+	ASSERT_NO_THROW(rc = dev.read_sentence(sentence));
+	ASSERT_TRUE(rc);
+	EXPECT_EQ(35u, sentence.size());
+
+	ASSERT_NO_THROW(rc = dev.read_sentence(sentence));
+	ASSERT_TRUE(rc);
+	EXPECT_EQ(68u, sentence.size());
+}
+
+TEST_F(Test_io_nmea_reader, buffered_sentence_to_large)
+{
+	int num_reads = 0;
+	message_reader dev{utils::make_unique<chunk_device>(DATA_MISSING_EOL, 4096u, num_reads),
+		::io::nmea_reader::default_buffer_size};
+	std::string sentence;
+
+	ASSERT_THROW(dev.read_sentence(sentence), std::length_error);
+}
+
+TEST_F(Test_io_nmea_reader, buffered_read_invalid_size)
+{
+	message_reader dev{std::unique_ptr<::io::device>(new test_device(12345)), 16u};
+
+	ASSERT_THROW(dev.read(), std::runtime_error);
+}
+
+TEST_F(Test_io_nmea_reader, buffered_read_after_close)
+{
+	int num_reads = 0;
+	message_reader dev{utils::make_unique<chunk_device>(DATA_COMPLETE, 4096u, num_reads),
+		::io::nmea_reader::default_buffer_size};
+
+	ASSERT_NO_THROW(dev.read());
+
+	dev.close();
+
+	ASSERT_THROW(dev.read(), std::runtime_error);
+}
 }
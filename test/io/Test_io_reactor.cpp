@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include <marnav/io/reactor.hpp>
+#include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/nmea/stream_decoder.hpp>
+#include <marnav/utils/unique.hpp>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "pipe_device.hpp"
+
+namespace
+{
+
+using namespace marnav;
+
+/// Not selectable, may not be registered.
+class dummy_device : public ::io::device
+{
+public:
+	void open() override {}
+	void close() override {}
+	int read(char *, uint32_t) override { return 0; }
+	int write(const char *, uint32_t) override { return 0; }
+};
+
+/// Pipe, the reading end is passed to the reactor as device.
+class pipe_writer
+{
+public:
+	pipe_writer()
+	{
+		if (::pipe(fds) < 0)
+			throw std::runtime_error{"unable to create pipe"};
+	}
+
+	~pipe_writer()
+	{
+		close();
+		if (fds[0] >= 0)
+			::close(fds[0]);
+	}
+
+	std::unique_ptr<::io::device> device()
+	{
+		auto dev = utils::make_unique<pipe_device>(fds[0]);
+		fds[0] = -1;
+		return dev;
+	}
+
+	void write(const std::string & s)
+	{
+		if (::write(fds[1], s.data(), s.size()) != static_cast<ssize_t>(s.size()))
+			throw std::runtime_error{"unable to write to pipe"};
+	}
+
+	void close()
+	{
+		if (fds[1] < 0)
+			return;
+		::close(fds[1]);
+		fds[1] = -1;
+	}
+
+private:
+	int fds[2] = {-1, -1};
+};
+
+class Test_io_reactor : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_reactor, construction_invalid_buffer_size)
+{
+	EXPECT_THROW(::io::reactor{0u}, std::invalid_argument);
+}
+
+TEST_F(Test_io_reactor, add_invalid_arguments)
+{
+	::io::reactor r;
+	pipe_writer p;
+
+	EXPECT_THROW(r.add(nullptr, [](const char *, std::size_t) {}), std::invalid_argument);
+	EXPECT_THROW(r.add(p.device(), nullptr), std::invalid_argument);
+	EXPECT_THROW(r.add(utils::make_unique<dummy_device>(), [](const char *, std::size_t) {}),
+		std::invalid_argument);
+	EXPECT_EQ(0u, r.size());
+}
+
+TEST_F(Test_io_reactor, run_once_timeout)
+{
+	::io::reactor r;
+	pipe_writer p;
+	r.add(p.device(), [](const char *, std::size_t) {});
+
+	EXPECT_EQ(0u, r.run_once(0));
+	EXPECT_EQ(1u, r.size());
+}
+
+TEST_F(Test_io_reactor, nmea_sentences)
+{
+	::io::reactor r;
+	pipe_writer p;
+	std::vector<nmea::sentence_id> ids;
+	r.add_decoder(p.device(), nmea::stream_decoder{[&ids](const nmea::any_sentence & s) {
+		ids.push_back(nmea::as_sentence(s).id());
+	}});
+
+	p.write("$GPHDT,123.4,T*31\r\n$IIMTW,10");
+	EXPECT_EQ(1u, r.run_once(0));
+	ASSERT_EQ(1u, ids.size());
+	EXPECT_EQ(nmea::sentence_id::HDT, ids[0]);
+
+	p.write(".5,C*17\r\n");
+	EXPECT_EQ(1u, r.run_once(0));
+	ASSERT_EQ(2u, ids.size());
+	EXPECT_EQ(nmea::sentence_id::MTW, ids[1]);
+}
+
+TEST_F(Test_io_reactor, multiple_devices)
+{
+	::io::reactor r;
+	pipe_writer p0;
+	pipe_writer p1;
+	std::string d0;
+	std::string d1;
+	const auto id0
+		= r.add(p0.device(), [&d0](const char * s, std::size_t n) { d0.append(s, n); });
+	const auto id1
+		= r.add(p1.device(), [&d1](const char * s, std::size_t n) { d1.append(s, n); });
+	EXPECT_NE(id0, id1);
+	EXPECT_EQ(2u, r.size());
+
+	p0.write("foo");
+	p1.write("bar");
+	EXPECT_EQ(2u, r.run_once(0));
+	EXPECT_EQ("foo", d0);
+	EXPECT_EQ("bar", d1);
+
+	p1.write("baz");
+	EXPECT_EQ(1u, r.run_once(0));
+	EXPECT_EQ("foo", d0);
+	EXPECT_EQ("barbaz", d1);
+}
+
+TEST_F(Test_io_reactor, end_of_data_closes_device)
+{
+	::io::reactor r;
+	pipe_writer p;
+	std::vector<std::size_t> closed;
+	r.set_close_handler([&closed](std::size_t id) { closed.push_back(id); });
+	const auto id = r.add(p.device(), [](const char *, std::size_t) {});
+
+	p.close();
+	EXPECT_EQ(1u, r.run_once(0));
+	EXPECT_EQ(0u, r.size());
+	ASSERT_EQ(1u, closed.size());
+	EXPECT_EQ(id, closed[0]);
+}
+
+TEST_F(Test_io_reactor, remove)
+{
+	::io::reactor r;
+	pipe_writer p;
+	int calls = 0;
+	const auto id = r.add(p.device(), [&calls](const char *, std::size_t) { ++calls; });
+
+	EXPECT_TRUE(r.remove(id));
+	EXPECT_FALSE(r.remove(id));
+	EXPECT_EQ(0u, r.size());
+	EXPECT_EQ(0u, r.run_once(0));
+	EXPECT_EQ(0, calls);
+}
+
+TEST_F(Test_io_reactor, remove_from_handler)
+{
+	::io::reactor r;
+	pipe_writer p;
+	std::size_t id = 0u;
+	id = r.add(p.device(), [&r, &id](const char *, std::size_t) { r.remove(id); });
+
+	p.write("foo");
+	EXPECT_EQ(1u, r.run_once(0));
+	EXPECT_EQ(0u, r.size());
+}
+
+TEST_F(Test_io_reactor, handler_state_valid_after_remove_from_handler)
+{
+	::io::reactor r;
+	pipe_writer p;
+	std::size_t id = 0u;
+	std::size_t size_in_handler = 1u;
+	bool removed_again = true;
+	auto received = std::make_shared<std::string>();
+	std::string result;
+	id = r.add(p.device(), [&, received](const char * data, std::size_t size) {
+		r.remove(id);
+		size_in_handler = r.size();
+		removed_again = r.remove(id);
+		received->assign(data, size); // captured state still alive
+		result = *received;
+	});
+
+	p.write("foo");
+	EXPECT_EQ(1u, r.run_once(0));
+	EXPECT_EQ(0u, size_in_handler);
+	EXPECT_FALSE(removed_again);
+	EXPECT_EQ("foo", result);
+	EXPECT_EQ(0u, r.size());
+	EXPECT_EQ(1, received.use_count());
+}
+
+TEST_F(Test_io_reactor, remove_from_handler_with_exception)
+{
+	::io::reactor r;
+	pipe_writer p;
+	std::size_t id = 0u;
+	id = r.add(p.device(), [&r, &id](const char *, std::size_t) {
+		r.remove(id);
+		throw std::logic_error{"handler"};
+	});
+
+	p.write("foo");
+	EXPECT_THROW(r.run_once(0), std::logic_error);
+	EXPECT_EQ(0u, r.size());
+	EXPECT_FALSE(r.remove(id));
+}
+
+TEST_F(Test_io_reactor, handler_exception_is_passed_on)
+{
+	::io::reactor r;
+	pipe_writer p;
+	r.add(p.device(), [](const char *, std::size_t) { throw std::logic_error{"handler"}; });
+
+	p.write("foo");
+	EXPECT_THROW(r.run_once(0), std::logic_error);
+	EXPECT_EQ(1u, r.size());
+}
+
+TEST_F(Test_io_reactor, stop_from_other_thread)
+{
+	::io::reactor r;
+	pipe_writer p;
+	r.add(p.device(), [](const char *, std::size_t) {});
+
+	std::thread t{[&r]() { r.stop(); }};
+	r.run();
+	t.join();
+	EXPECT_EQ(1u, r.size());
+}
+
+TEST_F(Test_io_reactor, stop_before_run)
+{
+	::io::reactor r;
+	pipe_writer p;
+	r.add(p.device(), [](const char *, std::size_t) {});
+
+	r.stop();
+	r.run();
+
+	r.stop();
+	EXPECT_EQ(0u, r.run_once(0));
+	r.run();
+	EXPECT_EQ(1u, r.size());
+}
+}
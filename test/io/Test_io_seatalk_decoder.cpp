@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <marnav/io/seatalk_decoder.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+// Data as delivered by a serial device configured to PARMRK, see Test_io_seatalk_reader.
+static const uint8_t DATA[] = {
+	// preliminary garbage
+	0x01, // bit=0 parity=0 : no error : ?
+	0xff, 0xff, // bit=0 parity=1 : error    : ?
+
+	// depth
+	0x00, // bit=1 parity=1 : no error : cmd
+	0x02, // bit=0 parity=0 : no error : data
+	0xff, 0x00, 0x60, // bit=0 parity=1 : error    : data
+	0xff, 0x00, 0x65, // bit=0 parity=1 : error    : data
+	0xff, 0x00, 0x00, // bit=0 parity=1 : error    : data
+
+	// depth, collision
+	0x00, // bit=1 parity=1 : no error : cmd
+	0x02, // bit=0 parity=0 : no error : data
+	// collision here, three bytes lost
+
+	// water temperature
+	0x27, // bit=1 parity=1 : no error : cmd
+	0x01, // bit=0 parity=0 : no error : data
+	0x64, // bit=0 parity=0 : no error : data
+	0xff, 0x00, 0x00, // bit=0 parity=1 : error    : data
+};
+
+class Test_io_seatalk_decoder : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_seatalk_decoder, process_bytes)
+{
+	io::seatalk_decoder decoder;
+
+	std::vector<seatalk::raw> messages;
+	for (auto b : DATA)
+		if (decoder.process(b))
+			messages.push_back(decoder.get_message());
+
+	ASSERT_EQ(2u, messages.size());
+	EXPECT_EQ((seatalk::raw{0x00, 0x02, 0x60, 0x65, 0x00}), messages[0]);
+	EXPECT_EQ((seatalk::raw{0x27, 0x01, 0x64, 0x00}), messages[1]);
+	EXPECT_EQ(1u, decoder.get_collisions());
+}
+
+TEST_F(Test_io_seatalk_decoder, feed_chunks)
+{
+	for (std::size_t chunk = 1u; chunk <= sizeof(DATA); ++chunk) {
+		std::vector<seatalk::raw> messages;
+		io::seatalk_decoder decoder{
+			[&messages](const seatalk::raw & data) { messages.push_back(data); }};
+
+		const char * data = reinterpret_cast<const char *>(DATA);
+		for (std::size_t i = 0u; i < sizeof(DATA); i += chunk)
+			decoder.feed(data + i, std::min(chunk, sizeof(DATA) - i));
+
+		ASSERT_EQ(2u, messages.size()) << "chunk size: " << chunk;
+		EXPECT_EQ((seatalk::raw{0x27, 0x01, 0x64, 0x00}), messages[1]);
+		EXPECT_EQ(1u, decoder.get_collisions()) << "chunk size: " << chunk;
+	}
+}
+
+TEST_F(Test_io_seatalk_decoder, bus_read_error)
+{
+	io::seatalk_decoder decoder;
+
+	EXPECT_NO_THROW(decoder.process(0xff));
+	EXPECT_THROW(decoder.process(0x01), std::runtime_error);
+}
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <marnav/io/seatalk_reader.hpp>
 #include <marnav/io/device.hpp>
+#include <algorithm>
 
 namespace
 {
@@ -126,6 +127,39 @@ private:
 	uint32_t index;
 };
 
+/// Delivers the data in chunks of at most the specified size, partial reads.
+class chunk_device : public ::io::device
+{
+public:
+	chunk_device(uint32_t chunk)
+		: index(0)
+		, chunk(chunk)
+	{
+	}
+
+	void open() override {}
+	void close() override {}
+
+	virtual int read(char * buffer, uint32_t size) override
+	{
+		if (index >= sizeof(DATA))
+			return 0; // end of data
+		const uint32_t n = std::min({size, chunk, static_cast<uint32_t>(sizeof(DATA) - index)});
+		std::copy_n(DATA + index, n, reinterpret_cast<uint8_t *>(buffer));
+		index += n;
+		return static_cast<int>(n);
+	}
+
+	virtual int write(const char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+private:
+	uint32_t index;
+	uint32_t chunk;
+};
+
 class dummy_reader : public ::io::seatalk_reader
 {
 public:
@@ -135,6 +169,12 @@ public:
 	{
 	}
 
+	dummy_reader(std::unique_ptr<::io::device> && dev, std::size_t buffer_size)
+		: seatalk_reader(std::move(dev), buffer_size)
+		, num_messages(0)
+	{
+	}
+
 	int get_num_messages() const { return num_messages; }
 
 protected:
@@ -154,6 +194,12 @@ public:
 	{
 	}
 
+	message_reader(std::unique_ptr<::io::device> && dev, std::size_t buffer_size)
+		: seatalk_reader(std::move(dev), buffer_size)
+		, message_received(false)
+	{
+	}
+
 	bool read_message(seatalk::raw & data)
 	{
 		while (read()) {
@@ -235,4 +281,44 @@ TEST_F(Test_io_seatalk_reader, read_third_message__water_temperature)
 	EXPECT_EQ(0x64u, msg[2]);
 	EXPECT_EQ(0x00u, msg[3]);
 }
+
+TEST_F(Test_io_seatalk_reader, buffered_invalid_buffer_size)
+{
+	EXPECT_ANY_THROW(dummy_reader(utils::make_unique<chunk_device>(1u), 0u));
+}
+
+TEST_F(Test_io_seatalk_reader, buffered_read_count_messages_and_collisions)
+{
+	for (uint32_t chunk = 1u; chunk <= sizeof(DATA); ++chunk) {
+		dummy_reader device{utils::make_unique<chunk_device>(chunk),
+			::io::seatalk_reader::default_buffer_size};
+
+		while (device.read())
+			;
+
+		EXPECT_EQ(9, device.get_num_messages()) << "chunk size: " << chunk;
+		EXPECT_EQ(1u, device.get_collisions()) << "chunk size: " << chunk;
+	}
+}
+
+TEST_F(Test_io_seatalk_reader, buffered_read_message)
+{
+	message_reader dev{utils::make_unique<chunk_device>(static_cast<uint32_t>(sizeof(DATA))),
+		::io::seatalk_reader::default_buffer_size};
+	seatalk::raw msg;
+
+	ASSERT_NO_THROW(dev.read_message(msg));
+	ASSERT_NO_THROW(dev.read_message(msg));
+	ASSERT_NO_THROW(dev.read_message(msg));
+	EXPECT_EQ(4u, msg.size());
+	EXPECT_EQ(0x27u, msg[0]);
+	EXPECT_EQ(0x01u, msg[1]);
+	EXPECT_EQ(0x64u, msg[2]);
+	EXPECT_EQ(0x00u, msg[3]);
+
+	int num_messages = 3;
+	while (dev.read_message(msg))
+		++num_messages;
+	EXPECT_EQ(9, num_messages);
+}
 }
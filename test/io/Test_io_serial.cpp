@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <marnav/io/serial.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Pseudo terminal, the slave side is opened by the serial device under test.
+class pseudo_terminal
+{
+public:
+	pseudo_terminal()
+	{
+		master = ::posix_openpt(O_RDWR | O_NOCTTY);
+		if ((master < 0) || (::grantpt(master) < 0) || (::unlockpt(master) < 0))
+			throw std::runtime_error{"unable to create pseudo terminal"};
+	}
+
+	~pseudo_terminal() { ::close(master); }
+
+	std::string name() const { return ::ptsname(master); }
+
+	void write(const std::string & s)
+	{
+		if (::write(master, s.data(), s.size()) != static_cast<ssize_t>(s.size()))
+			throw std::runtime_error{"unable to write to pseudo terminal"};
+	}
+
+private:
+	int master = -1;
+};
+
+io::serial make_serial(const std::string & name)
+{
+	return io::serial{name, io::serial::baud::baud_4800, io::serial::databits::bit_8,
+		io::serial::stopbits::bit_1, io::serial::parity::none};
+}
+
+class Test_io_serial : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_serial, default_settings)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+
+	EXPECT_EQ(io::serial::mode::blocking, dev.get_mode());
+	EXPECT_EQ(1u, dev.get_min_bytes());
+	EXPECT_EQ(0u, dev.get_timeout_ds());
+	EXPECT_FALSE(dev.get_low_latency());
+	EXPECT_GT(0, dev.get_fd());
+}
+
+TEST_F(Test_io_serial, open_invalid_device)
+{
+	auto dev = make_serial("/dev/non-existing-serial-device");
+
+	EXPECT_THROW(dev.open(), std::runtime_error);
+}
+
+TEST_F(Test_io_serial, selectable)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+	const io::selectable & sel = dev;
+
+	dev.open();
+	EXPECT_LE(0, sel.get_fd());
+	dev.close();
+	EXPECT_GT(0, sel.get_fd());
+}
+
+TEST_F(Test_io_serial, non_blocking_read)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+	dev.set_mode(io::serial::mode::non_blocking);
+	dev.open();
+
+	EXPECT_NE(0, ::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK);
+
+	char buffer[16];
+	errno = 0;
+	EXPECT_EQ(-1, dev.read(buffer, sizeof(buffer)));
+	EXPECT_EQ(EAGAIN, errno);
+
+	pt.write("abc");
+	::usleep(10000);
+	EXPECT_EQ(3, dev.read(buffer, sizeof(buffer)));
+	EXPECT_EQ("abc", std::string(buffer, 3));
+}
+
+TEST_F(Test_io_serial, batching_min_bytes)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+	dev.set_batching(4u, 0u);
+	dev.open();
+
+	EXPECT_EQ(0, ::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK);
+
+	pt.write("abcdef");
+	char buffer[16];
+	EXPECT_LE(4, dev.read(buffer, sizeof(buffer)));
+}
+
+TEST_F(Test_io_serial, batching_timeout_without_data)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+	dev.set_batching(0u, 1u);
+	dev.open();
+
+	char buffer[16];
+	EXPECT_EQ(0, dev.read(buffer, sizeof(buffer)));
+}
+
+TEST_F(Test_io_serial, low_latency_not_supported_by_driver)
+{
+	pseudo_terminal pt;
+	auto dev = make_serial(pt.name());
+	dev.set_low_latency(true);
+
+	EXPECT_NO_THROW(dev.open());
+	EXPECT_TRUE(dev.get_low_latency());
+}
+}
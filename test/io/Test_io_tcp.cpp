@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <marnav/io/tcp_client.hpp>
+#include <marnav/io/tcp_server.hpp>
+#include <marnav/io/default_nmea_reader.hpp>
+#include <marnav/utils/unique.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+/// Accepts connections until the expected number of clients is connected.
+void accept_clients(::io::tcp_server & server, std::size_t n)
+{
+	for (int i = 0; (i < 1000) && (server.get_num_clients() < n); ++i) {
+		if (server.accept() == 0u)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (server.get_num_clients() != n)
+		throw std::runtime_error{"clients not connected"};
+}
+
+/// Reads from the client until the expected number of bytes is received.
+std::string receive(::io::tcp_client & client, std::size_t n)
+{
+	std::string result;
+	char buffer[4096];
+	while (result.size() < n) {
+		const int rc = client.read(buffer, sizeof(buffer));
+		if (rc <= 0)
+			break;
+		result.append(buffer, static_cast<std::size_t>(rc));
+	}
+	return result;
+}
+
+class Test_io_tcp : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_tcp, client_connection_refused)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+	const auto port = server.get_port();
+	server.close();
+
+	::io::tcp_client client{"127.0.0.1", port};
+	EXPECT_THROW(client.open(), std::runtime_error);
+}
+
+TEST_F(Test_io_tcp, not_open)
+{
+	::io::tcp_server server{0u};
+	::io::tcp_client client{"127.0.0.1", 1u};
+	char buffer[16];
+
+	EXPECT_THROW(server.write("abc", 3u), std::runtime_error);
+	EXPECT_THROW(server.accept(), std::runtime_error);
+	EXPECT_THROW(client.read(buffer, sizeof(buffer)), std::runtime_error);
+	EXPECT_THROW(client.write("abc", 3u), std::runtime_error);
+	EXPECT_GT(0, server.get_fd());
+	EXPECT_GT(0, client.get_fd());
+}
+
+TEST_F(Test_io_tcp, server_read_not_supported)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+	char buffer[16];
+
+	EXPECT_THROW(server.read(buffer, sizeof(buffer)), std::runtime_error);
+}
+
+TEST_F(Test_io_tcp, write_without_clients)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+
+	EXPECT_EQ(3, server.write("abc", 3u));
+	EXPECT_TRUE(server.flush());
+}
+
+TEST_F(Test_io_tcp, fan_out)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+
+	::io::tcp_client c0{"127.0.0.1", server.get_port()};
+	::io::tcp_client c1{"127.0.0.1", server.get_port()};
+	c0.open();
+	c1.open();
+	accept_clients(server, 2u);
+
+	EXPECT_EQ(static_cast<int>(DATA.size()),
+		server.write(DATA.data(), static_cast<uint32_t>(DATA.size())));
+
+	EXPECT_EQ(DATA, receive(c0, DATA.size()));
+	EXPECT_EQ(DATA, receive(c1, DATA.size()));
+}
+
+TEST_F(Test_io_tcp, client_write)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+
+	::io::tcp_client client{"127.0.0.1", server.get_port()};
+	client.set_no_delay(true);
+	client.open();
+
+	EXPECT_EQ(3, client.write("abc", 3u));
+}
+
+TEST_F(Test_io_tcp, disconnected_client_is_removed)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+
+	::io::tcp_client client{"127.0.0.1", server.get_port()};
+	client.open();
+	accept_clients(server, 1u);
+	client.close();
+
+	// the first write after the disconnect may still succeed
+	for (int i = 0; (i < 100) && (server.get_num_clients() > 0u); ++i) {
+		server.write(DATA.data(), static_cast<uint32_t>(DATA.size()));
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_EQ(0u, server.get_num_clients());
+}
+
+TEST_F(Test_io_tcp, slow_client_drop)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.set_queue_limit(1024u);
+	server.open();
+
+	::io::tcp_client client{"127.0.0.1", server.get_port()};
+	client.open();
+	accept_clients(server, 1u);
+
+	// the client does not read, until all buffers are full
+	const std::vector<char> block(64u * 1024u, 'x');
+	for (int i = 0; (i < 4096) && (server.get_num_dropped() == 0u); ++i)
+		server.write(block.data(), static_cast<uint32_t>(block.size()));
+
+	EXPECT_LT(0u, server.get_num_dropped());
+	EXPECT_EQ(1u, server.get_num_clients());
+	EXPECT_FALSE(server.flush());
+}
+
+TEST_F(Test_io_tcp, slow_client_disconnect)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.set_queue_limit(1024u);
+	server.set_overflow_policy(::io::tcp_server::overflow_policy::disconnect);
+	server.open();
+
+	::io::tcp_client client{"127.0.0.1", server.get_port()};
+	client.open();
+	accept_clients(server, 1u);
+
+	const std::vector<char> block(64u * 1024u, 'x');
+	for (int i = 0; (i < 4096) && (server.get_num_clients() > 0u); ++i)
+		server.write(block.data(), static_cast<uint32_t>(block.size()));
+
+	EXPECT_EQ(0u, server.get_num_clients());
+	EXPECT_EQ(0u, server.get_num_dropped());
+}
+
+TEST_F(Test_io_tcp, slow_client_block)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.set_queue_limit(1024u);
+	server.set_overflow_policy(::io::tcp_server::overflow_policy::block);
+	server.open();
+
+	::io::tcp_client client{"127.0.0.1", server.get_port()};
+	client.open();
+	accept_clients(server, 1u);
+
+	// more data than fits into the buffers of the system, without loss
+	const std::size_t total = 32u * 1024u * 1024u;
+	std::size_t received = 0u;
+	std::thread reader{[&client, &received, total]() {
+		char buffer[64 * 1024];
+		while (received < total) {
+			const int rc = client.read(buffer, sizeof(buffer));
+			if (rc <= 0)
+				break;
+			received += static_cast<std::size_t>(rc);
+		}
+	}};
+
+	const std::vector<char> block(64u * 1024u, 'x');
+	for (std::size_t sent = 0u; sent < total; sent += block.size())
+		server.write(block.data(), static_cast<uint32_t>(block.size()));
+	while (!server.flush())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	reader.join();
+
+	EXPECT_EQ(total, received);
+	EXPECT_EQ(0u, server.get_num_dropped());
+}
+
+TEST_F(Test_io_tcp, nmea_reader)
+{
+	::io::tcp_server server{0u, "127.0.0.1"};
+	server.open();
+
+	::io::default_nmea_reader reader{
+		utils::make_unique<::io::tcp_client>("127.0.0.1", server.get_port()),
+		::io::nmea_reader::default_buffer_size};
+
+	accept_clients(server, 1u);
+	server.write(DATA.data(), static_cast<uint32_t>(DATA.size()));
+	server.close();
+
+	int num_sentences = 0;
+	std::string s;
+	while (reader.read_sentence(s))
+		++num_sentences;
+	EXPECT_EQ(3, num_sentences);
+}
+}
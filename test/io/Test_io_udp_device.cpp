@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <marnav/io/udp_device.hpp>
+#include <marnav/io/default_nmea_reader.hpp>
+#include <marnav/utils/unique.hpp>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string SENTENCE_1 = "$GPHDT,123.4,T*31\r\n";
+static const std::string SENTENCE_2 = "$IIMTW,10.5,C*17\r\n";
+
+void send(::io::udp_device & dev, const std::string & s)
+{
+	dev.write(s.data(), static_cast<uint32_t>(s.size()));
+}
+
+class Test_io_udp_device : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_udp_device, default_port)
+{
+	EXPECT_EQ(10110u, ::io::udp_device::default_port);
+}
+
+TEST_F(Test_io_udp_device, invalid_settings)
+{
+	::io::udp_device dev{0u};
+
+	EXPECT_THROW(dev.set_destination("", 10110u), std::invalid_argument);
+	EXPECT_THROW(dev.set_destination("127.0.0.1", 0u), std::invalid_argument);
+	EXPECT_THROW(dev.join_multicast("127.0.0.1"), std::invalid_argument);
+	EXPECT_THROW(dev.join_multicast("foo"), std::invalid_argument);
+	EXPECT_THROW(dev.set_multicast_interface("foo"), std::invalid_argument);
+	EXPECT_THROW(dev.set_max_datagram_size(0u), std::invalid_argument);
+}
+
+TEST_F(Test_io_udp_device, write_without_destination)
+{
+	::io::udp_device dev{0u};
+	dev.open();
+
+	EXPECT_THROW(dev.write("abc", 3u), std::runtime_error);
+}
+
+TEST_F(Test_io_udp_device, send_receive_batched)
+{
+	::io::udp_device rx{0u};
+	rx.open();
+	::io::udp_device tx{0u};
+	tx.set_destination("127.0.0.1", rx.get_port());
+	tx.open();
+
+	send(tx, SENTENCE_1);
+	send(tx, SENTENCE_2);
+
+	// both datagrams with one read
+	char buffer[8192];
+	const int rc = rx.read(buffer, sizeof(buffer));
+	EXPECT_EQ(SENTENCE_1 + SENTENCE_2, std::string(buffer, static_cast<std::size_t>(rc)));
+}
+
+TEST_F(Test_io_udp_device, write_gather_one_datagram_per_buffer)
+{
+	::io::udp_device rx{0u};
+	rx.set_max_datagram_size(32u); // larger datagrams would be dropped
+	rx.open();
+	::io::udp_device tx{0u};
+	tx.set_destination("127.0.0.1", rx.get_port());
+	tx.open();
+
+	const std::string sentences[] = {SENTENCE_1, SENTENCE_2, SENTENCE_1};
+	struct iovec iov[3];
+	for (int i = 0; i < 3; ++i) {
+		iov[i].iov_base = const_cast<char *>(sentences[i].data());
+		iov[i].iov_len = sentences[i].size();
+	}
+	const auto total = SENTENCE_1.size() * 2u + SENTENCE_2.size();
+	EXPECT_EQ(static_cast<int>(total), tx.write_gather(iov, 3));
+
+	std::string received;
+	char buffer[8192];
+	while (received.size() < total) {
+		const int rc = rx.read(buffer, sizeof(buffer));
+		ASSERT_GT(rc, 0);
+		received.append(buffer, static_cast<std::size_t>(rc));
+	}
+	EXPECT_EQ(SENTENCE_1 + SENTENCE_2 + SENTENCE_1, received);
+}
+
+TEST_F(Test_io_udp_device, non_blocking_read)
+{
+	::io::udp_device rx{0u};
+	rx.open();
+	::fcntl(rx.get_fd(), F_SETFL, ::fcntl(rx.get_fd(), F_GETFL) | O_NONBLOCK);
+
+	char buffer[4096];
+	errno = 0;
+	EXPECT_EQ(-1, rx.read(buffer, sizeof(buffer)));
+	EXPECT_EQ(EAGAIN, errno);
+}
+
+TEST_F(Test_io_udp_device, truncated_datagram_is_dropped)
+{
+	::io::udp_device rx{0u};
+	rx.set_max_datagram_size(8u);
+	rx.open();
+	::io::udp_device tx{0u};
+	tx.set_destination("127.0.0.1", rx.get_port());
+	tx.open();
+
+	send(tx, SENTENCE_1);
+	send(tx, "abc");
+
+	char buffer[4096];
+	const int rc = rx.read(buffer, sizeof(buffer));
+	EXPECT_EQ("abc", std::string(buffer, static_cast<std::size_t>(rc)));
+}
+
+TEST_F(Test_io_udp_device, multicast)
+{
+	::io::udp_device rx{0u};
+	rx.set_multicast_interface("127.0.0.1");
+	rx.join_multicast("239.192.0.1");
+	rx.open();
+
+	::io::udp_device tx{0u};
+	tx.set_multicast_interface("127.0.0.1");
+	tx.set_destination("239.192.0.1", rx.get_port());
+	tx.open();
+
+	send(tx, SENTENCE_1);
+
+	char buffer[4096];
+	const int rc = rx.read(buffer, sizeof(buffer));
+	EXPECT_EQ(SENTENCE_1, std::string(buffer, static_cast<std::size_t>(rc)));
+}
+
+TEST_F(Test_io_udp_device, nmea_reader)
+{
+	auto dev = utils::make_unique<::io::udp_device>(0u);
+	dev->open();
+	const auto port = dev->get_port();
+	::io::default_nmea_reader reader{std::move(dev), ::io::nmea_reader::default_buffer_size};
+
+	::io::udp_device tx{0u};
+	tx.set_destination("localhost", port);
+	tx.open();
+	send(tx, SENTENCE_1 + SENTENCE_2);
+
+	std::string s;
+	ASSERT_TRUE(reader.read_sentence(s));
+	EXPECT_EQ("$GPHDT,123.4,T*31", s);
+	ASSERT_TRUE(reader.read_sentence(s));
+	EXPECT_EQ("$IIMTW,10.5,C*17", s);
+}
+}
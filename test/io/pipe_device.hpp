@@ -0,0 +1,51 @@
+#ifndef TEST__PIPE_DEVICE__HPP
+#define TEST__PIPE_DEVICE__HPP
+
+#include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+/// Reading end of a pipe, the writing end is held by the test.
+class pipe_device : public ::marnav::io::device, public ::marnav::io::selectable
+{
+public:
+	explicit pipe_device(int fd)
+		: fd(fd)
+	{
+	}
+
+	~pipe_device() { close(); }
+
+	void open() override {}
+
+	void close() override
+	{
+		if (fd < 0)
+			return;
+		::close(fd);
+		fd = -1;
+	}
+
+	int read(char * buffer, uint32_t size) override
+	{
+		if (fd < 0)
+			throw std::runtime_error{"device not open"};
+		return static_cast<int>(::read(fd, buffer, size));
+	}
+
+	int write(const char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+	int get_fd() const override { return fd; }
+
+private:
+	int fd;
+};
+}
+
+#endif
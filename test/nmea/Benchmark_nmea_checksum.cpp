@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 #include <marnav/nmea/checksum.hpp>
+#include <cstring>
+#include <string>
 
 namespace
 {
@@ -10,6 +12,29 @@ static std::string checksum_to_string__v0(uint8_t sum)
 	snprintf(buf, sizeof(buf), "%02X", sum);
 	return buf;
 }
+
+/// Returns a sentence, without start token, of the specified total size.
+static std::string make_data(std::size_t n)
+{
+	std::string s;
+	for (std::size_t i = 0; s.size() + 3 < n; ++i)
+		s += static_cast<char>(',' + i % 50);
+	s += '*';
+	s += marnav::nmea::checksum_to_string(marnav::nmea::checksum(begin(s), end(s) - 1));
+	return s;
+}
+
+// Baseline implementation, searches the end token first and computes the checksum
+// byte by byte in a second pass.
+static bool scan_checksum__v0(const char * first, const char * last)
+{
+	const char * end = static_cast<const char *>(std::memchr(first, '*', last - first));
+	if (!end || (end + 3 != last))
+		return false;
+	const uint8_t expected
+		= static_cast<uint8_t>(std::stoul(std::string(end + 1, 2), nullptr, 16));
+	return expected == marnav::nmea::checksum<const char *>(first, end);
+}
 }
 
 static void Benchmark_nmea_checksum_to_string_v0(benchmark::State & state)
@@ -34,4 +59,49 @@ static void Benchmark_nmea_checksum_to_string(benchmark::State & state)
 
 BENCHMARK(Benchmark_nmea_checksum_to_string)->Range(0x00, 0xff);
 
+static void Benchmark_nmea_checksum_generic(benchmark::State & state)
+{
+	const std::string s = make_data(state.range(0));
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(
+			marnav::nmea::checksum<const char *>(s.data(), s.data() + s.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(Benchmark_nmea_checksum_generic)->RangeMultiplier(2)->Range(16, 128);
+
+static void Benchmark_nmea_checksum_buffer(benchmark::State & state)
+{
+	const std::string s = make_data(state.range(0));
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(marnav::nmea::checksum(s.data(), s.data() + s.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(Benchmark_nmea_checksum_buffer)->RangeMultiplier(2)->Range(16, 128);
+
+static void Benchmark_nmea_scan_checksum_v0(benchmark::State & state)
+{
+	const std::string s = make_data(state.range(0));
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(scan_checksum__v0(s.data(), s.data() + s.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(Benchmark_nmea_scan_checksum_v0)->RangeMultiplier(2)->Range(16, 128);
+
+static void Benchmark_nmea_scan_checksum(benchmark::State & state)
+{
+	const std::string s = make_data(state.range(0));
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(marnav::nmea::scan_checksum(s.data(), s.data() + s.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * s.size());
+}
+
+BENCHMARK(Benchmark_nmea_scan_checksum)->RangeMultiplier(2)->Range(16, 128);
+
 BENCHMARK_MAIN()
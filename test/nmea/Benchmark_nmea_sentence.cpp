@@ -76,6 +76,11 @@
 #include <marnav/nmea/ztg.hpp>
 #include <marnav/nmea/pgrme.hpp>
 #include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence_arena.hpp>
+#include <marnav/nmea/any_sentence.hpp>
+#include <marnav/nmea/stream_decoder.hpp>
+#include <marnav/nmea/sentence_view.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
 
 using namespace marnav;
 
@@ -210,6 +215,94 @@ static void Benchmark_make_sentence(benchmark::State & state)
 
 BENCHMARK(Benchmark_make_sentence)->Apply(all_sentences);
 
+static void Benchmark_make_sentence_arena(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	nmea::sentence_arena arena;
+	std::size_t n = 0;
+	while (state.KeepRunning()) {
+		auto tmp = nmea::make_sentence(arena, sentences[state.range(0)].text);
+		benchmark::DoNotOptimize(tmp);
+		if (++n == 1000) {
+			arena.reset();
+			n = 0;
+		}
+	}
+}
+
+BENCHMARK(Benchmark_make_sentence_arena)->Apply(all_sentences);
+
+static void Benchmark_make_any_sentence(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	while (state.KeepRunning()) {
+		auto tmp = nmea::make_any_sentence(sentences[state.range(0)].text);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_make_any_sentence)->Apply(all_sentences);
+
+static void Benchmark_decode_sentence(benchmark::State & state)
+{
+	const auto & text = sentences[state.range(0)].text;
+	state.SetLabel(sentences[state.range(0)].tag);
+	nmea::any_sentence tmp;
+	while (state.KeepRunning()) {
+		auto rc = nmea::decode_sentence(text.data(), text.size(), tmp);
+		benchmark::DoNotOptimize(rc);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_decode_sentence)->Apply(all_sentences);
+
+static void Benchmark_make_sentence_view(benchmark::State & state)
+{
+	const auto & text = sentences[state.range(0)].text;
+	state.SetLabel(sentences[state.range(0)].tag);
+	while (state.KeepRunning()) {
+		const auto v = nmea::make_sentence_view(text);
+		auto tmp = v.size() ? v.get_field(0) : std::string{};
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_make_sentence_view)->Apply(all_sentences);
+
+static void Benchmark_sentence_filter(benchmark::State & state)
+{
+	const auto & text = sentences[state.range(0)].text;
+	state.SetLabel(sentences[state.range(0)].tag);
+	const auto filter = nmea::sentence_filter::all().reject(nmea::sentence_id::GSV);
+	while (state.KeepRunning()) {
+		auto tmp = filter.accepts(text);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_sentence_filter)->Apply(all_sentences);
+
+static void Benchmark_stream_decoder(benchmark::State & state)
+{
+	std::string data;
+	for (const auto & s : sentences)
+		data += s.text + "\r\n";
+	const auto chunk = static_cast<std::size_t>(state.range(0));
+
+	std::size_t n = 0;
+	nmea::stream_decoder decoder{[&n](const nmea::any_sentence &) { ++n; }};
+	while (state.KeepRunning()) {
+		for (std::size_t i = 0; i < data.size(); i += chunk)
+			decoder.feed(data.data() + i, std::min(chunk, data.size() - i));
+	}
+	benchmark::DoNotOptimize(n);
+	state.SetBytesProcessed(state.iterations() * data.size());
+	state.SetItemsProcessed(state.iterations() * sentences.size());
+}
+
+BENCHMARK(Benchmark_stream_decoder)->Arg(1)->Arg(64)->Arg(4096);
+
 static void Benchmark_sentence_to_string(benchmark::State & state)
 {
 	state.SetLabel(sentences[state.range(0)].tag);
@@ -225,6 +318,20 @@ static void Benchmark_sentence_to_string(benchmark::State & state)
 
 BENCHMARK(Benchmark_sentence_to_string)->Apply(all_sentences);
 
+static void Benchmark_sentence_write_to(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	const auto sentence = nmea::make_sentence(sentences[state.range(0)].text);
+	char buf[nmea::sentence::max_length + 1];
+	while (state.KeepRunning()) {
+		auto n = sentence->write_to(buf, sizeof(buf));
+		benchmark::DoNotOptimize(n);
+		benchmark::DoNotOptimize(buf);
+	}
+}
+
+BENCHMARK(Benchmark_sentence_write_to)->Apply(all_sentences);
+
 template <class T> static void Benchmark_create_sentence(benchmark::State & state)
 {
 	state.SetLabel(sentences[state.range(0)].tag);
@@ -320,4 +427,62 @@ static void Benchmark_extract_id(benchmark::State & state)
 
 BENCHMARK(Benchmark_extract_id)->Apply(all_sentences);
 
+namespace
+{
+static const std::vector<std::string> supported_tags = nmea::get_supported_sentences_str();
+static const std::vector<nmea::sentence_id> supported_ids = nmea::get_supported_sentences_id();
+
+// Baseline implementation, linear search through the registered tags.
+static nmea::sentence_id tag_to_id__linear(const std::string & tag)
+{
+	const auto i = std::find(supported_tags.begin(), supported_tags.end(), tag);
+	if (i == supported_tags.end())
+		throw std::runtime_error{"unknown tag"};
+	return supported_ids[std::distance(supported_tags.begin(), i)];
+}
+
+static void all_tags(benchmark::internal::Benchmark * b)
+{
+	for (std::size_t i = 0; i < supported_tags.size(); ++i) {
+		b->Arg(i);
+	}
+}
+}
+
+static void Benchmark_tag_to_id_linear(benchmark::State & state)
+{
+	const auto & tag = supported_tags[state.range(0)];
+	state.SetLabel(tag);
+	while (state.KeepRunning()) {
+		auto tmp = tag_to_id__linear(tag);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_tag_to_id_linear)->Apply(all_tags);
+
+static void Benchmark_tag_to_id(benchmark::State & state)
+{
+	const auto & tag = supported_tags[state.range(0)];
+	state.SetLabel(tag);
+	while (state.KeepRunning()) {
+		auto tmp = nmea::tag_to_id(tag);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_tag_to_id)->Apply(all_tags);
+
+static void Benchmark_to_string_sentence_id(benchmark::State & state)
+{
+	const auto id = supported_ids[state.range(0)];
+	state.SetLabel(supported_tags[state.range(0)]);
+	while (state.KeepRunning()) {
+		auto tmp = nmea::to_string(id);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_to_string_sentence_id)->Apply(all_tags);
+
 BENCHMARK_MAIN()
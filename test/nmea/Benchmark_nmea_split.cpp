@@ -168,4 +168,18 @@ static void Benchmark_nmea_split(benchmark::State & state)
 
 BENCHMARK(Benchmark_nmea_split)->Range(0, 2);
 
+static void Benchmark_nmea_split_fields(benchmark::State & state)
+{
+	std::string sentence = SENTENCES[state.range(0)];
+	marnav::nmea::detail::field_view result[marnav::nmea::detail::max_fields];
+	while (state.KeepRunning()) {
+		auto n = marnav::nmea::detail::split_fields(
+			sentence.data(), sentence.size(), result, marnav::nmea::detail::max_fields);
+		benchmark::DoNotOptimize(n);
+		benchmark::DoNotOptimize(result);
+	}
+}
+
+BENCHMARK(Benchmark_nmea_split_fields)->Range(0, 2);
+
 BENCHMARK_MAIN()
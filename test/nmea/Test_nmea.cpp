@@ -131,6 +131,27 @@ TEST_F(Test_nmea, tag_to_id)
 	EXPECT_EQ(nmea::sentence_id::BOD, id);
 }
 
+TEST_F(Test_nmea, tag_to_id_all_supported)
+{
+	const auto tags = nmea::get_supported_sentences_str();
+	const auto ids = nmea::get_supported_sentences_id();
+
+	ASSERT_EQ(tags.size(), ids.size());
+	for (std::size_t i = 0; i < tags.size(); ++i) {
+		EXPECT_EQ(ids[i], nmea::tag_to_id(tags[i])) << tags[i];
+		EXPECT_EQ(tags[i], nmea::to_string(ids[i])) << tags[i];
+	}
+}
+
+TEST_F(Test_nmea, tag_to_id_prefix_of_known_tag)
+{
+	EXPECT_ANY_THROW(nmea::tag_to_id(""));
+	EXPECT_ANY_THROW(nmea::tag_to_id("PGRM"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("GG"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("GGAA"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("STALKSTALK"));
+}
+
 TEST_F(Test_nmea, tag_to_id_invalid_tag)
 {
 	EXPECT_ANY_THROW(nmea::tag_to_id("???"));
@@ -184,6 +205,115 @@ TEST_F(Test_nmea, make_sentence_tag_block)
 		"g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A", s->get_tag_block().c_str());
 }
 
+TEST_F(Test_nmea, make_sentence_buffer)
+{
+	static const char raw[] = "$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A";
+
+	const auto s = nmea::make_sentence(raw, sizeof(raw) - 1);
+
+	ASSERT_TRUE(s != nullptr);
+	EXPECT_EQ(nmea::sentence_id::VWR, s->id());
+	EXPECT_EQ(nmea::to_string(*nmea::make_sentence(std::string{raw})), nmea::to_string(*s));
+}
+
+TEST_F(Test_nmea, make_sentence_buffer_not_null_terminated)
+{
+	static const std::string raw = "$IIMTW,9.5,C*2F$IIMTW,9.5";
+
+	const auto s = nmea::make_sentence(raw.data(), 15);
+
+	ASSERT_TRUE(s != nullptr);
+	EXPECT_STREQ("$IIMTW,9.5,C*2F", nmea::to_string(*s).c_str());
+}
+
+TEST_F(Test_nmea, make_sentence_buffer_tag_block)
+{
+	static const std::string t = "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\!AIVDM,"
+								 "1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13";
+
+	const auto s = nmea::make_sentence(t.data(), t.size());
+
+	ASSERT_TRUE(s != nullptr);
+	EXPECT_STREQ(
+		"g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A", s->get_tag_block().c_str());
+}
+
+TEST_F(Test_nmea, make_sentence_buffer_invalid)
+{
+	EXPECT_ANY_THROW(nmea::make_sentence(nullptr, 0));
+	EXPECT_ANY_THROW(nmea::make_sentence("$GPMTW,,1E", 10));
+	EXPECT_ANY_THROW(nmea::make_sentence("$GPMTW,,*1E", 11));
+	EXPECT_ANY_THROW(nmea::make_sentence("$GPMTW,,*XY", 11));
+	EXPECT_THROW(nmea::make_sentence("$GPMTW,,*1E", 11), nmea::checksum_error);
+}
+
+TEST_F(Test_nmea, try_make_sentence)
+{
+	const auto s = nmea::try_make_sentence("$IIMTW,9.5,C*2F");
+
+	ASSERT_TRUE(s.has_value());
+	EXPECT_EQ(nmea::sentence_id::MTW, s.value()->id());
+}
+
+TEST_F(Test_nmea, try_make_sentence_tag_block)
+{
+	static const std::string t = "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\!AIVDM,"
+								 "1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13";
+
+	const auto s = nmea::try_make_sentence(t);
+
+	ASSERT_TRUE(s.has_value());
+	EXPECT_STREQ(
+		"g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A", (*s)->get_tag_block().c_str());
+}
+
+TEST_F(Test_nmea, try_make_sentence_errors)
+{
+	using nmea::parse_error;
+
+	struct entry {
+		std::string raw;
+		parse_error error;
+	};
+
+	static const std::vector<entry> cases = {
+		{"", parse_error::empty},
+		{"1234567890", parse_error::no_start_token},
+		{"$", parse_error::malformed},
+		{"$GPMTW,,1E", parse_error::invalid_checksum},
+		{"$GPMTW,,*XY", parse_error::invalid_checksum},
+		{"$GPMTW,,*1E", parse_error::checksum_mismatch},
+		{"$PXXX*08", parse_error::invalid_address},
+		{"$*00", parse_error::invalid_address},
+		{"$IIYYY*59", parse_error::unknown_sentence},
+		{"$IIMTW,X,C*00", parse_error::invalid_data},
+		{"$IIMTW,9.5*00", parse_error::invalid_data},
+	};
+
+	for (const auto & c : cases) {
+		const auto s = nmea::try_make_sentence(c.raw, nmea::checksum_handling::ignore);
+		if (c.error == parse_error::invalid_checksum || c.error == parse_error::checksum_mismatch)
+			continue;
+		ASSERT_FALSE(s.has_value()) << c.raw;
+		EXPECT_EQ(c.error, s.error()) << c.raw;
+	}
+
+	for (const auto & c : cases) {
+		if (c.error == parse_error::invalid_data)
+			continue;
+		const auto s = nmea::try_make_sentence(c.raw);
+		ASSERT_FALSE(s.has_value()) << c.raw;
+		EXPECT_EQ(c.error, s.error()) << c.raw << ": " << nmea::to_string(s.error());
+	}
+}
+
+TEST_F(Test_nmea, try_make_sentence_ignore_checksum)
+{
+	const auto s = nmea::try_make_sentence("$IIMTW,9.5,C*00", nmea::checksum_handling::ignore);
+
+	EXPECT_TRUE(s.has_value());
+}
+
 TEST_F(Test_nmea, parse_address_empty_string)
 {
 	EXPECT_ANY_THROW(nmea::detail::parse_address(std::string{}));
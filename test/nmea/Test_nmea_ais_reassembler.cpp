@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/ais_reassembler.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/mtw.hpp>
+#include <marnav/nmea/vdo.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/ais/message_05.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_ais_reassembler : public ::testing::Test
+{
+public:
+	using clock = nmea::ais_reassembler::clock;
+
+	static nmea::vdm make_fragment(uint32_t n_fragments, uint32_t fragment, uint32_t seq,
+		nmea::ais_channel channel, const std::string & data)
+	{
+		nmea::vdm s;
+		s.set_n_fragments(n_fragments);
+		s.set_fragment(fragment);
+		s.set_seq_msg_id(seq);
+		s.set_radio_channel(channel);
+		s.set_payload(std::make_pair(data, 0u));
+		return s;
+	}
+};
+
+TEST_F(Test_nmea_ais_reassembler, construction_invalid_number_of_slots)
+{
+	EXPECT_ANY_THROW(nmea::ais_reassembler(0));
+}
+
+TEST_F(Test_nmea_ais_reassembler, single_fragment)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	auto s = nmea::make_sentence("!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C");
+	EXPECT_TRUE(r.feed(*s, p));
+	ASSERT_EQ(1u, p.size());
+	EXPECT_STREQ("177KQJ5000G?tO`K>RA1wUbN0TKH", p[0].first.c_str());
+	EXPECT_EQ(0u, p[0].second);
+	EXPECT_EQ(1u, r.get_counters().completed);
+	EXPECT_EQ(0u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, two_fragments_to_message)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	auto s0 = nmea::make_sentence(
+		"!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E");
+	auto s1 = nmea::make_sentence("!AIVDM,2,2,3,B,1@0000000000000,2*55");
+
+	EXPECT_FALSE(r.feed(*s0, p));
+	EXPECT_EQ(1u, r.in_progress());
+	EXPECT_TRUE(r.feed(*s1, p));
+	EXPECT_EQ(0u, r.in_progress());
+	ASSERT_EQ(2u, p.size());
+	EXPECT_EQ(2u, p[1].second);
+
+	auto m = ais::message_cast<ais::message_05>(ais::make_message(p));
+	ASSERT_NE(nullptr, m);
+}
+
+TEST_F(Test_nmea_ais_reassembler, other_sentences_are_ignored)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(nmea::mtw{}, p));
+	EXPECT_EQ(0u, r.get_counters().invalid);
+	EXPECT_TRUE(p.empty());
+}
+
+TEST_F(Test_nmea_ais_reassembler, vdm_and_vdo_are_kept_apart)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	nmea::vdo o;
+	o.set_n_fragments(2);
+	o.set_fragment(1);
+	o.set_seq_msg_id(1);
+	o.set_radio_channel(nmea::ais_channel::A);
+	o.set_payload(std::make_pair(std::string{"O"}, 0u));
+
+	EXPECT_FALSE(r.feed(o, p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "M"), p));
+	EXPECT_EQ(1u, r.get_counters().orphans);
+	EXPECT_EQ(1u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, interleaved_messages)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(3, 1, 1, nmea::ais_channel::A, "a1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::B, "b1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(3, 2, 1, nmea::ais_channel::A, "a2"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 2, nmea::ais_channel::A, "c1"), p));
+	EXPECT_EQ(3u, r.in_progress());
+
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::B, "b2"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("b1", p[0].first.c_str());
+	EXPECT_STREQ("b2", p[1].first.c_str());
+
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 2, nmea::ais_channel::A, "c2"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("c1", p[0].first.c_str());
+	EXPECT_STREQ("c2", p[1].first.c_str());
+
+	EXPECT_TRUE(r.feed(make_fragment(3, 3, 1, nmea::ais_channel::A, "a3"), p));
+	ASSERT_EQ(3u, p.size());
+	EXPECT_STREQ("a1", p[0].first.c_str());
+	EXPECT_STREQ("a2", p[1].first.c_str());
+	EXPECT_STREQ("a3", p[2].first.c_str());
+
+	EXPECT_EQ(3u, r.get_counters().completed);
+	EXPECT_EQ(0u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, out_of_order_after_first_fragment)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(3, 1, 4, nmea::ais_channel::A, "x1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(3, 3, 4, nmea::ais_channel::A, "x3"), p));
+	EXPECT_TRUE(r.feed(make_fragment(3, 2, 4, nmea::ais_channel::A, "x2"), p));
+	ASSERT_EQ(3u, p.size());
+	EXPECT_STREQ("x1", p[0].first.c_str());
+	EXPECT_STREQ("x2", p[1].first.c_str());
+	EXPECT_STREQ("x3", p[2].first.c_str());
+}
+
+TEST_F(Test_nmea_ais_reassembler, orphans)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a2"), p));
+	EXPECT_EQ(1u, r.get_counters().orphans);
+	EXPECT_EQ(0u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, duplicates)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(3, 1, 1, nmea::ais_channel::A, "a1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(3, 2, 1, nmea::ais_channel::A, "a2"), p));
+	EXPECT_FALSE(r.feed(make_fragment(3, 2, 1, nmea::ais_channel::A, "a2"), p));
+	EXPECT_EQ(1u, r.get_counters().duplicates);
+	EXPECT_TRUE(r.feed(make_fragment(3, 3, 1, nmea::ais_channel::A, "a3"), p));
+}
+
+TEST_F(Test_nmea_ais_reassembler, invalid_fragments)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(0, 0, 1, nmea::ais_channel::A, "x"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 3, 1, nmea::ais_channel::A, "x"), p));
+	EXPECT_FALSE(r.feed(make_fragment(10, 1, 1, nmea::ais_channel::A, "x"), p));
+	EXPECT_EQ(3u, r.get_counters().invalid);
+	EXPECT_EQ(0u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, restart_with_same_key)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "old"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "new"), p));
+	EXPECT_EQ(1u, r.get_counters().restarted);
+	EXPECT_EQ(0u, r.get_counters().evicted);
+	EXPECT_EQ(0u, r.get_counters().duplicates);
+	EXPECT_EQ(1u, r.in_progress());
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "x"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("new", p[0].first.c_str());
+}
+
+TEST_F(Test_nmea_ais_reassembler, duplicate_first_fragment)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a1"), p));
+	EXPECT_EQ(1u, r.get_counters().duplicates);
+	EXPECT_EQ(0u, r.get_counters().restarted);
+	EXPECT_EQ(0u, r.get_counters().evicted);
+	EXPECT_EQ(1u, r.in_progress());
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a2"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("a1", p[0].first.c_str());
+}
+
+TEST_F(Test_nmea_ais_reassembler, single_fragments_if_slots_exhausted)
+{
+	nmea::ais_reassembler r{2};
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a1"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 2, nmea::ais_channel::A, "b1"), p));
+	ASSERT_EQ(2u, r.in_progress());
+
+	for (int i = 0; i < 100; ++i) {
+		const auto s = make_fragment(1, 1, 0, nmea::ais_channel::B, "single");
+		ASSERT_TRUE(r.feed(s, p));
+		ASSERT_EQ(1u, p.size());
+		EXPECT_STREQ("single", p[0].first.c_str());
+	}
+	EXPECT_EQ(100u, r.get_counters().completed);
+	EXPECT_EQ(0u, r.get_counters().evicted);
+	EXPECT_EQ(2u, r.in_progress());
+
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a2"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("a1", p[0].first.c_str());
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 2, nmea::ais_channel::A, "b2"), p));
+	ASSERT_EQ(2u, p.size());
+	EXPECT_STREQ("b1", p[0].first.c_str());
+}
+
+TEST_F(Test_nmea_ais_reassembler, eviction_of_oldest_if_slots_exhausted)
+{
+	nmea::ais_reassembler r{2};
+	nmea::ais_reassembler::payload p;
+	const auto t0 = clock::now();
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a"), p, t0));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 2, nmea::ais_channel::A, "b"), p,
+		t0 + std::chrono::milliseconds{1}));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 3, nmea::ais_channel::A, "c"), p,
+		t0 + std::chrono::milliseconds{2}));
+	EXPECT_EQ(1u, r.get_counters().evicted);
+	EXPECT_EQ(2u, r.in_progress());
+
+	const auto t1 = t0 + std::chrono::milliseconds{3};
+	EXPECT_FALSE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a"), p, t1));
+	EXPECT_EQ(1u, r.get_counters().orphans);
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 2, nmea::ais_channel::A, "b"), p, t1));
+	EXPECT_TRUE(r.feed(make_fragment(2, 2, 3, nmea::ais_channel::A, "c"), p, t1));
+}
+
+TEST_F(Test_nmea_ais_reassembler, timeout)
+{
+	nmea::ais_reassembler r{4, std::chrono::seconds{1}};
+	nmea::ais_reassembler::payload p;
+	const auto t0 = clock::now();
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a"), p, t0));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 2, nmea::ais_channel::A, "b"), p, t0));
+	EXPECT_EQ(0u, r.expire(t0 + std::chrono::milliseconds{500}));
+	EXPECT_EQ(2u, r.in_progress());
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a"), p,
+		t0 + std::chrono::milliseconds{1500}));
+	EXPECT_EQ(2u, r.get_counters().expired);
+	EXPECT_EQ(1u, r.get_counters().orphans);
+	EXPECT_EQ(0u, r.in_progress());
+}
+
+TEST_F(Test_nmea_ais_reassembler, reset)
+{
+	nmea::ais_reassembler r;
+	nmea::ais_reassembler::payload p;
+
+	EXPECT_FALSE(r.feed(make_fragment(2, 2, 1, nmea::ais_channel::A, "a"), p));
+	EXPECT_FALSE(r.feed(make_fragment(2, 1, 1, nmea::ais_channel::A, "a"), p));
+	r.reset();
+	EXPECT_EQ(0u, r.in_progress());
+	EXPECT_EQ(0u, r.get_counters().orphans);
+}
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/any_sentence.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <vector>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_any_sentence : public ::testing::Test
+{
+public:
+	struct count_types {
+		int mtw = 0;
+		int rmc = 0;
+		int other = 0;
+
+		void operator()(const nmea::mtw &) { ++mtw; }
+		void operator()(const nmea::rmc &) { ++rmc; }
+		template <class T> void operator()(const T &) { ++other; }
+	};
+
+	struct get_id {
+		template <class T> nmea::sentence_id operator()(const T &) const { return T::ID; }
+	};
+};
+
+TEST_F(Test_nmea_any_sentence, make_any_sentence)
+{
+	const auto s = nmea::make_any_sentence("$IIMTW,9.5,C*2F");
+	ASSERT_TRUE(utils::holds_alternative<nmea::mtw>(s));
+	EXPECT_EQ(9.5, *utils::get<nmea::mtw>(s).get_temperature());
+	EXPECT_EQ(nmea::sentence_id::MTW, nmea::as_sentence(s).id());
+	EXPECT_STREQ("$IIMTW,9.5,C*2F", nmea::to_string(s).c_str());
+}
+
+TEST_F(Test_nmea_any_sentence, make_any_sentence_with_tag_block)
+{
+	const std::string raw = "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\!AIVDM,"
+							"1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+	const auto s = nmea::make_any_sentence(raw.data(), raw.size());
+	ASSERT_TRUE(utils::holds_alternative<nmea::vdm>(s));
+	EXPECT_STREQ("g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A",
+		nmea::as_sentence(s).get_tag_block().c_str());
+}
+
+TEST_F(Test_nmea_any_sentence, make_any_sentence_invalid)
+{
+	EXPECT_THROW(nmea::make_any_sentence("$IIMTW,9.5,C*00"), nmea::checksum_error);
+	EXPECT_THROW(nmea::make_any_sentence("$IIXXX,9.5,C*2F", nmea::checksum_handling::ignore),
+		std::invalid_argument);
+}
+
+TEST_F(Test_nmea_any_sentence, try_make_any_sentence)
+{
+	auto s = nmea::try_make_any_sentence("$IIMTW,9.5,C*2F");
+	ASSERT_TRUE(s.has_value());
+	EXPECT_TRUE(utils::holds_alternative<nmea::mtw>(*s));
+
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch,
+		nmea::try_make_any_sentence("$IIMTW,9.5,C*00").error());
+	EXPECT_EQ(nmea::parse_error::invalid_data,
+		nmea::try_make_any_sentence("$IIMTW,9.5,C,1,2*2F", nmea::checksum_handling::ignore)
+			.error());
+}
+
+TEST_F(Test_nmea_any_sentence, same_as_make_sentence)
+{
+	static const std::vector<std::string> raw = {
+		"$GPAAM,A,A,0.5,N,POINT1*6E",
+		"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17",
+		"$GPGSV,3,1,09,07,29,138,44,08,22,099,42,09,30,273,44,11,07,057,35*75",
+		"$PGRMZ,1494,f,*10",
+		"$STALK,00,01,02,03,04,05*40",
+	};
+
+	for (const auto & t : raw) {
+		const auto s = nmea::make_any_sentence(t);
+		const auto p = nmea::make_sentence(t);
+		EXPECT_EQ(p->id(), utils::visit(get_id{}, s)) << t;
+		EXPECT_STREQ(nmea::to_string(*p).c_str(), nmea::to_string(s).c_str());
+	}
+}
+
+TEST_F(Test_nmea_any_sentence, contiguous_storage_and_visit)
+{
+	std::vector<nmea::any_sentence> v;
+	v.push_back(nmea::make_any_sentence("$IIMTW,9.5,C*2F"));
+	v.push_back(
+		nmea::make_any_sentence("$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,"
+								"0.6,E,A*17"));
+	v.push_back(nmea::make_any_sentence("$IIMTW,9.5,C*2F"));
+	v.push_back(nmea::make_any_sentence("$GPAAM,A,A,0.5,N,POINT1*6E"));
+
+	count_types counter;
+	for (const auto & s : v)
+		utils::visit(counter, s);
+	EXPECT_EQ(2, counter.mtw);
+	EXPECT_EQ(1, counter.rmc);
+	EXPECT_EQ(1, counter.other);
+}
+
+TEST_F(Test_nmea_any_sentence, modify_through_base)
+{
+	auto s = nmea::make_any_sentence("$IIMTW,9.5,C*2F");
+	nmea::as_sentence(s).set_talker(nmea::talker::global_positioning_system);
+	EXPECT_STREQ("$GPMTW,9.5,C*38", nmea::to_string(s).c_str());
+}
+
+TEST_F(Test_nmea_any_sentence, decode_sentence_reuses_variant)
+{
+	const std::string mtw = "$IIMTW,9.5,C*2F";
+	const std::string rmc
+		= "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+
+	nmea::any_sentence s;
+	EXPECT_EQ(nmea::parse_error::none, nmea::decode_sentence(mtw.data(), mtw.size(), s));
+	EXPECT_TRUE(utils::holds_alternative<nmea::mtw>(s));
+	EXPECT_EQ(nmea::parse_error::none, nmea::decode_sentence(rmc.data(), rmc.size(), s));
+	EXPECT_TRUE(utils::holds_alternative<nmea::rmc>(s));
+	EXPECT_STREQ(
+		nmea::to_string(*nmea::make_sentence(rmc)).c_str(), nmea::to_string(s).c_str());
+
+	EXPECT_EQ(nmea::parse_error::empty, nmea::decode_sentence(nullptr, 0u, s));
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch,
+		nmea::decode_sentence("$IIMTW,9.5,C*00", 15u, s));
+	EXPECT_EQ(nmea::parse_error::invalid_data,
+		nmea::decode_sentence("$IIMTW,9.5,C,1,2*2F", 19u, s, nmea::checksum_handling::ignore));
+}
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <marnav/nmea/checksum.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -30,4 +33,112 @@ TEST_F(Test_nmea_checksum, checksum_compute_sum)
 		EXPECT_EQ(test.sum, nmea::checksum(begin(test.s), end(test.s)));
 	}
 }
+
+TEST_F(Test_nmea_checksum, checksum_buffer_same_as_generic)
+{
+	std::string data;
+	for (int i = 0; i < 300; ++i)
+		data += static_cast<char>(' ' + (i * 37) % 95);
+
+	for (std::size_t offset = 0; offset < 40; ++offset) {
+		for (std::size_t n = 0; n + offset <= data.size(); ++n) {
+			const char * first = data.data() + offset;
+			ASSERT_EQ(nmea::checksum(begin(data) + offset, begin(data) + offset + n),
+				nmea::checksum(first, first + n))
+				<< "offset=" << offset << " n=" << n;
+		}
+	}
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_ok)
+{
+	const std::string s = "GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+	const auto r = nmea::scan_checksum(s.data(), s.data() + s.size());
+	EXPECT_EQ(nmea::checksum_scan::status::ok, r.result);
+	EXPECT_EQ(s.data() + s.size() - 3, r.end);
+	EXPECT_EQ(0x17u, r.expected);
+	EXPECT_EQ(0x17u, r.actual);
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_lower_case_hex)
+{
+	const std::string s = "GPXTE,A,A,0.67,L,N*6f";
+	const auto r = nmea::scan_checksum(s.data(), s.data() + s.size());
+	EXPECT_EQ(nmea::checksum_scan::status::ok, r.result);
+	EXPECT_EQ(0x6fu, r.expected);
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_mismatch)
+{
+	const std::string s = "GPXTE,A,A,0.67,L,N*00";
+	const auto r = nmea::scan_checksum(s.data(), s.data() + s.size());
+	EXPECT_EQ(nmea::checksum_scan::status::mismatch, r.result);
+	EXPECT_EQ(0x00u, r.expected);
+	EXPECT_EQ(0x6fu, r.actual);
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_errors)
+{
+	struct test_case {
+		nmea::checksum_scan::status result;
+		std::string s;
+	};
+
+	const std::vector<test_case> cases{
+		{nmea::checksum_scan::status::no_end_token, ""},
+		{nmea::checksum_scan::status::no_end_token, "GPXTE,A,A,0.67,L,N"},
+		{nmea::checksum_scan::status::no_end_token, "GPXTE,A,A,0.67,L,N,0123456789abcdef"},
+		{nmea::checksum_scan::status::invalid_format, "*"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*6"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*6F0"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*6G"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*x6"},
+		{nmea::checksum_scan::status::invalid_format, "GPXTE,A,A,0.67,L,N*6F*"},
+	};
+
+	for (auto const & test : cases) {
+		const auto r = nmea::scan_checksum(test.s.data(), test.s.data() + test.s.size());
+		EXPECT_EQ(test.result, r.result) << test.s;
+	}
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_end_token_at_all_positions)
+{
+	char buf[128];
+	for (std::size_t pos = 0; pos + 3 <= sizeof(buf); ++pos) {
+		for (std::size_t i = 0; i < pos; ++i)
+			buf[i] = static_cast<char>('A' + i % 26);
+		const uint8_t sum = nmea::checksum(buf, buf + pos);
+		const std::string cs = nmea::checksum_to_string(sum);
+		buf[pos] = '*';
+		std::memcpy(buf + pos + 1, cs.data(), 2);
+
+		const auto r = nmea::scan_checksum(buf, buf + pos + 3);
+		ASSERT_EQ(nmea::checksum_scan::status::ok, r.result) << "pos=" << pos;
+		EXPECT_EQ(buf + pos, r.end);
+		EXPECT_EQ(sum, r.actual);
+	}
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_end_token_last_in_range)
+{
+	// exact size heap buffer, nothing may be read beyond the end token
+	const std::string s = "GPHDT,1.0,T*";
+	const std::vector<char> buf(s.begin(), s.end());
+
+	const auto r = nmea::scan_checksum(buf.data(), buf.data() + buf.size());
+	EXPECT_EQ(nmea::checksum_scan::status::invalid_format, r.result);
+	EXPECT_EQ(buf.data() + buf.size() - 1, r.end);
+}
+
+TEST_F(Test_nmea_checksum, scan_checksum_checksum_beyond_range)
+{
+	// a valid checksum outside of the range is not considered
+	const std::string s = "GPHDT,123.4,T*31";
+	for (std::size_t n = s.size() - 2; n < s.size(); ++n) {
+		const auto r = nmea::scan_checksum(s.data(), s.data() + n);
+		EXPECT_EQ(nmea::checksum_scan::status::invalid_format, r.result) << "n=" << n;
+	}
+}
 }
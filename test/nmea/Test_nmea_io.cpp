@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <marnav/nmea/io.hpp>
 #include <marnav/nmea/angle.hpp>
+#include <marnav/nmea/string.hpp>
+#include <cmath>
+#include <cstdio>
 
 namespace
 {
@@ -70,4 +73,170 @@ TEST_F(Test_nmea_io, format_uint32_none)
 
 	EXPECT_STREQ("10", s.c_str());
 }
+
+TEST_F(Test_nmea_io, format_int32_negative_zero_padded)
+{
+	EXPECT_STREQ("-05", nmea::format(int32_t{-5}, 3).c_str());
+	EXPECT_STREQ("-5", nmea::format(int32_t{-5}, 0).c_str());
+	EXPECT_STREQ("-2147483648", nmea::format(int32_t{-2147483647 - 1}, 2).c_str());
+	EXPECT_STREQ("fffffff6", nmea::format(int32_t{-10}, 1, nmea::data_format::hex).c_str());
+}
+
+TEST_F(Test_nmea_io, format_unsigned_width)
+{
+	EXPECT_STREQ("0", nmea::format(uint32_t{0}, 0).c_str());
+	EXPECT_STREQ("007", nmea::format(uint32_t{7}, 3).c_str());
+	EXPECT_STREQ("0000000042", nmea::format(uint64_t{42}, 10).c_str());
+	EXPECT_STREQ(
+		"18446744073709551615", nmea::format(uint64_t{18446744073709551615u}, 1).c_str());
+	EXPECT_STREQ("0a", nmea::format(uint32_t{10}, 2, nmea::data_format::hex).c_str());
+}
+
+TEST_F(Test_nmea_io, format_width_too_large)
+{
+	EXPECT_ANY_THROW(nmea::format(uint32_t{0}, 32));
+	EXPECT_ANY_THROW(nmea::format(0.0, 32));
+}
+
+TEST_F(Test_nmea_io, format_double)
+{
+	EXPECT_STREQ("1", nmea::format(1.4, 0).c_str());
+	EXPECT_STREQ("12.3", nmea::format(12.34, 1).c_str());
+	EXPECT_STREQ("-0.0", nmea::format(-0.04, 1).c_str());
+	EXPECT_STREQ("0.12", nmea::format(0.125, 2).c_str());
+	EXPECT_STREQ("0.38", nmea::format(0.375, 2).c_str());
+	EXPECT_STREQ("1.00", nmea::format(1.005, 2).c_str());
+	EXPECT_STREQ("2.67", nmea::format(2.675, 2).c_str());
+	EXPECT_STREQ("-2.67", nmea::format(-2.675, 2).c_str());
+	EXPECT_STREQ("1.01", nmea::format(1.015, 2).c_str());
+	EXPECT_STREQ("0.1", nmea::format(0.15, 1).c_str());
+	EXPECT_STREQ("0.2", nmea::format(0.25, 1).c_str());
+	EXPECT_STREQ("2", nmea::format(2.5, 0).c_str());
+	EXPECT_STREQ("4", nmea::format(3.5, 0).c_str());
+	EXPECT_STREQ("inf", nmea::format(HUGE_VAL, 2).c_str());
+}
+
+TEST_F(Test_nmea_io, format_double_same_as_printf)
+{
+	char expected[512];
+	for (unsigned int width = 0; width < 8; ++width) {
+		char fmt[8];
+		snprintf(fmt, sizeof(fmt), "%%.%uf", width);
+		for (int i = -5000; i <= 5000; ++i) {
+			const double value = i * 0.0125 + 1.0 / 3.0;
+			snprintf(expected, sizeof(expected), fmt, value);
+			EXPECT_STREQ(expected, nmea::format(value, width).c_str())
+				<< "value=" << value << ", width=" << width;
+		}
+		for (double value : {1.0e16, -3.0e20, 123456789012.5, 0.5, 1.5, 2.5, -2.5, 2.675,
+				 1.005, 1.015, 0.045, 8.345, 4503599627370495.5, 1.0e-300}) {
+			snprintf(expected, sizeof(expected), fmt, value);
+			EXPECT_STREQ(expected, nmea::format(value, width).c_str())
+				<< "value=" << value << ", width=" << width;
+		}
+	}
+}
+
+TEST_F(Test_nmea_io, format_double_halfway_cases_same_as_printf)
+{
+	// decimal halfway cases, which are mostly not exactly representable
+	char expected[512];
+	for (unsigned int width = 1; width < 6; ++width) {
+		char fmt[8];
+		snprintf(fmt, sizeof(fmt), "%%.%uf", width);
+		const double half = 0.5 / std::pow(10.0, width);
+		for (int i = -20000; i <= 20000; ++i) {
+			const double value = i / std::pow(10.0, width) + half;
+			snprintf(expected, sizeof(expected), fmt, value);
+			EXPECT_STREQ(expected, nmea::format(value, width).c_str())
+				<< "value=" << value << ", width=" << width;
+		}
+	}
+}
+
+TEST_F(Test_nmea_io, format_to_buffer_too_small)
+{
+	char buf[4];
+	EXPECT_EQ(nullptr, nmea::format_to(buf, buf + sizeof(buf), uint32_t{12345}, 1));
+	EXPECT_EQ(nullptr, nmea::format_to(buf, buf + sizeof(buf), uint32_t{1}, 5));
+	EXPECT_EQ(nullptr, nmea::format_to(buf, buf + sizeof(buf), int32_t{-1234}, 1));
+	EXPECT_EQ(nullptr, nmea::format_to(buf, buf + sizeof(buf), 12.34, 2));
+	EXPECT_EQ(nullptr, nmea::format_to(buf, buf, 0.0, 0));
+}
+
+TEST_F(Test_nmea_io, format_to)
+{
+	char buf[16];
+	char * p = nmea::format_to(buf, buf + sizeof(buf), uint32_t{12}, 3);
+	p = nmea::format_to(p, buf + sizeof(buf), 4.56, 1);
+	ASSERT_NE(nullptr, p);
+	EXPECT_EQ("0124.6", std::string(buf, p));
+}
+
+TEST_F(Test_nmea_io, format_to_nullptr)
+{
+	char buf[16];
+	EXPECT_EQ(nullptr, nmea::format_to(nullptr, buf + sizeof(buf), uint32_t{12}, 3));
+	EXPECT_EQ(nullptr, nmea::format_to(nullptr, buf + sizeof(buf), int32_t{-12}, 3));
+	EXPECT_EQ(nullptr, nmea::format_to(nullptr, buf + sizeof(buf), 4.56, 1));
+	EXPECT_EQ(nullptr, nmea::to_chars(nullptr, buf + sizeof(buf), 'A'));
+	EXPECT_EQ(nullptr, nmea::to_chars(nullptr, buf + sizeof(buf), std::string{"abc"}));
+}
+
+TEST_F(Test_nmea_io, to_chars)
+{
+	char buf[64];
+	const auto e = buf + sizeof(buf);
+	char * p = nmea::to_chars(buf, e, geo::latitude{12.5});
+	p = nmea::to_chars(p, e, nmea::direction::north);
+	p = nmea::to_chars(p, e, geo::longitude{-3.25});
+	p = nmea::to_chars(p, e, utils::optional<double>{});
+	p = nmea::to_chars(p, e, utils::optional<double>{0.125});
+	p = nmea::to_chars(p, e, '\0');
+	p = nmea::to_chars(p, e, nmea::unit::distance::meter);
+	p = nmea::to_chars(p, e, uint32_t{42});
+	p = nmea::to_chars(p, e, int32_t{-7});
+	ASSERT_NE(nullptr, p);
+	const std::string expected = nmea::to_string(geo::latitude{12.5}) + "N"
+		+ nmea::to_string(geo::longitude{-3.25}) + "0.125M42-7";
+	EXPECT_EQ(expected, std::string(buf, p));
+}
+
+TEST_F(Test_nmea_io, to_chars_buffer_too_small)
+{
+	char buf[4];
+	const auto e = buf + sizeof(buf);
+	EXPECT_EQ(nullptr, nmea::to_chars(buf, e, geo::latitude{12.5}));
+	EXPECT_EQ(nullptr, nmea::to_chars(buf, e, 123.25));
+	EXPECT_EQ(nullptr, nmea::to_chars(buf, e, 1.0e-9));
+	EXPECT_EQ(nullptr, nmea::to_chars(buf, e, std::string{"abcde"}));
+	EXPECT_EQ(nullptr, nmea::to_chars(buf, buf, 'A'));
+	EXPECT_EQ(buf, nmea::to_chars(buf, buf, utils::optional<double>{}));
+}
+
+TEST_F(Test_nmea_io, to_chars_double_same_as_to_string)
+{
+	char buf[32];
+	for (double value : {0.0, -0.0, 1.0e-9, 0.0001, 1.0 / 3.0, -12.5, 999999.4, 1.0e7}) {
+		char * p = nmea::to_chars(buf, buf + sizeof(buf), value);
+		ASSERT_NE(nullptr, p);
+		EXPECT_EQ(nmea::to_string(value), std::string(buf, p)) << "value=" << value;
+	}
+}
+
+TEST_F(Test_nmea_io, to_string_double_same_as_printf)
+{
+	char expected[64];
+	for (double scale : {1.0e-6, 1.0e-4, 1.0e-2, 1.0, 1.0e2, 1.0e4, 1.0e6}) {
+		for (int i = -5000; i <= 5000; ++i) {
+			const double value = (i * 0.0125 + 1.0 / 3.0) * scale;
+			snprintf(expected, sizeof(expected), "%g", value);
+			EXPECT_STREQ(expected, nmea::to_string(value).c_str()) << "value=" << value;
+		}
+	}
+	for (double value : {0.0, -0.0, 0.0001, 0.001, 999999.4, 999999.5, 9.999995, 0.1, 100.0}) {
+		snprintf(expected, sizeof(expected), "%g", value);
+		EXPECT_STREQ(expected, nmea::to_string(value).c_str()) << "value=" << value;
+	}
+}
 }
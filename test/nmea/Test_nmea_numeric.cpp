@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/numeric.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_numeric : public ::testing::Test
+{
+public:
+	template <class F> static auto parse(F f, const char * s) -> decltype(f(s, s))
+	{
+		return f(s, s + std::strlen(s));
+	}
+
+	static utils::expected<uint64_t, nmea::numeric_error> parse_unsigned(
+		const char * s, nmea::data_format fmt = nmea::data_format::dec)
+	{
+		return nmea::parse_unsigned(s, s + std::strlen(s), fmt);
+	}
+
+	static utils::expected<int64_t, nmea::numeric_error> parse_signed(
+		const char * s, nmea::data_format fmt = nmea::data_format::dec)
+	{
+		return nmea::parse_signed(s, s + std::strlen(s), fmt);
+	}
+
+	static utils::expected<double, nmea::numeric_error> parse_decimal(const char * s)
+	{
+		return nmea::parse_decimal(s, s + std::strlen(s));
+	}
+};
+
+TEST_F(Test_nmea_numeric, parse_unsigned)
+{
+	EXPECT_EQ(0u, *parse_unsigned("0"));
+	EXPECT_EQ(123u, *parse_unsigned("123"));
+	EXPECT_EQ(123u, *parse_unsigned("000123"));
+	EXPECT_EQ(18446744073709551615u, *parse_unsigned("18446744073709551615"));
+	EXPECT_EQ(0xabcdu, *parse_unsigned("abcd", nmea::data_format::hex));
+	EXPECT_EQ(0xabcdu, *parse_unsigned("ABCD", nmea::data_format::hex));
+}
+
+TEST_F(Test_nmea_numeric, parse_unsigned_errors)
+{
+	EXPECT_EQ(nmea::numeric_error::empty, parse_unsigned("").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_unsigned("12a").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_unsigned(" 12").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_unsigned("-1").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_unsigned("1.0").error());
+	EXPECT_EQ(
+		nmea::numeric_error::out_of_range, parse_unsigned("18446744073709551616").error());
+	EXPECT_EQ(nmea::numeric_error::out_of_range,
+		parse_unsigned("10000000000000000", nmea::data_format::hex).error());
+}
+
+TEST_F(Test_nmea_numeric, parse_signed)
+{
+	EXPECT_EQ(-123, *parse_signed("-123"));
+	EXPECT_EQ(123, *parse_signed("+123"));
+	EXPECT_EQ(123, *parse_signed("123"));
+	EXPECT_EQ(-0xabc, *parse_signed("-abc", nmea::data_format::hex));
+	EXPECT_EQ(INT64_MIN, *parse_signed("-9223372036854775808"));
+	EXPECT_EQ(INT64_MAX, *parse_signed("9223372036854775807"));
+}
+
+TEST_F(Test_nmea_numeric, parse_signed_errors)
+{
+	EXPECT_EQ(nmea::numeric_error::empty, parse_signed("").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_signed("-").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_signed("--1").error());
+	EXPECT_EQ(nmea::numeric_error::out_of_range, parse_signed("9223372036854775808").error());
+	EXPECT_EQ(nmea::numeric_error::out_of_range, parse_signed("-9223372036854775809").error());
+}
+
+TEST_F(Test_nmea_numeric, parse_decimal)
+{
+	EXPECT_EQ(1.5, *parse_decimal("1.5"));
+	EXPECT_EQ(-1.5, *parse_decimal("-1.5"));
+	EXPECT_EQ(1.5, *parse_decimal("+1.5"));
+	EXPECT_EQ(0.5, *parse_decimal(".5"));
+	EXPECT_EQ(5.0, *parse_decimal("5."));
+	EXPECT_EQ(123.0, *parse_decimal("123"));
+	EXPECT_TRUE(std::signbit(*parse_decimal("-0.0")));
+}
+
+TEST_F(Test_nmea_numeric, parse_decimal_errors)
+{
+	EXPECT_EQ(nmea::numeric_error::empty, parse_decimal("").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal(".").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal("-").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal("1.2.3").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal("1e3").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal("1,5").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal("inf").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse_decimal(" 1").error());
+}
+
+TEST_F(Test_nmea_numeric, parse_decimal_same_as_strtod)
+{
+	char buf[64];
+	for (unsigned int width = 0; width < 10; ++width) {
+		for (int i = -3000; i <= 3000; ++i) {
+			const double value = i * 3.0517578125e-3 * (1 << width) + 1.0 / 7.0;
+			snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(width), value);
+			const auto t = parse_decimal(buf);
+			ASSERT_TRUE(t.has_value()) << buf;
+			EXPECT_EQ(std::strtod(buf, nullptr), *t) << buf;
+		}
+	}
+	for (const char * s : {"4807.038", "01131.000", "0.000000000000000000001",
+			 "123456789012345", "1234567890123456789012345", "0.1234567890123456789"}) {
+		EXPECT_DOUBLE_EQ(std::strtod(s, nullptr), *parse_decimal(s)) << s;
+	}
+}
+
+TEST_F(Test_nmea_numeric, parse_degrees_minutes)
+{
+	EXPECT_NEAR(48.1173, *parse(nmea::parse_degrees_minutes, "4807.038"), 1.0e-9);
+	EXPECT_NEAR(11.516666666, *parse(nmea::parse_degrees_minutes, "01131.000"), 1.0e-9);
+	EXPECT_NEAR(0.5, *parse(nmea::parse_degrees_minutes, "30"), 1.0e-9);
+	EXPECT_EQ(nmea::numeric_error::out_of_range,
+		parse(nmea::parse_degrees_minutes, "4860.0").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format,
+		parse(nmea::parse_degrees_minutes, "48O7.0").error());
+	EXPECT_EQ(nmea::numeric_error::empty, parse(nmea::parse_degrees_minutes, "").error());
+}
+
+TEST_F(Test_nmea_numeric, parse_hhmmss)
+{
+	{
+		const auto t = parse(nmea::parse_hhmmss, "123519");
+		ASSERT_TRUE(t.has_value());
+		EXPECT_EQ(12u, t->hour);
+		EXPECT_EQ(35u, t->minutes);
+		EXPECT_EQ(19u, t->seconds);
+		EXPECT_EQ(0u, t->milliseconds);
+	}
+	{
+		const auto t = parse(nmea::parse_hhmmss, "123519.123");
+		ASSERT_TRUE(t.has_value());
+		EXPECT_EQ(123u, t->milliseconds);
+	}
+	{
+		const auto t = parse(nmea::parse_hhmmss, "93519.5");
+		ASSERT_TRUE(t.has_value());
+		EXPECT_EQ(9u, t->hour);
+		EXPECT_EQ(500u, t->milliseconds);
+	}
+	{
+		const auto t = parse(nmea::parse_hhmmss, "000001.0019");
+		ASSERT_TRUE(t.has_value());
+		EXPECT_EQ(1u, t->seconds);
+		EXPECT_EQ(1u, t->milliseconds);
+	}
+}
+
+TEST_F(Test_nmea_numeric, parse_hhmmss_errors)
+{
+	EXPECT_EQ(nmea::numeric_error::empty, parse(nmea::parse_hhmmss, "").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse(nmea::parse_hhmmss, ".5").error());
+	EXPECT_EQ(nmea::numeric_error::invalid_format, parse(nmea::parse_hhmmss, "-12").error());
+	EXPECT_EQ(
+		nmea::numeric_error::invalid_format, parse(nmea::parse_hhmmss, "123.455.6").error());
+	EXPECT_EQ(nmea::numeric_error::out_of_range, parse(nmea::parse_hhmmss, "1234567").error());
+}
+
+TEST_F(Test_nmea_numeric, to_string)
+{
+	EXPECT_STREQ("none", nmea::to_string(nmea::numeric_error::none).c_str());
+	EXPECT_STREQ("out of range", nmea::to_string(nmea::numeric_error::out_of_range).c_str());
+}
+}
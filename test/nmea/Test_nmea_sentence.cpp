@@ -2,6 +2,7 @@
 #include <marnav/nmea/sentence.hpp>
 #include <marnav/nmea/mtw.hpp>
 #include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/nmea.hpp>
 
 namespace
 {
@@ -26,4 +27,66 @@ TEST_F(Test_nmea_sentence, sentence_wrong_id)
 
 	EXPECT_ANY_THROW(nmea::sentence_cast<nmea::mtw>(p));
 }
+
+TEST_F(Test_nmea_sentence, write_to_same_as_to_string)
+{
+	static const std::vector<std::string> texts = {
+		"$GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E",
+		"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+		"$GPGLL,3553.5295,N,13938.6570,E,002454,A,A*4F",
+		"$GPZDA,050306,29,10,2003,,*43",
+		"$CDDSC,20,3380210040,00,21,26,1394807410,2242,,,B,E*71",
+		"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C",
+		"$PGRME,22.0,M,52.9,M,51.0,M*14",
+		"$GPRMC,,V,,,,,,,,,,N*53",
+		"$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*25",
+		"$HEHDT,123.4,T*2B",
+		"!AIVDO,1,1,,,B>qc:003wk?8mP=18D3Q3wgTiT;T,0*13",
+		"\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\"
+		"!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13",
+	};
+
+	for (const auto & text : texts) {
+		const auto s = nmea::make_sentence(text);
+		const auto expected = nmea::to_string(*s);
+
+		char buf[256];
+		const auto n = s->write_to(buf, sizeof(buf));
+		EXPECT_EQ(expected, std::string(buf, n));
+		EXPECT_NO_THROW(nmea::make_sentence(expected));
+	}
+}
+
+TEST_F(Test_nmea_sentence, write_to_buffer_too_small)
+{
+	const auto s = nmea::make_sentence("$IIMTW,9.5,C*2F");
+
+	char buf[16];
+	EXPECT_EQ(0u, s->write_to(buf, 14));
+	EXPECT_EQ(0u, s->write_to(nullptr, 0));
+	EXPECT_EQ(15u, s->write_to(buf, 15));
+	EXPECT_EQ("$IIMTW,9.5,C*2F", std::string(buf, 15));
+}
+
+TEST_F(Test_nmea_sentence, write_to_buffer_too_small_direct)
+{
+	// sentences rendering their fields directly into the buffer
+	static const std::vector<std::string> texts = {
+		"$GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E",
+		"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+		"$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*25",
+		"$HEHDT,123.4,T*2B",
+		"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C",
+	};
+
+	for (const auto & text : texts) {
+		const auto s = nmea::make_sentence(text);
+		const auto expected = nmea::to_string(*s);
+
+		char buf[256];
+		for (std::size_t size = 0; size < expected.size(); ++size)
+			EXPECT_EQ(0u, s->write_to(buf, size)) << text << ", size=" << size;
+		EXPECT_EQ(expected.size(), s->write_to(buf, expected.size())) << text;
+	}
+}
 }
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/sentence_arena.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/mtw.hpp>
+#include <marnav/nmea/vdm.hpp>
+#include <cstdint>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_sentence_arena : public ::testing::Test
+{
+public:
+	static const std::vector<std::string> batch;
+};
+
+const std::vector<std::string> Test_nmea_sentence_arena::batch = {
+	"$IIMTW,9.5,C*2F",
+	"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17",
+	"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C",
+	"\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\$IIMTW,9.5,C*2F",
+};
+
+TEST_F(Test_nmea_sentence_arena, construction_invalid_block_size)
+{
+	EXPECT_ANY_THROW(nmea::sentence_arena(0));
+}
+
+TEST_F(Test_nmea_sentence_arena, empty)
+{
+	nmea::sentence_arena arena;
+	EXPECT_EQ(0u, arena.size());
+	EXPECT_EQ(0u, arena.capacity());
+}
+
+TEST_F(Test_nmea_sentence_arena, make_sentence)
+{
+	nmea::sentence_arena arena;
+
+	auto s = nmea::make_sentence(arena, batch[0]);
+	ASSERT_NE(nullptr, s);
+	EXPECT_EQ(nmea::sentence_id::MTW, s->id());
+	EXPECT_EQ(1u, arena.size());
+
+	auto mtw = nmea::sentence_cast<nmea::mtw>(s);
+	ASSERT_NE(nullptr, mtw);
+	EXPECT_EQ(9.5, *mtw->get_temperature());
+	EXPECT_STREQ(batch[0].c_str(), nmea::to_string(*s).c_str());
+}
+
+TEST_F(Test_nmea_sentence_arena, make_sentence_all_of_batch)
+{
+	nmea::sentence_arena arena;
+
+	std::vector<nmea::sentence *> v;
+	for (const auto & raw : batch)
+		v.push_back(nmea::make_sentence(arena, raw.data(), raw.size()));
+	EXPECT_EQ(batch.size(), arena.size());
+
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		ASSERT_NE(nullptr, v[i]);
+		EXPECT_STREQ(nmea::to_string(*nmea::make_sentence(batch[i])).c_str(),
+			nmea::to_string(*v[i]).c_str());
+	}
+	EXPECT_FALSE(v[3]->get_tag_block().empty());
+}
+
+TEST_F(Test_nmea_sentence_arena, make_sentence_invalid)
+{
+	nmea::sentence_arena arena;
+
+	EXPECT_THROW(nmea::make_sentence(arena, "$IIMTW,9.5,C*00"), nmea::checksum_error);
+	EXPECT_THROW(nmea::make_sentence(arena, "$IIMTW,9.5,C"), std::invalid_argument);
+	EXPECT_THROW(
+		nmea::make_sentence(arena, "$IIMTW,9.5,C,1,2*2F", nmea::checksum_handling::ignore),
+		std::invalid_argument);
+	EXPECT_EQ(0u, arena.size());
+}
+
+TEST_F(Test_nmea_sentence_arena, try_make_sentence)
+{
+	nmea::sentence_arena arena;
+
+	auto s = nmea::try_make_sentence(arena, batch[0]);
+	ASSERT_TRUE(s.has_value());
+	EXPECT_EQ(nmea::sentence_id::MTW, (*s)->id());
+
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch,
+		nmea::try_make_sentence(arena, "$IIMTW,9.5,C*00").error());
+	EXPECT_EQ(nmea::parse_error::invalid_data,
+		nmea::try_make_sentence(arena, "$IIMTW,9.5,C,1,2*2F", nmea::checksum_handling::ignore)
+			.error());
+	EXPECT_EQ(1u, arena.size());
+}
+
+TEST_F(Test_nmea_sentence_arena, alignment)
+{
+	nmea::sentence_arena arena{100};
+
+	for (int i = 0; i < 50; ++i) {
+		for (const auto & raw : batch) {
+			auto s = nmea::make_sentence(arena, raw);
+			EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(s) % alignof(nmea::sentence));
+		}
+	}
+}
+
+TEST_F(Test_nmea_sentence_arena, reset_reuses_memory)
+{
+	nmea::sentence_arena arena{1024};
+
+	const nmea::sentence * first = nullptr;
+	std::size_t capacity = 0u;
+	for (int n = 0; n < 3; ++n) {
+		for (int i = 0; i < 100; ++i) {
+			for (const auto & raw : batch) {
+				auto s = nmea::make_sentence(arena, raw);
+				if (!first)
+					first = s;
+				if ((i == 0) && (&raw == &batch.front())) {
+					EXPECT_EQ(first, s);
+				}
+			}
+		}
+		EXPECT_EQ(100u * batch.size(), arena.size());
+		if (n == 0)
+			capacity = arena.capacity();
+		EXPECT_EQ(capacity, arena.capacity());
+		arena.reset();
+		EXPECT_EQ(0u, arena.size());
+	}
+	EXPECT_LT(0u, capacity);
+}
+
+TEST_F(Test_nmea_sentence_arena, sentences_larger_than_block)
+{
+	nmea::sentence_arena arena{16};
+
+	auto s0 = nmea::make_sentence(arena, batch[2]);
+	auto s1 = nmea::make_sentence(arena, batch[2]);
+	EXPECT_NE(s0, s1);
+	EXPECT_STREQ(nmea::to_string(*s0).c_str(), nmea::to_string(*s1).c_str());
+	EXPECT_EQ(2u, arena.size());
+
+	auto vdm = nmea::sentence_cast<nmea::vdm>(s1);
+	ASSERT_NE(nullptr, vdm);
+	EXPECT_STREQ("177KQJ5000G?tO`K>RA1wUbN0TKH", vdm->get_payload().c_str());
+}
+}
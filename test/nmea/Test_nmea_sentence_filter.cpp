@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/sentence_filter.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_sentence_filter : public ::testing::Test
+{
+public:
+	static const std::string gsv;
+	static const std::string gga;
+	static const std::string vdm;
+	static const std::string pgrme;
+};
+
+const std::string Test_nmea_sentence_filter::gsv
+	= "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74";
+const std::string Test_nmea_sentence_filter::gga
+	= "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+const std::string Test_nmea_sentence_filter::vdm
+	= "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\!AIVDM,"
+	  "1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13";
+const std::string Test_nmea_sentence_filter::pgrme = "$PGRME,15.0,M,45.0,M,25.0,M*1C";
+
+TEST_F(Test_nmea_sentence_filter, default_accepts_nothing)
+{
+	const nmea::sentence_filter f;
+	EXPECT_FALSE(f.accepts(gsv));
+	EXPECT_FALSE(f.accepts(gga));
+	EXPECT_FALSE(f.accepts(nmea::sentence_id::GGA, nmea::talker::global_positioning_system));
+}
+
+TEST_F(Test_nmea_sentence_filter, all)
+{
+	const auto f = nmea::sentence_filter::all();
+	EXPECT_TRUE(f.accepts(gsv));
+	EXPECT_TRUE(f.accepts(gga));
+	EXPECT_TRUE(f.accepts(vdm));
+	EXPECT_TRUE(f.accepts(pgrme));
+}
+
+TEST_F(Test_nmea_sentence_filter, accept_list)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::GGA, nmea::sentence_id::VDM};
+	EXPECT_FALSE(f.accepts(gsv));
+	EXPECT_TRUE(f.accepts(gga));
+	EXPECT_TRUE(f.accepts(vdm));
+	EXPECT_FALSE(f.accepts(pgrme));
+}
+
+TEST_F(Test_nmea_sentence_filter, reject)
+{
+	const auto f = nmea::sentence_filter::all()
+					   .reject(nmea::sentence_id::GSV)
+					   .reject(nmea::sentence_id::GSA);
+	EXPECT_FALSE(f.accepts(gsv));
+	EXPECT_TRUE(f.accepts(gga));
+	EXPECT_FALSE(f.accepts("$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39"));
+}
+
+TEST_F(Test_nmea_sentence_filter, talker)
+{
+	const std::string gngga
+		= "$GNGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*59";
+
+	nmea::sentence_filter f;
+	f.accept(nmea::sentence_id::GGA, nmea::talker::global_positioning_system);
+	EXPECT_TRUE(f.accepts(gga));
+	EXPECT_FALSE(f.accepts(gngga));
+
+	f.accept(nmea::sentence_id::GGA);
+	f.reject(nmea::sentence_id::GGA, nmea::talker::global_positioning_system);
+	EXPECT_FALSE(f.accepts(gga));
+	EXPECT_TRUE(f.accepts(gngga));
+}
+
+TEST_F(Test_nmea_sentence_filter, vendor_extension)
+{
+	nmea::sentence_filter f;
+	f.accept(nmea::sentence_id::PGRME, nmea::talker::none);
+	EXPECT_TRUE(f.accepts(pgrme));
+}
+
+TEST_F(Test_nmea_sentence_filter, malformed_or_unknown)
+{
+	const auto f = nmea::sentence_filter::all();
+	EXPECT_FALSE(f.accepts(nullptr, 0u));
+	EXPECT_FALSE(f.accepts(""));
+	EXPECT_FALSE(f.accepts("$"));
+	EXPECT_FALSE(f.accepts("GPGGA,1,2*00"));
+	EXPECT_FALSE(f.accepts("$GPGGA"));
+	EXPECT_FALSE(f.accepts("$GPXYZ,1,2*00"));
+	EXPECT_FALSE(f.accepts("$GPGGAX,1,2*00"));
+	EXPECT_FALSE(f.accepts("\\g:1-2-73874*4A\\$GPXYZ,1,2*00"));
+}
+
+TEST_F(Test_nmea_sentence_filter, checksum_not_verified)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::GGA};
+	EXPECT_TRUE(f.accepts("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*00"));
+}
+
+TEST_F(Test_nmea_sentence_filter, invalid_sentence_id)
+{
+	nmea::sentence_filter f;
+	EXPECT_ANY_THROW(f.accept(static_cast<nmea::sentence_id>(-1)));
+	EXPECT_FALSE(
+		f.accepts(static_cast<nmea::sentence_id>(-1), nmea::talker::global_positioning_system));
+}
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/sentence_view.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/convert.hpp>
+#include <marnav/nmea/gga.hpp>
+#include <marnav/nmea/gll.hpp>
+#include <marnav/nmea/gns.hpp>
+#include <marnav/nmea/hdt.hpp>
+#include <marnav/nmea/rmc.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_sentence_view : public ::testing::Test
+{
+public:
+	static const std::string gga;
+	static const std::string hdt;
+};
+
+const std::string Test_nmea_sentence_view::gga
+	= "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+
+const std::string Test_nmea_sentence_view::hdt = "$GPHDT,123.4,T*31";
+
+TEST_F(Test_nmea_sentence_view, empty)
+{
+	nmea::sentence_view v;
+	EXPECT_EQ(nmea::sentence_id::NONE, v.id());
+	EXPECT_EQ(0u, v.size());
+	EXPECT_THROW(v.get_field(0), std::out_of_range);
+}
+
+TEST_F(Test_nmea_sentence_view, make_sentence_view)
+{
+	const auto v = nmea::make_sentence_view(hdt);
+	EXPECT_EQ(nmea::sentence_id::HDT, v.id());
+	EXPECT_EQ(nmea::talker::global_positioning_system, v.get_talker());
+	EXPECT_TRUE(v.get_tag_block().empty());
+	ASSERT_EQ(2u, v.size());
+	EXPECT_STREQ("123.4", v.get_field(0).c_str());
+	EXPECT_STREQ("T", v.get_field(1).c_str());
+	EXPECT_THROW(v.get_field(2), std::out_of_range);
+}
+
+TEST_F(Test_nmea_sentence_view, read_fields)
+{
+	const auto v = nmea::make_sentence_view(gga);
+	ASSERT_EQ(14u, v.size());
+
+	utils::optional<double> altitude;
+	v.read(8, altitude);
+	ASSERT_TRUE(altitude.available());
+	EXPECT_EQ(545.4, *altitude);
+
+	uint32_t n_satellites = 0;
+	v.read(6, n_satellites);
+	EXPECT_EQ(8u, n_satellites);
+
+	nmea::quality q;
+	v.read(5, q);
+	EXPECT_EQ(nmea::quality::gps_fix, q);
+
+	utils::optional<double> dgps_age;
+	EXPECT_TRUE(v.is_empty(12));
+	v.read(12, dgps_age);
+	EXPECT_FALSE(dgps_age.available());
+}
+
+TEST_F(Test_nmea_sentence_view, read_same_as_sentence)
+{
+	const auto v = nmea::make_sentence_view(gga);
+	const auto s = nmea::sentence_cast<nmea::gga>(nmea::make_sentence(gga));
+
+	utils::optional<geo::latitude> lat;
+	utils::optional<nmea::direction> hem;
+	v.read(1, lat);
+	v.read(2, hem);
+	EXPECT_EQ(nmea::direction::north, *hem);
+	EXPECT_EQ(*s->get_latitude(), nmea::correct_hemisphere(*lat, *hem));
+
+	utils::optional<double> altitude;
+	v.read(8, altitude);
+	EXPECT_EQ(*s->get_altitude(), *altitude);
+}
+
+TEST_F(Test_nmea_sentence_view, read_invalid_field)
+{
+	const std::string raw = "$GPHDT,abc,T*7B";
+	const auto v = nmea::make_sentence_view(raw);
+
+	double heading = 0.0;
+	EXPECT_ANY_THROW(v.read(0, heading));
+	EXPECT_THROW(v.read(2, heading), std::out_of_range);
+}
+
+TEST_F(Test_nmea_sentence_view, as)
+{
+	const auto v = nmea::make_sentence_view(hdt);
+
+	auto s = v.as<nmea::hdt>();
+	ASSERT_NE(nullptr, s);
+	EXPECT_EQ(123.4, *s->get_heading());
+	EXPECT_STREQ(hdt.c_str(), nmea::to_string(*s).c_str());
+
+	EXPECT_THROW(v.as<nmea::gga>(), std::invalid_argument);
+}
+
+TEST_F(Test_nmea_sentence_view, tag_block)
+{
+	const std::string raw
+		= "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\$GPHDT,123.4,T*31";
+	const auto v = nmea::make_sentence_view(raw);
+
+	EXPECT_EQ(nmea::sentence_id::HDT, v.id());
+	EXPECT_STREQ("g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A",
+		v.get_tag_block().c_str());
+	EXPECT_STREQ("123.4", v.get_field(0).c_str());
+	EXPECT_STREQ(v.get_tag_block().c_str(), v.as<nmea::hdt>()->get_tag_block().c_str());
+}
+
+TEST_F(Test_nmea_sentence_view, invalid_sentences)
+{
+	EXPECT_THROW(nmea::make_sentence_view("$GPHDT,123.4,T*00", 17u), nmea::checksum_error);
+	EXPECT_THROW(nmea::make_sentence_view("GPHDT,123.4,T*31", 16u), std::invalid_argument);
+	EXPECT_THROW(nmea::make_sentence_view("$GPXYZ,123.4,T*00", 17u,
+					 nmea::checksum_handling::ignore),
+		std::invalid_argument);
+
+	const std::string too_long(70000u, '$');
+	EXPECT_THROW(nmea::make_sentence_view(too_long), std::invalid_argument);
+	EXPECT_EQ(nmea::parse_error::malformed, nmea::try_make_sentence_view(too_long).error());
+}
+
+TEST_F(Test_nmea_sentence_view, try_make_sentence_view)
+{
+	EXPECT_TRUE(nmea::try_make_sentence_view(hdt).has_value());
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch,
+		nmea::try_make_sentence_view("$GPHDT,123.4,T*00", 17u).error());
+	EXPECT_EQ(nmea::parse_error::unknown_sentence,
+		nmea::try_make_sentence_view("$GPXYZ,123.4,T*00", 17u, nmea::checksum_handling::ignore)
+			.error());
+	EXPECT_EQ(nmea::parse_error::empty, nmea::try_make_sentence_view(nullptr, 0u).error());
+
+	// the content of the fields is not checked
+	const std::string raw = "$GPHDT,abc,T*7B";
+	EXPECT_TRUE(nmea::try_make_sentence_view(raw).has_value());
+	EXPECT_FALSE(nmea::try_make_sentence(raw).has_value());
+}
+
+TEST_F(Test_nmea_sentence_view, position_gga)
+{
+	const auto v = nmea::make_sentence_view(gga);
+	const auto s = v.as<nmea::gga>();
+	EXPECT_TRUE(v.has_position());
+	ASSERT_TRUE(v.get_latitude().available());
+	ASSERT_TRUE(v.get_longitude().available());
+	ASSERT_TRUE(v.get_time_utc().available());
+	EXPECT_EQ(*s->get_latitude(), *v.get_latitude());
+	EXPECT_EQ(*s->get_longitude(), *v.get_longitude());
+	EXPECT_EQ(nmea::to_string(*s->get_time()), nmea::to_string(*v.get_time_utc()));
+	EXPECT_THROW(v.get_date(), std::invalid_argument);
+}
+
+TEST_F(Test_nmea_sentence_view, position_rmc)
+{
+	const std::string raw
+		= "$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68";
+	const auto v = nmea::make_sentence_view(raw);
+	const auto s = v.as<nmea::rmc>();
+	EXPECT_TRUE(v.has_position());
+	EXPECT_EQ(*s->get_latitude(), *v.get_latitude());
+	EXPECT_EQ(*s->get_longitude(), *v.get_longitude());
+	EXPECT_GT(0.0, v.get_longitude()->get());
+	EXPECT_EQ(nmea::to_string(*s->get_time_utc()), nmea::to_string(*v.get_time_utc()));
+	ASSERT_TRUE(v.get_date().available());
+	EXPECT_EQ(*s->get_date(), *v.get_date());
+}
+
+TEST_F(Test_nmea_sentence_view, position_gll)
+{
+	const std::string raw = "$GPGLL,4916.45,S,12311.12,W,225444,A*2C";
+	const auto v = nmea::make_sentence_view(raw);
+	const auto s = v.as<nmea::gll>();
+	EXPECT_EQ(*s->get_latitude(), *v.get_latitude());
+	EXPECT_GT(0.0, v.get_latitude()->get());
+	EXPECT_EQ(*s->get_longitude(), *v.get_longitude());
+	EXPECT_EQ(nmea::to_string(*s->get_time_utc()), nmea::to_string(*v.get_time_utc()));
+}
+
+TEST_F(Test_nmea_sentence_view, position_gns)
+{
+	const std::string raw
+		= "$GPGNS,122310.2,3722.425671,N,12258.856215,W,AA,14,0.9,1005.543,6.5,,*6A";
+	const auto v = nmea::make_sentence_view(raw);
+	const auto s = v.as<nmea::gns>();
+	EXPECT_EQ(*s->get_latitude(), *v.get_latitude());
+	EXPECT_EQ(*s->get_longitude(), *v.get_longitude());
+	EXPECT_EQ(nmea::to_string(*s->get_time_utc()), nmea::to_string(*v.get_time_utc()));
+}
+
+TEST_F(Test_nmea_sentence_view, position_not_set)
+{
+	const std::string raw = "$GPGGA,123519,,,,,0,00,,,M,,M,,*6B";
+	const auto v = nmea::make_sentence_view(raw);
+	EXPECT_TRUE(v.has_position());
+	EXPECT_FALSE(v.get_latitude().available());
+	EXPECT_FALSE(v.get_longitude().available());
+	EXPECT_TRUE(v.get_time_utc().available());
+}
+
+TEST_F(Test_nmea_sentence_view, position_not_supported)
+{
+	const auto v = nmea::make_sentence_view(hdt);
+	EXPECT_FALSE(v.has_position());
+	EXPECT_THROW(v.get_latitude(), std::invalid_argument);
+	EXPECT_THROW(v.get_longitude(), std::invalid_argument);
+	EXPECT_THROW(v.get_time_utc(), std::invalid_argument);
+	EXPECT_THROW(v.get_date(), std::invalid_argument);
+}
+}
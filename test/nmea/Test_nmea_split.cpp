@@ -101,4 +101,55 @@ TEST_F(Test_nmea_split, empty_string)
 
 	ASSERT_EQ(0u, result.size());
 }
+
+TEST_F(Test_nmea_split, split_fields_terminated)
+{
+	using marnav::nmea::detail::field_view;
+	static const std::string raw = "$A,,BC*xx";
+
+	field_view fields[8];
+	const auto n = marnav::nmea::detail::split_fields(raw.data(), raw.size(), fields, 8);
+
+	ASSERT_EQ(4u, n);
+	EXPECT_STREQ("A", fields[0].str().c_str());
+	EXPECT_TRUE(fields[1].empty());
+	EXPECT_STREQ("BC", fields[2].str().c_str());
+	EXPECT_STREQ("xx", fields[3].str().c_str());
+	EXPECT_EQ(raw.data() + 4, fields[2].data);
+}
+
+TEST_F(Test_nmea_split, split_fields_equal_to_parse_fields)
+{
+	using marnav::nmea::detail::field_view;
+	static const std::string raw
+		= "$GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E";
+
+	field_view fields[32];
+	const auto n = marnav::nmea::detail::split_fields(raw.data(), raw.size(), fields, 32);
+	const auto expected = marnav::nmea::detail::parse_fields(raw);
+
+	ASSERT_EQ(expected.size(), n);
+	for (std::size_t i = 0; i < n; ++i)
+		EXPECT_EQ(expected[i], fields[i].str());
+}
+
+TEST_F(Test_nmea_split, split_fields_capacity_exceeded)
+{
+	using marnav::nmea::detail::field_view;
+	static const std::string raw = "$0,1,2,3,4*xx";
+
+	field_view fields[2];
+	const auto n = marnav::nmea::detail::split_fields(raw.data(), raw.size(), fields, 2);
+
+	EXPECT_EQ(6u, n);
+	EXPECT_STREQ("0", fields[0].str().c_str());
+	EXPECT_STREQ("1", fields[1].str().c_str());
+}
+
+TEST_F(Test_nmea_split, split_fields_empty_string)
+{
+	marnav::nmea::detail::field_view fields[2];
+
+	EXPECT_EQ(0u, marnav::nmea::detail::split_fields("", 0, fields, 2));
+}
 }
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/stream_decoder.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_stream_decoder : public ::testing::Test
+{
+public:
+	struct collector {
+		std::vector<std::string> sentences;
+		std::vector<nmea::parse_error> errors;
+		std::vector<std::string> error_lines;
+
+		nmea::stream_decoder make_decoder(
+			nmea::checksum_handling chksum = nmea::checksum_handling::check,
+			std::size_t max_line_length = nmea::stream_decoder::default_max_line_length)
+		{
+			return nmea::stream_decoder{
+				[this](const nmea::any_sentence & s) {
+					sentences.push_back(nmea::to_string(s));
+				},
+				[this](nmea::parse_error e, const char * s, std::size_t n) {
+					errors.push_back(e);
+					error_lines.emplace_back(s, n);
+				},
+				chksum, max_line_length};
+		}
+	};
+
+	static void feed(nmea::stream_decoder & decoder, const std::string & s)
+	{
+		decoder.feed(s.data(), s.size());
+	}
+};
+
+TEST_F(Test_nmea_stream_decoder, construction_without_handler)
+{
+	EXPECT_ANY_THROW(nmea::stream_decoder(nullptr));
+}
+
+TEST_F(Test_nmea_stream_decoder, construction_invalid_line_length)
+{
+	EXPECT_ANY_THROW(nmea::stream_decoder(
+		[](const nmea::any_sentence &) {}, nullptr, nmea::checksum_handling::check, 0u));
+}
+
+TEST_F(Test_nmea_stream_decoder, complete_lines)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n$IIMTW,10.5,C*17\r\n");
+
+	ASSERT_EQ(2u, c.sentences.size());
+	EXPECT_STREQ("$IIMTW,9.5,C*2F", c.sentences[0].c_str());
+	EXPECT_STREQ("$IIMTW,10.5,C*17", c.sentences[1].c_str());
+	EXPECT_TRUE(c.errors.empty());
+	EXPECT_EQ(0u, decoder.pending());
+}
+
+TEST_F(Test_nmea_stream_decoder, line_terminators)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "$IIMTW,9.5,C*2F\n$IIMTW,9.5,C*2F\r$IIMTW,9.5,C*2F\r\n\r\n\n");
+
+	EXPECT_EQ(3u, c.sentences.size());
+	EXPECT_TRUE(c.errors.empty());
+}
+
+TEST_F(Test_nmea_stream_decoder, byte_by_byte)
+{
+	const std::string data
+		= "$IIMTW,9.5,C*2F\r\n"
+		  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+		  "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17\r\n";
+
+	collector c;
+	auto decoder = c.make_decoder();
+	for (const auto & ch : data)
+		decoder.feed(&ch, 1u);
+
+	ASSERT_EQ(3u, c.sentences.size());
+	EXPECT_STREQ("$IIMTW,9.5,C*2F", c.sentences[0].c_str());
+	EXPECT_STREQ("!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C", c.sentences[1].c_str());
+	EXPECT_TRUE(c.errors.empty());
+}
+
+TEST_F(Test_nmea_stream_decoder, line_spanning_chunks)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n$IIMTW,1");
+	EXPECT_EQ(1u, c.sentences.size());
+	EXPECT_EQ(8u, decoder.pending());
+
+	feed(decoder, "0.5,C*17\r");
+	EXPECT_EQ(2u, c.sentences.size());
+	EXPECT_EQ(0u, decoder.pending());
+
+	feed(decoder, "\n$IIMTW,9.5,C*2F");
+	EXPECT_EQ(2u, c.sentences.size());
+
+	feed(decoder, "\r\n");
+	ASSERT_EQ(3u, c.sentences.size());
+	EXPECT_STREQ("$IIMTW,10.5,C*17", c.sentences[1].c_str());
+	EXPECT_TRUE(c.errors.empty());
+}
+
+TEST_F(Test_nmea_stream_decoder, tag_block)
+{
+	const std::string raw
+		= "\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\$IIMTW,9.5,C*2F";
+
+	collector c;
+	auto decoder = c.make_decoder();
+	feed(decoder, raw.substr(0, 20));
+	feed(decoder, raw.substr(20) + "\r\n");
+
+	ASSERT_EQ(1u, c.sentences.size());
+	EXPECT_STREQ(raw.c_str(), c.sentences[0].c_str());
+}
+
+TEST_F(Test_nmea_stream_decoder, synchronization)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "4A,C*2F\r\n$IIMTW,9.5,C*2F\r\n");
+
+	ASSERT_EQ(1u, c.sentences.size());
+	ASSERT_EQ(1u, c.errors.size());
+	EXPECT_EQ(nmea::parse_error::no_start_token, c.errors[0]);
+	EXPECT_STREQ("4A,C*2F", c.error_lines[0].c_str());
+}
+
+TEST_F(Test_nmea_stream_decoder, invalid_lines)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "$IIMTW,9.5,C*00\r\n$IIXYZ,1,2*00\r\n$IIMTW,9.5,C,1,2*2F\r\n");
+
+	EXPECT_TRUE(c.sentences.empty());
+	ASSERT_EQ(3u, c.errors.size());
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch, c.errors[0]);
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch, c.errors[1]);
+	EXPECT_EQ(nmea::parse_error::checksum_mismatch, c.errors[2]);
+}
+
+TEST_F(Test_nmea_stream_decoder, checksum_ignored)
+{
+	collector c;
+	auto decoder = c.make_decoder(nmea::checksum_handling::ignore);
+
+	feed(decoder, "$IIMTW,9.5,C*00\r\n$IIXYZ,1,2*00\r\n");
+
+	EXPECT_EQ(1u, c.sentences.size());
+	ASSERT_EQ(1u, c.errors.size());
+	EXPECT_EQ(nmea::parse_error::unknown_sentence, c.errors[0]);
+}
+
+TEST_F(Test_nmea_stream_decoder, line_too_long)
+{
+	collector c;
+	auto decoder = c.make_decoder(nmea::checksum_handling::check, 15u);
+
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n$IIMTW,");
+	feed(decoder, "10.5,C*17\r\n$IIMTW,");
+	feed(decoder, "9.5,C*2F\r\n");
+
+	EXPECT_EQ(2u, c.sentences.size());
+	ASSERT_EQ(1u, c.errors.size());
+	EXPECT_EQ(nmea::parse_error::malformed, c.errors[0]);
+	EXPECT_EQ(15u, c.error_lines[0].size());
+}
+
+TEST_F(Test_nmea_stream_decoder, reset)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+
+	feed(decoder, "$IIMTW,1");
+	decoder.reset();
+	EXPECT_EQ(0u, decoder.pending());
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n");
+
+	EXPECT_EQ(1u, c.sentences.size());
+	EXPECT_TRUE(c.errors.empty());
+}
+
+TEST_F(Test_nmea_stream_decoder, typed_dispatch)
+{
+	int mtw = 0;
+	int other = 0;
+	nmea::stream_decoder decoder{[&](const nmea::any_sentence & s) {
+		if (auto p = utils::get_if<nmea::mtw>(&s)) {
+			EXPECT_EQ(9.5, *p->get_temperature());
+			++mtw;
+		} else {
+			++other;
+		}
+	}};
+
+	feed(decoder,
+		"$IIMTW,9.5,C*2F\r\n"
+		"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17\r\n");
+
+	EXPECT_EQ(1, mtw);
+	EXPECT_EQ(1, other);
+}
+
+TEST_F(Test_nmea_stream_decoder, exception_from_handler)
+{
+	int n = 0;
+	nmea::stream_decoder decoder{[&](const nmea::any_sentence &) {
+		if (++n == 1)
+			throw std::runtime_error{"handler"};
+	}};
+
+	EXPECT_THROW(feed(decoder, "$IIMTW,9.5,C*2F\r\n$IIMTW,9.5"), std::runtime_error);
+	EXPECT_EQ(0u, decoder.pending());
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n");
+	EXPECT_EQ(2, n);
+}
+
+TEST_F(Test_nmea_stream_decoder, filter)
+{
+	collector c;
+	auto decoder = c.make_decoder();
+	decoder.set_filter(nmea::sentence_filter::all().reject(nmea::sentence_id::MTW));
+
+	feed(decoder,
+		"$IIMTW,9.5,C*2F\r\n"
+		"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17\r\n"
+		"$IIMTW,9.5,C*00\r\n"
+		"garbage\r\n");
+	EXPECT_EQ(1u, c.sentences.size());
+	EXPECT_TRUE(c.errors.empty());
+
+	decoder.clear_filter();
+	feed(decoder, "$IIMTW,9.5,C*2F\r\n");
+	EXPECT_EQ(2u, c.sentences.size());
+}
+}
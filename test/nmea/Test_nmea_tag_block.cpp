@@ -162,8 +162,9 @@ TEST_F(Test_nmea_tag_block, write_sentence_with_tag_block)
 
 	const std::string s = to_string(b);
 
-	static const std::string raw_sentence = "\\g:1-2-3,c:1234*1C\\$GPBOD,123,T,,,,*06";
+	static const std::string raw_sentence = "\\g:1-2-3,c:1234*1C\\$GPBOD,123,T,,,,*3A";
 
 	EXPECT_STREQ(raw_sentence.c_str(), s.c_str());
+	EXPECT_NO_THROW(nmea::make_sentence(s));
 }
 }
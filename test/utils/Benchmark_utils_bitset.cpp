@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <marnav/utils/bitset.hpp>
+
+namespace
+{
+/// Offsets and sizes of the fields of an AIS position report (message type 1).
+struct field {
+	std::size_t ofs;
+	std::size_t bits;
+};
+
+static const std::vector<field> fields = {
+	{0, 6}, {6, 2}, {8, 30}, {38, 4}, {42, 8}, {50, 10}, {60, 1}, {61, 28}, {89, 27},
+	{116, 12}, {128, 9}, {137, 6}, {143, 2}, {145, 3}, {148, 1}, {149, 19},
+};
+
+template <class Block> static marnav::utils::bitset<Block> make_data()
+{
+	marnav::utils::bitset<Block> bits;
+	for (uint32_t i = 0; i < 21; ++i)
+		bits.append(static_cast<uint8_t>(i * 0x9d + 0x35), 8);
+	return bits;
+}
+}
+
+template <class Block> static void Benchmark_bitset_get(benchmark::State & state)
+{
+	const auto bits = make_data<Block>();
+	while (state.KeepRunning()) {
+		for (auto const & f : fields) {
+			auto value = bits.template get<uint32_t>(f.ofs, f.bits);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+}
+
+BENCHMARK_TEMPLATE(Benchmark_bitset_get, uint8_t);
+BENCHMARK_TEMPLATE(Benchmark_bitset_get, uint16_t);
+BENCHMARK_TEMPLATE(Benchmark_bitset_get, uint32_t);
+
+BENCHMARK_MAIN()
@@ -75,6 +75,22 @@ TEST_F(Test_utils_bitset, uint8__construction_container_move)
 	EXPECT_STREQ("1010101001010101", to_string(b).c_str());
 }
 
+TEST_F(Test_utils_bitset, uint8__construction_container_move_bits)
+{
+	bitset<uint8_t> b(std::vector<uint8_t>{0xaa, 0x40}, 10);
+
+	//            0       8       16      24      32      40      48      56
+	//            +-------+-------+-------+-------+-------+-------+-------+-------
+	EXPECT_STREQ("1010101001", to_string(b).c_str());
+	EXPECT_EQ(10u, b.size());
+	EXPECT_EQ(16u, b.capacity());
+}
+
+TEST_F(Test_utils_bitset, uint8__construction_container_move_bits_exceed)
+{
+	EXPECT_THROW(bitset<uint8_t>(std::vector<uint8_t>{0xaa, 0x55}, 17), std::invalid_argument);
+}
+
 TEST_F(Test_utils_bitset, uint8__construction_bitset_move)
 {
 	bitset<uint8_t> t;
@@ -208,6 +224,34 @@ TEST_F(Test_utils_bitset, uint8__get)
 	EXPECT_EQ(false, b.get(7));
 }
 
+TEST_F(Test_utils_bitset, uint8__get_all_offsets_and_sizes)
+{
+	// compares word wise (up to 57 bits) and block wise reads against single bits
+	bitset<uint8_t> b;
+	for (uint32_t i = 0; i < 25; ++i)
+		b.append(static_cast<uint8_t>(i * 0x9d + 0x35), 8);
+
+	for (bitset<uint8_t>::size_type bits = 1; bits <= 64; ++bits) {
+		for (bitset<uint8_t>::size_type ofs = 0; ofs + bits <= b.size(); ++ofs) {
+			uint64_t expected = 0;
+			for (auto i = ofs; i < ofs + bits; ++i)
+				expected = (expected << 1) | (b.get_bit(i) ? 1u : 0u);
+			ASSERT_EQ(expected, b.get<uint64_t>(ofs, bits))
+				<< "ofs=" << ofs << ", bits=" << bits;
+		}
+	}
+}
+
+TEST_F(Test_utils_bitset, uint8__get_at_end_of_data)
+{
+	bitset<uint8_t> b;
+	b.append(0x2a5, 10);
+
+	EXPECT_EQ(0x2a5u, b.get<uint16_t>(0, 10));
+	EXPECT_EQ(0x5u, b.get<uint8_t>(7, 3));
+	EXPECT_EQ(0x1u, b.get<uint8_t>(9, 1));
+}
+
 TEST_F(Test_utils_bitset, uint8__get_enum)
 {
 	enum foo { abc = 0, bcd = 1, cde = 2 };
@@ -408,6 +452,18 @@ TEST_F(Test_utils_bitset, uint8__append_multiple_bits)
 	}
 }
 
+TEST_F(Test_utils_bitset, uint8__set_does_not_modify_following_bits)
+{
+	bitset<uint8_t> b(24);
+	b.set(0xffffffu, 0, 24);
+
+	b.set(0u, 6, 4); // across block boundary
+	EXPECT_STREQ("111111000011111111111111", to_string(b).c_str());
+
+	b.set(0u, 2, 17); // multiple blocks
+	EXPECT_STREQ("110000000000000000011111", to_string(b).c_str());
+}
+
 TEST_F(Test_utils_bitset, uint8__set_single_bits)
 {
 	{
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <marnav/utils/expected.hpp>
+#include <memory>
+
+namespace
+{
+using namespace marnav;
+
+class Test_utils_expected : public ::testing::Test
+{
+public:
+	enum class error { none, failure };
+};
+
+TEST_F(Test_utils_expected, value)
+{
+	utils::expected<int, error> e{5};
+
+	EXPECT_TRUE(e.has_value());
+	EXPECT_TRUE(static_cast<bool>(e));
+	EXPECT_EQ(5, e.value());
+	EXPECT_EQ(5, *e);
+}
+
+TEST_F(Test_utils_expected, error)
+{
+	utils::expected<int, error> e = utils::make_unexpected(error::failure);
+
+	EXPECT_FALSE(e.has_value());
+	EXPECT_FALSE(static_cast<bool>(e));
+	EXPECT_EQ(error::failure, e.error());
+}
+
+TEST_F(Test_utils_expected, move_only_value)
+{
+	utils::expected<std::unique_ptr<int>, error> e{std::unique_ptr<int>(new int{7})};
+
+	ASSERT_TRUE(e.has_value());
+	std::unique_ptr<int> p = std::move(e).value();
+	ASSERT_TRUE(p != nullptr);
+	EXPECT_EQ(7, *p);
+}
+
+TEST_F(Test_utils_expected, member_access)
+{
+	struct data {
+		int value;
+	};
+
+	utils::expected<data, error> e{data{3}};
+
+	EXPECT_EQ(3, e->value);
+}
+}
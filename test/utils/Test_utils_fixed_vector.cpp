@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <marnav/utils/fixed_vector.hpp>
+#include <marnav/utils/bitset.hpp>
+#include <marnav/utils/bitset_string.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_utils_fixed_vector : public ::testing::Test
+{
+};
+
+TEST_F(Test_utils_fixed_vector, default_construction)
+{
+	utils::fixed_vector<uint8_t, 4> v;
+
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(0u, v.size());
+	EXPECT_EQ(4u, v.capacity());
+	EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST_F(Test_utils_fixed_vector, construction_initializer_list)
+{
+	utils::fixed_vector<uint8_t, 4> v{1, 2, 3};
+
+	ASSERT_EQ(3u, v.size());
+	EXPECT_EQ(1u, v[0]);
+	EXPECT_EQ(2u, v[1]);
+	EXPECT_EQ(3u, v[2]);
+}
+
+TEST_F(Test_utils_fixed_vector, push_back_exceeds_capacity)
+{
+	utils::fixed_vector<uint8_t, 2> v;
+
+	EXPECT_NO_THROW(v.push_back(1));
+	EXPECT_NO_THROW(v.push_back(2));
+	EXPECT_THROW(v.push_back(3), std::length_error);
+	EXPECT_EQ(2u, v.size());
+}
+
+TEST_F(Test_utils_fixed_vector, reserve)
+{
+	utils::fixed_vector<uint8_t, 2> v;
+
+	EXPECT_NO_THROW(v.reserve(2));
+	EXPECT_THROW(v.reserve(3), std::length_error);
+}
+
+TEST_F(Test_utils_fixed_vector, assign)
+{
+	utils::fixed_vector<uint8_t, 4> v{1, 2, 3};
+
+	v.assign({4, 5});
+
+	ASSERT_EQ(2u, v.size());
+	EXPECT_EQ(4u, v[0]);
+	EXPECT_EQ(5u, v[1]);
+	EXPECT_THROW(v.assign({1, 2, 3, 4, 5}), std::length_error);
+}
+
+TEST_F(Test_utils_fixed_vector, clear)
+{
+	utils::fixed_vector<uint8_t, 4> v{1, 2, 3};
+
+	v.clear();
+
+	EXPECT_TRUE(v.empty());
+}
+
+TEST_F(Test_utils_fixed_vector, comparison)
+{
+	utils::fixed_vector<uint8_t, 4> a{1, 2, 3};
+	utils::fixed_vector<uint8_t, 4> b{1, 2, 3};
+	utils::fixed_vector<uint8_t, 4> c{1, 2};
+
+	EXPECT_TRUE(a == b);
+	EXPECT_FALSE(a != b);
+	EXPECT_FALSE(a == c);
+	EXPECT_TRUE(a != c);
+}
+
+TEST_F(Test_utils_fixed_vector, bitset_append_and_get)
+{
+	utils::bitset<uint8_t, utils::fixed_vector<uint8_t, 4>> bits;
+
+	bits.append(0x2a, 6);
+	bits.append(0x3ff, 10);
+	bits.append(0x5, 3);
+
+	EXPECT_EQ(19u, bits.size());
+	EXPECT_STREQ("1010101111111111101", utils::to_string(bits).c_str());
+	EXPECT_EQ(0x2au, bits.get<uint8_t>(0, 6));
+	EXPECT_EQ(0x3ffu, bits.get<uint16_t>(6, 10));
+	EXPECT_EQ(0x5u, bits.get<uint8_t>(16, 3));
+}
+
+TEST_F(Test_utils_fixed_vector, bitset_exceeds_capacity)
+{
+	utils::bitset<uint8_t, utils::fixed_vector<uint8_t, 2>> bits;
+
+	EXPECT_NO_THROW(bits.append(0xffff, 16));
+	EXPECT_THROW(bits.append(1, 1), std::length_error);
+}
+
+TEST_F(Test_utils_fixed_vector, bitset_comparison_with_dynamic_bitset)
+{
+	utils::bitset<uint8_t, utils::fixed_vector<uint8_t, 4>> a;
+	utils::bitset<uint8_t> b;
+
+	a.append(0x2a5, 10);
+	b.append(0x2a5, 10);
+
+	EXPECT_TRUE(a == b);
+	EXPECT_FALSE(a != b);
+}
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <marnav/utils/variant.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+using namespace marnav;
+
+class Test_utils_variant : public ::testing::Test
+{
+public:
+	using value_type = utils::variant<int, std::string, std::vector<int>>;
+
+	struct counter {
+		static int alive;
+		counter() { ++alive; }
+		counter(const counter &) { ++alive; }
+		counter(counter &&) noexcept { ++alive; }
+		~counter() { --alive; }
+	};
+
+	struct throwing {
+		throwing() = default;
+		explicit throwing(int) { throw std::runtime_error{"throwing"}; }
+	};
+
+	struct describe {
+		std::string operator()(int t) const { return "int:" + std::to_string(t); }
+		std::string operator()(const std::string & t) const { return "string:" + t; }
+		std::string operator()(const std::vector<int> & t) const
+		{
+			return "vector:" + std::to_string(t.size());
+		}
+	};
+
+	struct increment {
+		void operator()(int & t) const { ++t; }
+		void operator()(std::string & t) const { t += "+"; }
+		void operator()(std::vector<int> & t) const { t.push_back(0); }
+	};
+};
+
+int Test_utils_variant::counter::alive = 0;
+
+TEST_F(Test_utils_variant, default_construction)
+{
+	value_type v;
+	EXPECT_EQ(0u, v.index());
+	EXPECT_TRUE(utils::holds_alternative<int>(v));
+	EXPECT_EQ(0, utils::get<int>(v));
+}
+
+TEST_F(Test_utils_variant, construction_from_value)
+{
+	value_type v = std::string{"hello"};
+	EXPECT_EQ(1u, v.index());
+	EXPECT_TRUE(utils::holds_alternative<std::string>(v));
+	EXPECT_STREQ("hello", utils::get<std::string>(v).c_str());
+}
+
+TEST_F(Test_utils_variant, index_of)
+{
+	EXPECT_EQ(0u, value_type::index_of<int>::value);
+	EXPECT_EQ(2u, value_type::index_of<std::vector<int>>::value);
+	EXPECT_EQ(value_type::size, value_type::index_of<double>::value);
+}
+
+TEST_F(Test_utils_variant, get_wrong_type)
+{
+	value_type v = 5;
+	EXPECT_THROW(utils::get<std::string>(v), std::bad_cast);
+	EXPECT_EQ(nullptr, utils::get_if<std::string>(&v));
+	ASSERT_NE(nullptr, utils::get_if<int>(&v));
+	EXPECT_EQ(5, *utils::get_if<int>(&v));
+}
+
+TEST_F(Test_utils_variant, copy_and_move)
+{
+	value_type v0 = std::vector<int>{1, 2, 3};
+	value_type v1 = v0;
+	EXPECT_EQ(3u, utils::get<std::vector<int>>(v1).size());
+	EXPECT_EQ(3u, utils::get<std::vector<int>>(v0).size());
+
+	value_type v2 = std::move(v1);
+	EXPECT_EQ(3u, utils::get<std::vector<int>>(v2).size());
+
+	value_type v3;
+	v3 = v2;
+	EXPECT_EQ(2u, v3.index());
+	v3 = std::string{"abc"};
+	EXPECT_EQ(1u, v3.index());
+	v3 = 7;
+	EXPECT_EQ(7, utils::get<int>(v3));
+}
+
+TEST_F(Test_utils_variant, emplace)
+{
+	value_type v;
+	auto & s = v.emplace<std::string>(3u, 'x');
+	EXPECT_STREQ("xxx", s.c_str());
+	EXPECT_TRUE(utils::holds_alternative<std::string>(v));
+}
+
+TEST_F(Test_utils_variant, emplace_throws)
+{
+	utils::variant<int, throwing> v = throwing{};
+	EXPECT_THROW(v.emplace<throwing>(1), std::runtime_error);
+	EXPECT_TRUE(utils::holds_alternative<throwing>(v));
+
+	v = 5;
+	EXPECT_THROW(v.emplace<throwing>(1), std::runtime_error);
+	ASSERT_TRUE(utils::holds_alternative<int>(v));
+	EXPECT_EQ(5, utils::get<int>(v));
+}
+
+TEST_F(Test_utils_variant, assign_contained_value)
+{
+	value_type v = std::string(100u, 'x');
+	v = utils::get<std::string>(v);
+	EXPECT_EQ(std::string(100u, 'x'), utils::get<std::string>(v));
+}
+
+TEST_F(Test_utils_variant, emplace_from_contained_value)
+{
+	value_type v = std::string(100u, 'x');
+	v.emplace<std::string>(utils::get<std::string>(v), 10u);
+	EXPECT_EQ(std::string(90u, 'x'), utils::get<std::string>(v));
+
+	value_type w = std::vector<int>{1, 2, 3};
+	const auto & vec = utils::get<std::vector<int>>(w);
+	w.emplace<int>(static_cast<int>(vec.size()) + vec[2]);
+	EXPECT_EQ(6, utils::get<int>(w));
+}
+
+TEST_F(Test_utils_variant, visit)
+{
+	const value_type v0 = 5;
+	const value_type v1 = std::string{"abc"};
+	const value_type v2 = std::vector<int>{1, 2};
+
+	EXPECT_STREQ("int:5", utils::visit(describe{}, v0).c_str());
+	EXPECT_STREQ("string:abc", utils::visit(describe{}, v1).c_str());
+	EXPECT_STREQ("vector:2", utils::visit(describe{}, v2).c_str());
+}
+
+TEST_F(Test_utils_variant, visit_modifying)
+{
+	value_type v = std::string{"abc"};
+	utils::visit(increment{}, v);
+	EXPECT_STREQ("abc+", utils::get<std::string>(v).c_str());
+}
+
+TEST_F(Test_utils_variant, destruction)
+{
+	{
+		utils::variant<int, counter> v = counter{};
+		EXPECT_EQ(1, counter::alive);
+		utils::variant<int, counter> w = v;
+		EXPECT_EQ(2, counter::alive);
+		w = 5;
+		EXPECT_EQ(1, counter::alive);
+		std::vector<utils::variant<int, counter>> c(10, v);
+		EXPECT_EQ(11, counter::alive);
+	}
+	EXPECT_EQ(0, counter::alive);
+}
+}